@@ -62,6 +62,8 @@ const vector<string> ReadAccountsFromConstantsFile(string propName) {
 
 // General constants
 const unsigned int MSG_VERSION{ReadConstantNumeric("MSG_VERSION")};
+const unsigned int STATE_DELTA_VERSION{
+    ReadConstantNumeric("STATE_DELTA_VERSION")};
 const unsigned int DEBUG_LEVEL{ReadConstantNumeric("DEBUG_LEVEL")};
 const bool ENABLE_DO_REJOIN{ReadConstantString("ENABLE_DO_REJOIN") == "true"};
 const bool LOOKUP_NODE_MODE{ReadConstantString("LOOKUP_NODE_MODE") == "true"};
@@ -94,6 +96,9 @@ const unsigned int NUM_CONSENSUS_SUBSETS{
 const bool BROADCAST_TREEBASED_CLUSTER_MODE{
     ReadConstantString("BROADCAST_TREEBASED_CLUSTER_MODE",
                        "node.data_sharing.") == "true"};
+const bool ERASURE_CODED_DISSEMINATION{
+    ReadConstantString("ERASURE_CODED_DISSEMINATION", "node.data_sharing.") ==
+    "true"};
 const unsigned int MULTICAST_CLUSTER_SIZE{
     ReadConstantNumeric("MULTICAST_CLUSTER_SIZE", "node.data_sharing.")};
 const unsigned int NUM_FORWARDED_BLOCK_RECEIVERS_PER_SHARD{ReadConstantNumeric(
@@ -183,6 +188,8 @@ const unsigned int MEAN_GAS_PRICE_DS_NUM{
     ReadConstantNumeric("MEAN_GAS_PRICE_DS_NUM", "node.gas.")};
 const string LEGAL_GAS_PRICE_IP{
     ReadConstantString("LEGAL_GAS_PRICE_IP", "node.gas.")};
+const unsigned int MAX_CONCURRENT_GAS_ESTIMATES{
+    ReadConstantNumeric("MAX_CONCURRENT_GAS_ESTIMATES", "node.gas.")};
 
 // Gossip constants
 const bool BROADCAST_GOSSIP_MODE{
@@ -190,6 +197,8 @@ const bool BROADCAST_GOSSIP_MODE{
 const bool SEND_RESPONSE_FOR_LAZY_PUSH{
     ReadConstantString("SEND_RESPONSE_FOR_LAZY_PUSH", "node.gossip.") ==
     "true"};
+const bool GOSSIP_DIGEST_MODE{
+    ReadConstantString("GOSSIP_DIGEST_MODE", "node.gossip.") == "true"};
 const bool GOSSIP_CUSTOM_ROUNDS_SETTINGS{
     ReadConstantString("GOSSIP_CUSTOM_ROUNDS_SETTINGS", "node.gossip.") ==
     "true"};
@@ -201,6 +210,14 @@ const unsigned int MAX_TOTAL_ROUNDS{ReadConstantNumeric(
     "MAX_TOTAL_ROUNDS", "node.gossip.gossip_custom_rounds.")};
 const unsigned int MAX_NEIGHBORS_PER_ROUND{
     ReadConstantNumeric("MAX_NEIGHBORS_PER_ROUND", "node.gossip.")};
+const bool GOSSIP_ADAPTIVE_MODE{
+    ReadConstantString("GOSSIP_ADAPTIVE_MODE", "node.gossip.") == "true"};
+const unsigned int GOSSIP_TARGET_CONVERGENCE_IN_MS{ReadConstantNumeric(
+    "TARGET_CONVERGENCE_IN_MS", "node.gossip.gossip_adaptive.")};
+const unsigned int GOSSIP_MIN_ROUND_TIME_IN_MS{ReadConstantNumeric(
+    "MIN_ROUND_TIME_IN_MS", "node.gossip.gossip_adaptive.")};
+const unsigned int GOSSIP_ADAPTIVE_MAX_NEIGHBORS{ReadConstantNumeric(
+    "MAX_NEIGHBORS_PER_ROUND", "node.gossip.gossip_adaptive.")};
 const unsigned int NUM_GOSSIP_RECEIVERS{
     ReadConstantNumeric("NUM_GOSSIP_RECEIVERS", "node.gossip.")};
 const unsigned int ROUND_TIME_IN_MS{
@@ -259,6 +276,8 @@ const unsigned int BROADCAST_INTERVAL{
     ReadConstantNumeric("BROADCAST_INTERVAL", "node.p2pcomm.")};
 const unsigned int BROADCAST_EXPIRY{
     ReadConstantNumeric("BROADCAST_EXPIRY", "node.p2pcomm.")};
+const unsigned int BROADCAST_DEDUP_CAPACITY{
+    ReadConstantNumeric("BROADCAST_DEDUP_CAPACITY", "node.p2pcomm.")};
 const unsigned int FETCH_LOOKUP_MSG_MAX_RETRY{
     ReadConstantNumeric("FETCH_LOOKUP_MSG_MAX_RETRY", "node.p2pcomm.")};
 const uint32_t MAXMESSAGE{ReadConstantNumeric("MAXMESSAGE", "node.p2pcomm.")};
@@ -266,12 +285,34 @@ const unsigned int MAXRETRYCONN{
     ReadConstantNumeric("MAXRETRYCONN", "node.p2pcomm.")};
 const unsigned int MSGQUEUE_SIZE{
     ReadConstantNumeric("MSGQUEUE_SIZE", "node.p2pcomm.")};
+const unsigned int MSGQUEUE_STATS_INTERVAL_IN_SECONDS{
+    ReadConstantNumeric("MSGQUEUE_STATS_INTERVAL_IN_SECONDS", "node.p2pcomm.")};
 const unsigned int PUMPMESSAGE_MILLISECONDS{
     ReadConstantNumeric("PUMPMESSAGE_MILLISECONDS", "node.p2pcomm.")};
 const unsigned int SENDQUEUE_SIZE{
     ReadConstantNumeric("SENDQUEUE_SIZE", "node.p2pcomm.")};
 const unsigned int MAX_GOSSIP_MSG_SIZE_IN_BYTES{
     ReadConstantNumeric("MAX_GOSSIP_MSG_SIZE_IN_BYTES", "node.p2pcomm.")};
+const unsigned int MAX_MSG_SIZE_IN_BYTES{
+    ReadConstantNumeric("MAX_MSG_SIZE_IN_BYTES", "node.p2pcomm.")};
+const unsigned int P2P_REACTOR_COUNT{
+    ReadConstantNumeric("P2P_REACTOR_COUNT", "node.p2pcomm.")};
+const unsigned int PEER_SENDQUEUE_SIZE{
+    ReadConstantNumeric("PEER_SENDQUEUE_SIZE", "node.p2pcomm.")};
+const unsigned int SEND_TIMEOUT_IN_SECONDS{
+    ReadConstantNumeric("SEND_TIMEOUT_IN_SECONDS", "node.p2pcomm.")};
+const unsigned int SEND_BACKOFF_BASE_IN_MILLISECONDS{
+    ReadConstantNumeric("SEND_BACKOFF_BASE_IN_MILLISECONDS", "node.p2pcomm.")};
+const unsigned int SEND_BACKOFF_MAX_IN_MILLISECONDS{
+    ReadConstantNumeric("SEND_BACKOFF_MAX_IN_MILLISECONDS", "node.p2pcomm.")};
+const string COMPRESSED_MESSAGE_TYPES{
+    ReadConstantString("COMPRESSED_MESSAGE_TYPES", "node.p2pcomm.")};
+const unsigned int COMPRESSION_MIN_SIZE_IN_BYTES{
+    ReadConstantNumeric("COMPRESSION_MIN_SIZE_IN_BYTES", "node.p2pcomm.")};
+const unsigned int CHUNKED_TRANSFER_THRESHOLD_IN_BYTES{ReadConstantNumeric(
+    "CHUNKED_TRANSFER_THRESHOLD_IN_BYTES", "node.p2pcomm.")};
+const unsigned int CHUNK_SIZE_IN_BYTES{
+    ReadConstantNumeric("CHUNK_SIZE_IN_BYTES", "node.p2pcomm.")};
 
 // PoW constants
 const bool CUDA_GPU_MINE{ReadConstantString("CUDA_GPU_MINE", "node.pow.") ==
@@ -366,6 +407,8 @@ const string OUTPUT_JSON{
 const string INPUT_CODE{
     SCILLA_FILES + '/' +
     ReadConstantString("INPUT_CODE", "node.smart_contract.")};
+const unsigned int MAX_EVENT_LOG_BLOCK_RANGE{
+    ReadConstantNumeric("MAX_EVENT_LOG_BLOCK_RANGE", "node.smart_contract.")};
 
 // Test constants
 const bool ENABLE_CHECK_PERFORMANCE_LOG{
@@ -111,6 +111,7 @@ const float ONE_HUNDRED_PERCENT = 100.f;
 // General constants
 extern const unsigned int DEBUG_LEVEL;
 extern const unsigned int MSG_VERSION;
+extern const unsigned int STATE_DELTA_VERSION;
 extern const bool ENABLE_DO_REJOIN;
 extern const bool LOOKUP_NODE_MODE;
 extern const unsigned int MAX_ENTRIES_FOR_DIAGNOSTIC_DATA;
@@ -132,6 +133,7 @@ extern const unsigned int NUM_CONSENSUS_SUBSETS;
 
 // Data sharing constants
 extern const bool BROADCAST_TREEBASED_CLUSTER_MODE;
+extern const bool ERASURE_CODED_DISSEMINATION;
 extern const unsigned int MULTICAST_CLUSTER_SIZE;
 extern const unsigned int NUM_FORWARDED_BLOCK_RECEIVERS_PER_SHARD;
 extern const unsigned int NUM_NODES_TO_SEND_LOOKUP;
@@ -181,15 +183,21 @@ extern const unsigned int GAS_PRICE_RAISE_RATIO_UPPER;
 extern const unsigned int GAS_PRICE_TOLERANCE;
 extern const unsigned int MEAN_GAS_PRICE_DS_NUM;
 extern const std::string LEGAL_GAS_PRICE_IP;
+extern const unsigned int MAX_CONCURRENT_GAS_ESTIMATES;
 
 // Gossip constants
 extern const bool BROADCAST_GOSSIP_MODE;
 extern const bool SEND_RESPONSE_FOR_LAZY_PUSH;
+extern const bool GOSSIP_DIGEST_MODE;
 extern const bool GOSSIP_CUSTOM_ROUNDS_SETTINGS;
 extern const unsigned int MAX_ROUNDS_IN_BSTATE;
 extern const unsigned int MAX_ROUNDS_IN_CSTATE;
 extern const unsigned int MAX_TOTAL_ROUNDS;
 extern const unsigned int MAX_NEIGHBORS_PER_ROUND;
+extern const bool GOSSIP_ADAPTIVE_MODE;
+extern const unsigned int GOSSIP_TARGET_CONVERGENCE_IN_MS;
+extern const unsigned int GOSSIP_MIN_ROUND_TIME_IN_MS;
+extern const unsigned int GOSSIP_ADAPTIVE_MAX_NEIGHBORS;
 extern const unsigned int NUM_GOSSIP_RECEIVERS;
 extern const unsigned int ROUND_TIME_IN_MS;
 extern const unsigned int SIMULATED_NETWORK_DELAY_IN_MS;
@@ -224,13 +232,25 @@ extern const unsigned int SHARD_SIZE_TOLERANCE_HI;
 // P2PComm constants
 extern const unsigned int BROADCAST_INTERVAL;
 extern const unsigned int BROADCAST_EXPIRY;
+extern const unsigned int BROADCAST_DEDUP_CAPACITY;
 extern const unsigned int FETCH_LOOKUP_MSG_MAX_RETRY;
 extern const uint32_t MAXMESSAGE;
 extern const unsigned int MAXRETRYCONN;
 extern const unsigned int MSGQUEUE_SIZE;
+extern const unsigned int MSGQUEUE_STATS_INTERVAL_IN_SECONDS;
 extern const unsigned int PUMPMESSAGE_MILLISECONDS;
 extern const unsigned int SENDQUEUE_SIZE;
 extern const unsigned int MAX_GOSSIP_MSG_SIZE_IN_BYTES;
+extern const unsigned int MAX_MSG_SIZE_IN_BYTES;
+extern const unsigned int P2P_REACTOR_COUNT;
+extern const unsigned int PEER_SENDQUEUE_SIZE;
+extern const unsigned int SEND_TIMEOUT_IN_SECONDS;
+extern const unsigned int SEND_BACKOFF_BASE_IN_MILLISECONDS;
+extern const unsigned int SEND_BACKOFF_MAX_IN_MILLISECONDS;
+extern const std::string COMPRESSED_MESSAGE_TYPES;
+extern const unsigned int COMPRESSION_MIN_SIZE_IN_BYTES;
+extern const unsigned int CHUNKED_TRANSFER_THRESHOLD_IN_BYTES;
+extern const unsigned int CHUNK_SIZE_IN_BYTES;
 
 // PoW constants
 extern const bool CUDA_GPU_MINE;
@@ -276,6 +296,7 @@ extern const std::string INPUT_BLOCKCHAIN_JSON;
 extern const std::string INPUT_MESSAGE_JSON;
 extern const std::string OUTPUT_JSON;
 extern const std::string INPUT_CODE;
+extern const unsigned int MAX_EVENT_LOG_BLOCK_RANGE;
 
 // Test constants
 extern const bool ENABLE_CHECK_PERFORMANCE_LOG;
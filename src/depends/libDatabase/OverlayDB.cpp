@@ -34,17 +34,23 @@ namespace dev
 
 	void OverlayDB::ResetDB()
 	{
-		m_levelDB.ResetDB();
+		if (!m_levelDB)
+			return;
+
+		m_levelDB->ResetDB();
 	}
 
 	void OverlayDB::commit()
 	{
+		if (!m_levelDB)
+			return;
+
 	// #if DEV_GUARDED_DB
 	// 		DEV_READ_GUARDED(x_this)
 	// #endif
 		{
 			shared_lock<shared_timed_mutex> lock(x_this);
-			m_levelDB.BatchInsert(m_main, m_aux);
+			m_levelDB->BatchInsert(m_main, m_aux);
 		}
 			
 	// #if DEV_GUARDED_DB
@@ -63,10 +69,13 @@ namespace dev
 		if (!ret.empty())
 			return ret;
 
+		if (m_base)
+			return m_base->lookupAux(_h);
+
 		bytes b = _h.asBytes();
 		b.push_back(255);	// for aux
 
-		return asBytes(m_levelDB.Lookup(bytesConstRef(&b)));
+		return asBytes(m_levelDB->Lookup(bytesConstRef(&b)));
 	}
 
 	void OverlayDB::rollback()
@@ -83,7 +92,7 @@ namespace dev
 		std::string ret = MemoryDB::lookup(_h);
 	
 		if (ret.empty())
-			ret = m_levelDB.Lookup(_h);
+			ret = m_base ? m_base->lookup(_h) : m_levelDB->Lookup(_h);
 	
 		return ret;
 	}
@@ -93,7 +102,7 @@ namespace dev
 		if (MemoryDB::exists(_h))
 			return true;
 
-		return m_levelDB.Exists(_h);
+		return m_base ? m_base->exists(_h) : m_levelDB->Exists(_h);
 	}
 
 	void OverlayDB::kill(h256 const& _h)
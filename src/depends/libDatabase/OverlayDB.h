@@ -33,7 +33,13 @@ namespace dev
 	class OverlayDB: public MemoryDB
 	{
 	public:
-		explicit OverlayDB(const std::string & dbName): m_levelDB(dbName) {}
+		explicit OverlayDB(const std::string & dbName): m_levelDB(new LevelDB(dbName)) {}
+
+		/// Private overlay on top of base: reads fall through to base, writes
+		/// stay in memory here and are dropped with this object. base must
+		/// outlive it. commit() and ResetDB() do nothing on such an overlay.
+		explicit OverlayDB(const OverlayDB* base): m_base(base) {}
+
 		~OverlayDB() = default;
 
 		void ResetDB();
@@ -50,7 +56,8 @@ namespace dev
 	private:
 		using MemoryDB::clear;
 
-		LevelDB m_levelDB;
+		std::unique_ptr<LevelDB> m_levelDB;
+		const OverlayDB* m_base = nullptr;
 	};
 }
 
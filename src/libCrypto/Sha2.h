@@ -34,11 +34,10 @@ template <unsigned int SIZE>
 class SHA2 {
   static const unsigned int HASH_OUTPUT_SIZE = SIZE / 8;
   SHA256_CTX m_context;
-  bytes output;
 
  public:
   /// Constructor.
-  SHA2() : output(HASH_OUTPUT_SIZE) {
+  SHA2() {
     if (SIZE != HASH_TYPE::HASH_VARIANT_256) {
       LOG_GENERAL(FATAL, "assertion failed (" << __FILE__ << ":" << __LINE__
                                               << ": " << __FUNCTION__ << ")");
@@ -57,7 +56,12 @@ class SHA2 {
       return;
     }
 
-    SHA256_Update(&m_context, input.data(), input.size());
+    Update(input.data(), input.size());
+  }
+
+  /// Hash update function, without copying the input into a bytes.
+  void Update(const unsigned char* input, size_t size) {
+    SHA256_Update(&m_context, input, size);
   }
 
   /// Hash update function.
@@ -75,14 +79,20 @@ class SHA2 {
 
   /// Hash finalize function.
   bytes Finalize() {
+    bytes output(HASH_OUTPUT_SIZE);
+    Finalize(output.data());
+    return output;
+  }
+
+  /// Hash finalize function. Writes HASH_OUTPUT_SIZE bytes to digest.
+  void Finalize(unsigned char* digest) {
     switch (SIZE) {
       case 256:
-        SHA256_Final(output.data(), &m_context);
+        SHA256_Final(digest, &m_context);
         break;
       default:
         break;
     }
-    return output;
   }
 };
 
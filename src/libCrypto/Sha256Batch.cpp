@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Sha256Batch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+#if defined(__x86_64__)
+
+const unsigned int LANES = 8;
+const size_t BLOCK_SIZE = 64;
+
+const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+const uint32_t INITIAL_STATE[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372,
+                                   0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                   0x1f83d9ab, 0x5be0cd19};
+
+// Blocks of a message once padded with the 0x80 byte and its bit length
+size_t BlockCount(size_t size) {
+  return (size + 9 + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+
+bool HasAVX2() {
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  return avx2;
+}
+
+// The blocks one lane works through: whole blocks are read from the message,
+// the padded tail from a copy
+struct Lane {
+  const unsigned char* data;
+  size_t wholeBlocks;
+  unsigned char tail[2 * BLOCK_SIZE];
+
+  void Init(const bytes& message) {
+    data = message.data();
+    wholeBlocks = message.size() / BLOCK_SIZE;
+
+    const size_t rest = message.size() - wholeBlocks * BLOCK_SIZE;
+    const size_t tailSize =
+        rest + 9 <= BLOCK_SIZE ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+    memset(tail, 0, sizeof(tail));
+    if (rest > 0) {
+      memcpy(tail, data + wholeBlocks * BLOCK_SIZE, rest);
+    }
+    tail[rest] = 0x80;
+    const uint64_t bits = static_cast<uint64_t>(message.size()) * 8;
+    for (unsigned int i = 0; i < 8; i++) {
+      tail[tailSize - 1 - i] = static_cast<unsigned char>(bits >> (8 * i));
+    }
+  }
+
+  const unsigned char* Block(size_t i) const {
+    return i < wholeBlocks ? data + i * BLOCK_SIZE
+                           : tail + (i - wholeBlocks) * BLOCK_SIZE;
+  }
+};
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+TARGET_AVX2 inline __m256i Add(__m256i a, __m256i b) {
+  return _mm256_add_epi32(a, b);
+}
+
+TARGET_AVX2 inline __m256i Xor(__m256i a, __m256i b) {
+  return _mm256_xor_si256(a, b);
+}
+
+TARGET_AVX2 inline __m256i Rotr(__m256i x, int n) {
+  return _mm256_or_si256(_mm256_srli_epi32(x, n),
+                         _mm256_slli_epi32(x, 32 - n));
+}
+
+TARGET_AVX2 inline __m256i BigSigma0(__m256i a) {
+  return Xor(Xor(Rotr(a, 2), Rotr(a, 13)), Rotr(a, 22));
+}
+
+TARGET_AVX2 inline __m256i BigSigma1(__m256i e) {
+  return Xor(Xor(Rotr(e, 6), Rotr(e, 11)), Rotr(e, 25));
+}
+
+TARGET_AVX2 inline __m256i SmallSigma0(__m256i w) {
+  return Xor(Xor(Rotr(w, 7), Rotr(w, 18)), _mm256_srli_epi32(w, 3));
+}
+
+TARGET_AVX2 inline __m256i SmallSigma1(__m256i w) {
+  return Xor(Xor(Rotr(w, 17), Rotr(w, 19)), _mm256_srli_epi32(w, 10));
+}
+
+TARGET_AVX2 inline __m256i Choose(__m256i e, __m256i f, __m256i g) {
+  return Xor(g, _mm256_and_si256(e, Xor(f, g)));
+}
+
+TARGET_AVX2 inline __m256i Majority(__m256i a, __m256i b, __m256i c) {
+  return _mm256_or_si256(_mm256_and_si256(a, b),
+                         _mm256_and_si256(c, _mm256_or_si256(a, b)));
+}
+
+/// Word 't' of the block of each lane, converted from big endian
+TARGET_AVX2 inline __m256i LoadWord(
+    const unsigned char* const blocks[LANES], unsigned int t) {
+  uint32_t w[LANES];
+  for (unsigned int lane = 0; lane < LANES; lane++) {
+    memcpy(&w[lane], blocks[lane] + 4 * t, 4);
+  }
+  const __m256i swap = _mm256_setr_epi8(
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6,
+      5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  return _mm256_shuffle_epi8(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w)), swap);
+}
+
+/// One SHA-256 compression in each lane
+TARGET_AVX2 void Compress(__m256i state[8],
+                          const unsigned char* const blocks[LANES]) {
+  __m256i w[16];
+  for (unsigned int t = 0; t < 16; t++) {
+    w[t] = LoadWord(blocks, t);
+  }
+
+  __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+  __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+
+  for (unsigned int t = 0; t < 64; t++) {
+    if (t >= 16) {
+      w[t & 15] = Add(Add(SmallSigma1(w[(t - 2) & 15]), w[(t - 7) & 15]),
+                      Add(SmallSigma0(w[(t - 15) & 15]), w[t & 15]));
+    }
+
+    const __m256i t1 =
+        Add(Add(Add(h, BigSigma1(e)), Add(Choose(e, f, g), w[t & 15])),
+            _mm256_set1_epi32(static_cast<int>(K[t])));
+    const __m256i t2 = Add(BigSigma0(a), Majority(a, b, c));
+    h = g;
+    g = f;
+    f = e;
+    e = Add(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = Add(t1, t2);
+  }
+
+  state[0] = Add(state[0], a);
+  state[1] = Add(state[1], b);
+  state[2] = Add(state[2], c);
+  state[3] = Add(state[3], d);
+  state[4] = Add(state[4], e);
+  state[5] = Add(state[5], f);
+  state[6] = Add(state[6], g);
+  state[7] = Add(state[7], h);
+}
+
+/// Hashes up to LANES messages with 'blockCount' blocks each. Unused lanes
+/// repeat the first message and their results are dropped.
+TARGET_AVX2 void HashLanes(const vector<bytes>& messages,
+                           const size_t* indices, unsigned int count,
+                           size_t blockCount,
+                           vector<SHA256Batch::Digest>& digests) {
+  Lane lanes[LANES];
+  for (unsigned int lane = 0; lane < LANES; lane++) {
+    lanes[lane].Init(messages[indices[lane < count ? lane : 0]]);
+  }
+
+  __m256i state[8];
+  for (unsigned int i = 0; i < 8; i++) {
+    state[i] = _mm256_set1_epi32(static_cast<int>(INITIAL_STATE[i]));
+  }
+
+  const unsigned char* blocks[LANES];
+  for (size_t block = 0; block < blockCount; block++) {
+    for (unsigned int lane = 0; lane < LANES; lane++) {
+      blocks[lane] = lanes[lane].Block(block);
+    }
+    Compress(state, blocks);
+  }
+
+  uint32_t words[8][LANES];
+  for (unsigned int i = 0; i < 8; i++) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(words[i]), state[i]);
+  }
+  for (unsigned int lane = 0; lane < count; lane++) {
+    SHA256Batch::Digest& digest = digests[indices[lane]];
+    for (unsigned int i = 0; i < 8; i++) {
+      const uint32_t word = words[i][lane];
+      digest[4 * i] = static_cast<unsigned char>(word >> 24);
+      digest[4 * i + 1] = static_cast<unsigned char>(word >> 16);
+      digest[4 * i + 2] = static_cast<unsigned char>(word >> 8);
+      digest[4 * i + 3] = static_cast<unsigned char>(word);
+    }
+  }
+}
+
+#endif  // __x86_64__
+
+}  // namespace
+
+void SHA256Batch::Hash(const vector<bytes>& messages, vector<Digest>& digests) {
+#if defined(__x86_64__)
+  if (messages.size() > 1 && HashVectorized(messages, digests)) {
+    return;
+  }
+#endif
+
+  HashSerial(messages, digests);
+}
+
+bool SHA256Batch::HashVectorized(const vector<bytes>& messages,
+                                 vector<Digest>& digests) {
+#if defined(__x86_64__)
+  if (!HasAVX2()) {
+    return false;
+  }
+
+  digests.resize(messages.size());
+
+  // Lanes of a batch must run the same number of blocks
+  vector<size_t> order(messages.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+    return BlockCount(messages[x].size()) < BlockCount(messages[y].size());
+  });
+
+  for (size_t begin = 0; begin < order.size();) {
+    const size_t blockCount = BlockCount(messages[order[begin]].size());
+    size_t end = begin + 1;
+    while (end < order.size() && end - begin < LANES &&
+           BlockCount(messages[order[end]].size()) == blockCount) {
+      end++;
+    }
+
+    if (end - begin == 1) {
+      const bytes& message = messages[order[begin]];
+      SHA256(message.data(), message.size(), digests[order[begin]].data());
+    } else {
+      HashLanes(messages, &order[begin], end - begin, blockCount, digests);
+    }
+    begin = end;
+  }
+
+  return true;
+#else
+  (void)messages;
+  (void)digests;
+  return false;
+#endif
+}
+
+void SHA256Batch::HashSerial(const vector<bytes>& messages,
+                             vector<Digest>& digests) {
+  digests.resize(messages.size());
+  for (size_t i = 0; i < messages.size(); i++) {
+    SHA256(messages[i].data(), messages[i].size(), digests[i].data());
+  }
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SHA256BATCH_H__
+#define __SHA256BATCH_H__
+
+#include <openssl/sha.h>
+#include <array>
+#include <vector>
+#include "common/BaseType.h"
+
+/// Computes the SHA-256 digests of many independent messages at once.
+///
+/// Where the CPU has AVX2, messages with the same number of SHA-256 blocks
+/// are hashed eight at a time, one per 32-bit vector lane. For messages of
+/// transaction size this beats one OpenSSL call per message even when
+/// OpenSSL uses the SHA extensions, as the per-call overhead dominates.
+/// Elsewhere the messages go one by one through OpenSSL.
+class SHA256Batch {
+ public:
+  using Digest = std::array<unsigned char, SHA256_DIGEST_LENGTH>;
+
+  /// digests[i] becomes the hash of messages[i]
+  static void Hash(const std::vector<bytes>& messages,
+                   std::vector<Digest>& digests);
+
+  /// Same, always on the AVX2 lanes. Returns false if the CPU has no AVX2.
+  static bool HashVectorized(const std::vector<bytes>& messages,
+                             std::vector<Digest>& digests);
+
+  /// One message at a time through OpenSSL
+  static void HashSerial(const std::vector<bytes>& messages,
+                         std::vector<Digest>& digests);
+};
+
+#endif  // __SHA256BATCH_H__
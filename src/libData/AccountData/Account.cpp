@@ -51,7 +51,9 @@ bool Account::isContract() const { return m_codeHash != dev::h256(); }
 void Account::InitStorage() {
   // LOG_MARKER();
   m_storage = AccountTrieDB<dev::h256, OverlayDB>(
-      &(ContractStorage::GetContractStorage().GetStateDB()));
+      m_storageDB != nullptr
+          ? m_storageDB
+          : &(ContractStorage::GetContractStorage().GetStateDB()));
   m_storage.init();
   if (m_storageRoot != h256()) {
     m_storage.setRoot(m_storageRoot);
@@ -59,6 +61,15 @@ void Account::InitStorage() {
   }
 }
 
+void Account::SetStorageDB(OverlayDB* db) {
+  m_storageDB = db;
+  if (isContract()) {
+    const h256 prevRoot = m_prevRoot;
+    InitStorage();
+    m_prevRoot = prevRoot;
+  }
+}
+
 void Account::InitContract(const bytes& data) {
   SetInitData(data);
   InitContract();
@@ -66,15 +77,16 @@ void Account::InitContract(const bytes& data) {
 
 void Account::InitContract() {
   // LOG_MARKER();
-  if (m_initData.empty()) {
+  const bytes& initData = GetInitData();
+  if (initData.empty()) {
     LOG_GENERAL(WARNING, "Init data for the contract is empty");
-    m_initValJson = Json::arrayValue;
+    m_initValJson = make_shared<const Json::Value>(Json::arrayValue);
     return;
   }
   Json::CharReaderBuilder builder;
   unique_ptr<Json::CharReader> reader(builder.newCharReader());
   Json::Value root;
-  string dataStr(m_initData.begin(), m_initData.end());
+  string dataStr(initData.begin(), initData.end());
   string errors;
   if (!reader->parse(dataStr.c_str(), dataStr.c_str() + dataStr.size(), &root,
                      &errors)) {
@@ -82,7 +94,7 @@ void Account::InitContract() {
                 "Failed to parse initialization contract json: " << errors);
     return;
   }
-  m_initValJson = root;
+  Json::Value initValJson = root;
 
   // Append createBlockNum
   {
@@ -90,8 +102,9 @@ void Account::InitContract() {
     createBlockNumObj["vname"] = "_creation_block";
     createBlockNumObj["type"] = "BNum";
     createBlockNumObj["value"] = to_string(GetCreateBlockNum());
-    m_initValJson.append(createBlockNumObj);
+    initValJson.append(createBlockNumObj);
   }
+  m_initValJson = make_shared<const Json::Value>(move(initValJson));
 
   for (auto& v : root) {
     if (!v.isMember("vname") || !v.isMember("type") || !v.isMember("value")) {
@@ -108,8 +121,10 @@ void Account::InitContract() {
     writer->write(v["value"], &oss);
     string value = oss.str();
 
-    SetStorage(vname, type, value, false);
+    BufferStorage(vname, type, value, false);
   }
+
+  FlushStorageBuffer();
 }
 
 void Account::SetCreateBlockNum(const uint64_t& blockNum) {
@@ -230,13 +245,65 @@ void Account::SetStorage(const h256& k_hash, const string& rlpStr) {
   m_storageRoot = m_storage.root();
 }
 
+void Account::BufferStorage(const h256& k_hash, const bytes& rlp) {
+  if (!isContract()) {
+    LOG_GENERAL(WARNING,
+                "Not contract account, why call Account::BufferStorage!");
+    return;
+  }
+  m_storageBuffer[k_hash] = rlp;
+}
+
+void Account::BufferStorage(const string& k, const string& type,
+                            const string& v, bool is_mutable) {
+  if (!isContract()) {
+    return;
+  }
+  RLPStream rlpStream(4);
+  rlpStream << k << (is_mutable ? "True" : "False") << type << v;
+
+  m_storageBuffer[GetKeyHash(k)] = rlpStream.out();
+}
+
+void Account::FlushStorageBuffer() {
+  if (m_storageBuffer.empty()) {
+    return;
+  }
+
+  if (!isContract()) {
+    m_storageBuffer.clear();
+    return;
+  }
+
+  // Each insert still rehashes its own trie path; what buffering saves is
+  // the repeated writes of a key within a call and the unchanged values
+  bool changed = false;
+  for (const auto& entry : m_storageBuffer) {
+    // Scilla reports every mutable field after each call, skip the trie
+    // rewrite for the ones whose value did not change
+    const string current = m_storage.at(entry.first);
+    if (current.size() == entry.second.size() &&
+        equal(entry.second.begin(), entry.second.end(), current.begin())) {
+      continue;
+    }
+    m_storage.insert(entry.first, entry.second);
+    changed = true;
+  }
+  m_storageBuffer.clear();
+
+  if (changed) {
+    m_storageRoot = m_storage.root();
+  }
+}
+
 vector<string> Account::GetStorage(const string& _k) const {
   if (!isContract()) {
     LOG_GENERAL(WARNING, "Not contract account, why call Account::GetStorage!");
     return {};
   }
 
-  dev::RLP rlp(m_storage.at(GetKeyHash(_k)));
+  const string raw = GetRawStorage(GetKeyHash(_k));
+  dev::RLP rlp(raw);
   // mutable, type, value
   return {rlp[1].toString(), rlp[2].toString(), rlp[3].toString()};
 }
@@ -247,14 +314,26 @@ string Account::GetRawStorage(const h256& k_hash) const {
     //             "Not contract account, why call Account::GetRawStorage!");
     return "";
   }
+  auto it = m_storageBuffer.find(k_hash);
+  if (it != m_storageBuffer.end()) {
+    return string(it->second.begin(), it->second.end());
+  }
   return m_storage.at(k_hash);
 }
 
-Json::Value Account::GetInitJson() const { return m_initValJson; }
+const Json::Value& Account::GetInitJson() const {
+  static const Json::Value emptyInitJson;
+  return m_initValJson ? *m_initValJson : emptyInitJson;
+}
 
-const bytes& Account::GetInitData() const { return m_initData; }
+const bytes& Account::GetInitData() const {
+  static const bytes emptyInitData;
+  return m_initData ? *m_initData : emptyInitData;
+}
 
-void Account::SetInitData(const bytes& initData) { m_initData = initData; }
+void Account::SetInitData(const bytes& initData) {
+  m_initData = make_shared<const bytes>(initData);
+}
 
 vector<h256> Account::GetStorageKeyHashes() const {
   vector<h256> keyHashes;
@@ -319,13 +398,17 @@ Json::Value Account::GetStorageJson() const {
   return root;
 }
 
-void Account::Commit() { m_prevRoot = m_storageRoot; }
+void Account::Commit() {
+  FlushStorageBuffer();
+  m_prevRoot = m_storageRoot;
+}
 
 void Account::RollBack() {
   if (!isContract()) {
     LOG_GENERAL(WARNING, "Not a contract, why call Account::RollBack");
     return;
   }
+  m_storageBuffer.clear();
   m_storageRoot = m_prevRoot;
   if (m_storageRoot != h256()) {
     m_storage.setRoot(m_storageRoot);
@@ -385,7 +468,7 @@ void Account::SetCode(const bytes& code) {
     return;
   }
 
-  m_codeCache = code;
+  m_codeCache = make_shared<const bytes>(code);
   SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
   sha2.Update(code);
   m_codeHash = dev::h256(sha2.Finalize());
@@ -394,7 +477,10 @@ void Account::SetCode(const bytes& code) {
   InitStorage();
 }
 
-const bytes& Account::GetCode() const { return m_codeCache; }
+const bytes& Account::GetCode() const {
+  static const bytes emptyCode;
+  return m_codeCache ? *m_codeCache : emptyCode;
+}
 
 const dev::h256& Account::GetCodeHash() const { return m_codeHash; }
 
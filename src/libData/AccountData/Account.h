@@ -25,6 +25,8 @@
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #include <boost/multiprecision/cpp_int.hpp>
 #pragma GCC diagnostic pop
+#include <map>
+#include <memory>
 #include <vector>
 
 #include "Address.h"
@@ -52,13 +54,22 @@ class Account : public SerializableDataBlock {
   dev::h256 m_codeHash;
   // The associated code for this account.
   uint64_t m_createBlockNum = 0;
-  Json::Value m_initValJson;
-  bytes m_initData;
-  bytes m_codeCache;
+  // Code and init data are never modified in place, only replaced, so copies
+  // of an account (e.g. in AccountStoreTemp) share them with the original
+  // and only duplicate the scalar fields
+  std::shared_ptr<const Json::Value> m_initValJson;
+  std::shared_ptr<const bytes> m_initData;
+  std::shared_ptr<const bytes> m_codeCache;
 
   const dev::h256 GetKeyHash(const std::string& key) const;
 
   AccountTrieDB<dev::h256, dev::OverlayDB> m_storage;
+  // Backing DB of m_storage, the contract state DB when null
+  dev::OverlayDB* m_storageDB = nullptr;
+
+  // Storage writes staged by BufferStorage, keyed (and thus sorted) by key
+  // hash, waiting to be applied to m_storage by FlushStorageBuffer
+  std::map<dev::h256, bytes> m_storageBuffer;
 
  public:
   Account();
@@ -76,6 +87,12 @@ class Account : public SerializableDataBlock {
   /// Utilization function for trieDB
   void InitStorage();
 
+  /// Moves the storage trie onto db (null for the contract state DB),
+  /// keeping the current root. Later writes go to db only.
+  void SetStorageDB(dev::OverlayDB* db);
+
+  dev::OverlayDB* GetStorageDB() const { return m_storageDB; }
+
   /// Parse the Immutable Data at Constract Initialization Stage
   void InitContract(const bytes& data);
 
@@ -132,12 +149,22 @@ class Account : public SerializableDataBlock {
   void SetStorage(std::string k, std::string type, std::string v,
                   bool is_mutable = true);
 
+  /// Stage a storage write without touching the trie
+  void BufferStorage(const dev::h256& k_hash, const bytes& rlp);
+
+  void BufferStorage(const std::string& k, const std::string& type,
+                     const std::string& v, bool is_mutable = true);
+
+  /// Apply the staged storage writes whose value differs from the trie, one
+  /// trie insert each
+  void FlushStorageBuffer();
+
   /// Return the data for a parameter, type + value
   std::vector<std::string> GetStorage(const std::string& _k) const;
 
   std::string GetRawStorage(const dev::h256& k_hash) const;
 
-  Json::Value GetInitJson() const;
+  const Json::Value& GetInitJson() const;
 
   const bytes& GetInitData() const;
 
@@ -277,6 +277,42 @@ bool AccountStore::UpdateAccountsTemp(const uint64_t& blockNum,
                                             transaction, receipt);
 }
 
+bool AccountStore::UpdateAccountsDryRun(const uint64_t& blockNum,
+                                        const unsigned int& numShards,
+                                        const bool& isDS,
+                                        const Transaction& transaction,
+                                        TransactionReceipt& receipt) {
+  LOG_MARKER();
+
+  AccountStoreDryRun accountStoreDryRun(*this);
+
+  const string scillaFilesDir =
+      SCILLA_FILES + "_dryrun/" + to_string(m_dryRunCounter++);
+  accountStoreDryRun.SetScillaFilesDir(scillaFilesDir);
+
+  bool ret = accountStoreDryRun.UpdateAccounts(blockNum, numShards, isDS,
+                                               transaction, receipt);
+
+  boost::system::error_code ec;
+  boost::filesystem::remove_all("./" + scillaFilesDir, ec);
+
+  return ret;
+}
+
+bool AccountStore::GetPrimaryAccount(const Address& address,
+                                     Account& account) {
+  // GetAccount may load the account from the state trie into the map
+  unique_lock<shared_timed_mutex> g(m_mutexPrimary);
+
+  const Account* primaryAccount = GetAccount(address);
+  if (primaryAccount == nullptr) {
+    return false;
+  }
+
+  account = *primaryAccount;
+  return true;
+}
+
 bool AccountStore::UpdateCoinbaseTemp(const Address& rewardee,
                                       const Address& genesisAddress,
                                       const uint128_t& amount) {
@@ -19,6 +19,7 @@
 #define __ACCOUNTSTORE_H__
 
 #include <json/json.h>
+#include <atomic>
 #include <map>
 #include <set>
 #include <shared_mutex>
@@ -47,7 +48,9 @@ using StateHash = dev::h256;
 
 class AccountStore;
 
-class AccountStoreTemp : public AccountStoreSC<std::map<Address, Account>> {
+class AccountStoreTemp
+    : public AccountStoreSC<std::unordered_map<Address, Account>> {
+ protected:
   // shared_ptr<unordered_map<Address, Account>> m_superAddressToAccount;
   AccountStore& m_parent;
 
@@ -61,7 +64,8 @@ class AccountStoreTemp : public AccountStoreSC<std::map<Address, Account>> {
   /// Returns the Account associated with the specified address.
   Account* GetAccount(const Address& address) override;
 
-  const std::shared_ptr<std::map<Address, Account>>& GetAddressToAccount() {
+  const std::shared_ptr<std::unordered_map<Address, Account>>&
+  GetAddressToAccount() {
     return this->m_addressToAccount;
   }
 
@@ -71,6 +75,22 @@ class AccountStoreTemp : public AccountStoreSC<std::map<Address, Account>> {
   }
 };
 
+/// Throwaway overlay of the committed AccountStore for simulating a
+/// transaction. Accounts are copied from the parent under its primary lock,
+/// so simulations can run alongside block processing without touching the
+/// AccountStoreTemp of the node. Contract storage tries of the accounts it
+/// hands out write to a private overlay of the contract state DB, discarded
+/// with this object.
+class AccountStoreDryRun : public AccountStoreTemp {
+  dev::OverlayDB m_stateDB;
+
+ public:
+  AccountStoreDryRun(AccountStore& parent);
+
+  /// Returns the Account associated with the specified address.
+  Account* GetAccount(const Address& address) override;
+};
+
 class AccountStore
     : public AccountStoreTrie<dev::OverlayDB,
                               std::unordered_map<Address, Account>>,
@@ -90,6 +110,9 @@ class AccountStore
 
   bytes m_stateDeltaSerialized;
 
+  // used to give each dry run its own interpreter working directory
+  std::atomic<uint64_t> m_dryRunCounter{0};
+
   AccountStore();
   ~AccountStore();
 
@@ -129,6 +152,16 @@ class AccountStore
                           const Transaction& transaction,
                           TransactionReceipt& receipt);
 
+  /// Executes the transaction on a copy-on-write overlay of the committed
+  /// states and discards the result, for gas estimation
+  bool UpdateAccountsDryRun(const uint64_t& blockNum,
+                            const unsigned int& numShards, const bool& isDS,
+                            const Transaction& transaction,
+                            TransactionReceipt& receipt);
+
+  /// Copies the committed account under the primary lock
+  bool GetPrimaryAccount(const Address& address, Account& account);
+
   void AddAccountTemp(const Address& address, const Account& account) {
     m_accountStoreTemp->AddAccount(address, account);
   }
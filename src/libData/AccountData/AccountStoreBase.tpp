@@ -56,8 +56,7 @@ bool AccountStoreBase<MAP>::Deserialize(const bytes& src, unsigned int offset) {
 template <class MAP>
 bool AccountStoreBase<MAP>::UpdateAccounts(const Transaction& transaction,
                                            TransactionReceipt& receipt) {
-  const PubKey& senderPubKey = transaction.GetSenderPubKey();
-  const Address fromAddr = Account::GetAddressFromPublicKey(senderPubKey);
+  const Address& fromAddr = transaction.GetSenderAddr();
   Address toAddr = transaction.GetToAddr();
   const boost::multiprecision::uint128_t& amount = transaction.GetAmount();
 
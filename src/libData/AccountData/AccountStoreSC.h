@@ -60,6 +60,11 @@ class AccountStoreSC : public AccountStoreBase<MAP> {
 
   unsigned int m_curDepth = 0;
 
+  // Working directory for the interpreter input/output files
+  std::string m_scillaFilesDir = SCILLA_FILES;
+
+  std::string GetScillaFile(const std::string& file) const;
+
   bool ParseContractCheckerOutput(const std::string& checkerPrint);
 
   bool ParseCreateContract(uint64_t& gasRemained,
@@ -97,6 +102,10 @@ class AccountStoreSC : public AccountStoreBase<MAP> {
  public:
   void Init() override;
 
+  /// Use a separate interpreter working directory, so that several stores
+  /// can invoke scilla at the same time
+  void SetScillaFilesDir(const std::string& dir);
+
   bool UpdateAccounts(const uint64_t& blockNum, const unsigned int& numShards,
                       const bool& isDS, const Transaction& transaction,
                       TransactionReceipt& receipt);
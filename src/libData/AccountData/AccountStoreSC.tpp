@@ -27,6 +27,17 @@ AccountStoreSC<MAP>::AccountStoreSC() {
   m_accountStoreAtomic = std::make_unique<AccountStoreAtomic<MAP>>(*this);
 }
 
+template <class MAP>
+void AccountStoreSC<MAP>::SetScillaFilesDir(const std::string& dir) {
+  m_scillaFilesDir = dir;
+}
+
+template <class MAP>
+std::string AccountStoreSC<MAP>::GetScillaFile(const std::string& file) const {
+  // file is one of the interpreter IO paths configured under SCILLA_FILES
+  return m_scillaFilesDir + file.substr(SCILLA_FILES.size());
+}
+
 template <class MAP>
 void AccountStoreSC<MAP>::Init() {
   std::lock_guard<std::mutex> g(m_mutexUpdateAccounts);
@@ -49,8 +60,7 @@ bool AccountStoreSC<MAP>::UpdateAccounts(const uint64_t& blockNum,
 
   std::lock_guard<std::mutex> g(m_mutexUpdateAccounts);
 
-  const PubKey& senderPubKey = transaction.GetSenderPubKey();
-  const Address fromAddr = Account::GetAddressFromPublicKey(senderPubKey);
+  const Address& fromAddr = transaction.GetSenderAddr();
   Address toAddr = transaction.GetToAddr();
 
   const boost::multiprecision::uint128_t& amount = transaction.GetAmount();
@@ -361,8 +371,8 @@ template <class MAP>
 void AccountStoreSC<MAP>::ExportCreateContractFiles(const Account& contract) {
   LOG_MARKER();
 
-  boost::filesystem::remove_all("./" + SCILLA_FILES);
-  boost::filesystem::create_directories("./" + SCILLA_FILES);
+  boost::filesystem::remove_all("./" + m_scillaFilesDir);
+  boost::filesystem::create_directories("./" + m_scillaFilesDir);
 
   if (!(boost::filesystem::exists("./" + SCILLA_LOG))) {
     boost::filesystem::create_directories("./" + SCILLA_LOG);
@@ -370,15 +380,15 @@ void AccountStoreSC<MAP>::ExportCreateContractFiles(const Account& contract) {
 
   // Scilla code
   // JSONUtils::writeJsontoFile(INPUT_CODE, contract.GetCode());
-  std::ofstream os(INPUT_CODE);
+  std::ofstream os(GetScillaFile(INPUT_CODE));
   os << DataConversion::CharArrayToString(contract.GetCode());
   os.close();
 
   // Initialize Json
-  JSONUtils::writeJsontoFile(INIT_JSON, contract.GetInitJson());
+  JSONUtils::writeJsontoFile(GetScillaFile(INIT_JSON), contract.GetInitJson());
 
   // Block Json
-  JSONUtils::writeJsontoFile(INPUT_BLOCKCHAIN_JSON,
+  JSONUtils::writeJsontoFile(GetScillaFile(INPUT_BLOCKCHAIN_JSON),
                              GetBlockStateJson(m_curBlockNum));
 }
 
@@ -386,8 +396,8 @@ template <class MAP>
 void AccountStoreSC<MAP>::ExportContractFiles(const Account& contract) {
   LOG_MARKER();
 
-  boost::filesystem::remove_all("./" + SCILLA_FILES);
-  boost::filesystem::create_directories("./" + SCILLA_FILES);
+  boost::filesystem::remove_all("./" + m_scillaFilesDir);
+  boost::filesystem::create_directories("./" + m_scillaFilesDir);
 
   if (!(boost::filesystem::exists("./" + SCILLA_LOG))) {
     boost::filesystem::create_directories("./" + SCILLA_LOG);
@@ -395,18 +405,19 @@ void AccountStoreSC<MAP>::ExportContractFiles(const Account& contract) {
 
   // Scilla code
   // JSONUtils::writeJsontoFile(INPUT_CODE, contract.GetCode());
-  std::ofstream os(INPUT_CODE);
+  std::ofstream os(GetScillaFile(INPUT_CODE));
   os << DataConversion::CharArrayToString(contract.GetCode());
   os.close();
 
   // Initialize Json
-  JSONUtils::writeJsontoFile(INIT_JSON, contract.GetInitJson());
+  JSONUtils::writeJsontoFile(GetScillaFile(INIT_JSON), contract.GetInitJson());
 
   // State Json
-  JSONUtils::writeJsontoFile(INPUT_STATE_JSON, contract.GetStorageJson());
+  JSONUtils::writeJsontoFile(GetScillaFile(INPUT_STATE_JSON),
+                             contract.GetStorageJson());
 
   // Block Json
-  JSONUtils::writeJsontoFile(INPUT_BLOCKCHAIN_JSON,
+  JSONUtils::writeJsontoFile(GetScillaFile(INPUT_BLOCKCHAIN_JSON),
                              GetBlockStateJson(m_curBlockNum));
 }
 
@@ -425,12 +436,10 @@ bool AccountStoreSC<MAP>::ExportCallContractFiles(
     return false;
   }
   std::string prepend = "0x";
-  msgObj["_sender"] =
-      prepend +
-      Account::GetAddressFromPublicKey(transaction.GetSenderPubKey()).hex();
+  msgObj["_sender"] = prepend + transaction.GetSenderAddr().hex();
   msgObj["_amount"] = transaction.GetAmount().convert_to<std::string>();
 
-  JSONUtils::writeJsontoFile(INPUT_MESSAGE_JSON, msgObj);
+  JSONUtils::writeJsontoFile(GetScillaFile(INPUT_MESSAGE_JSON), msgObj);
 
   return true;
 }
@@ -442,13 +451,13 @@ void AccountStoreSC<MAP>::ExportCallContractFiles(
 
   ExportContractFiles(contract);
 
-  JSONUtils::writeJsontoFile(INPUT_MESSAGE_JSON, contractData);
+  JSONUtils::writeJsontoFile(GetScillaFile(INPUT_MESSAGE_JSON), contractData);
 }
 
 template <class MAP>
 std::string AccountStoreSC<MAP>::GetContractCheckerCmdStr() {
-  std::string ret =
-      SCILLA_CHECKER + " -libdir " + SCILLA_LIB + " " + INPUT_CODE;
+  std::string ret = SCILLA_CHECKER + " -libdir " + SCILLA_LIB + " " +
+                    GetScillaFile(INPUT_CODE);
   LOG_GENERAL(INFO, ret);
   return ret;
 }
@@ -456,10 +465,11 @@ std::string AccountStoreSC<MAP>::GetContractCheckerCmdStr() {
 template <class MAP>
 std::string AccountStoreSC<MAP>::GetCreateContractCmdStr(
     const uint64_t& available_gas) {
-  std::string ret = SCILLA_BINARY + " -init " + INIT_JSON + " -iblockchain " +
-                    INPUT_BLOCKCHAIN_JSON + " -o " + OUTPUT_JSON + " -i " +
-                    INPUT_CODE + " -libdir " + SCILLA_LIB + " -gaslimit " +
-                    std::to_string(available_gas);
+  std::string ret =
+      SCILLA_BINARY + " -init " + GetScillaFile(INIT_JSON) + " -iblockchain " +
+      GetScillaFile(INPUT_BLOCKCHAIN_JSON) + " -o " +
+      GetScillaFile(OUTPUT_JSON) + " -i " + GetScillaFile(INPUT_CODE) +
+      " -libdir " + SCILLA_LIB + " -gaslimit " + std::to_string(available_gas);
   LOG_GENERAL(INFO, ret);
   return ret;
 }
@@ -467,11 +477,13 @@ std::string AccountStoreSC<MAP>::GetCreateContractCmdStr(
 template <class MAP>
 std::string AccountStoreSC<MAP>::GetCallContractCmdStr(
     const uint64_t& available_gas) {
-  std::string ret = SCILLA_BINARY + " -init " + INIT_JSON + " -istate " +
-                    INPUT_STATE_JSON + " -iblockchain " +
-                    INPUT_BLOCKCHAIN_JSON + " -imessage " + INPUT_MESSAGE_JSON +
-                    " -o " + OUTPUT_JSON + " -i " + INPUT_CODE + " -libdir " +
-                    SCILLA_LIB + " -gaslimit " + std::to_string(available_gas);
+  std::string ret =
+      SCILLA_BINARY + " -init " + GetScillaFile(INIT_JSON) + " -istate " +
+      GetScillaFile(INPUT_STATE_JSON) + " -iblockchain " +
+      GetScillaFile(INPUT_BLOCKCHAIN_JSON) + " -imessage " +
+      GetScillaFile(INPUT_MESSAGE_JSON) + " -o " + GetScillaFile(OUTPUT_JSON) +
+      " -i " + GetScillaFile(INPUT_CODE) + " -libdir " + SCILLA_LIB +
+      " -gaslimit " + std::to_string(available_gas);
   LOG_GENERAL(INFO, ret);
   return ret;
 }
@@ -511,7 +523,7 @@ bool AccountStoreSC<MAP>::ParseCreateContractOutput(
     Json::Value& jsonOutput, const std::string& runnerPrint) {
   // LOG_MARKER();
 
-  std::ifstream in(OUTPUT_JSON, std::ios::binary);
+  std::ifstream in(GetScillaFile(OUTPUT_JSON), std::ios::binary);
   std::string outStr;
 
   if (!in.is_open()) {
@@ -597,7 +609,7 @@ bool AccountStoreSC<MAP>::ParseCallContractOutput(
     Json::Value& jsonOutput, const std::string& runnerPrint) {
   // LOG_MARKER();
 
-  std::ifstream in(OUTPUT_JSON, std::ios::binary);
+  std::ifstream in(GetScillaFile(OUTPUT_JSON), std::ios::binary);
   std::string outStr;
 
   if (!in.is_open()) {
@@ -672,6 +684,14 @@ bool AccountStoreSC<MAP>::ParseCallContractJsonOutput(const Json::Value& _json,
     LOG_GENERAL(WARNING, "Contract refuse amount transfer");
   }
 
+  Account* contractAccount = this->GetAccount(m_curContractAddr);
+  if (contractAccount == nullptr) {
+    LOG_GENERAL(WARNING, "contractAccount is null ptr");
+    return false;
+  }
+
+  // Stage all the state updates of this call and write them to the storage
+  // trie in one pass
   for (const auto& s : _json["states"]) {
     if (!s.isMember("vname") || !s.isMember("type") || !s.isMember("value")) {
       LOG_GENERAL(WARNING,
@@ -685,15 +705,11 @@ bool AccountStoreSC<MAP>::ParseCallContractJsonOutput(const Json::Value& _json,
                             ? s["value"].asString()
                             : JSONUtils::convertJsontoStr(s["value"]);
 
-    Account* contractAccount = this->GetAccount(m_curContractAddr);
-    if (contractAccount == nullptr) {
-      LOG_GENERAL(WARNING, "contractAccount is null ptr");
-      return false;
-    }
     if (vname != "_balance") {
-      contractAccount->SetStorage(vname, type, value);
+      contractAccount->BufferStorage(vname, type, value);
     }
   }
+  contractAccount->FlushStorageBuffer();
 
   for (const auto& e : _json["events"]) {
     LogEntry entry;
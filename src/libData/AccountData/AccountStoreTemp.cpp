@@ -17,6 +17,7 @@
 
 #include "AccountStore.h"
 #include "libMessage/Messenger.h"
+#include "libPersistence/ContractStorage.h"
 
 using namespace std;
 using namespace boost::multiprecision;
@@ -25,7 +26,7 @@ AccountStoreTemp::AccountStoreTemp(AccountStore& parent) : m_parent(parent) {}
 
 Account* AccountStoreTemp::GetAccount(const Address& address) {
   Account* account =
-      AccountStoreBase<map<Address, Account>>::GetAccount(address);
+      AccountStoreBase<unordered_map<Address, Account>>::GetAccount(address);
   if (account != nullptr) {
     // LOG_GENERAL(INFO, "Got From Temp");
     return account;
@@ -34,9 +35,8 @@ Account* AccountStoreTemp::GetAccount(const Address& address) {
   account = m_parent.GetAccount(address);
   if (account) {
     // LOG_GENERAL(INFO, "Got From Parent");
-    Account newaccount(*account);
-    m_addressToAccount->insert(make_pair(address, newaccount));
-    return &(m_addressToAccount->find(address))->second;
+    // Code and init data are shared with the parent account until replaced
+    return &(m_addressToAccount->emplace(address, *account).first->second);
   }
 
   // LOG_GENERAL(INFO, "Got Nullptr");
@@ -54,3 +54,27 @@ bool AccountStoreTemp::DeserializeDelta(const bytes& src, unsigned int offset) {
 
   return true;
 }
+
+AccountStoreDryRun::AccountStoreDryRun(AccountStore& parent)
+    : AccountStoreTemp(parent),
+      m_stateDB(&ContractStorage::GetContractStorage().GetStateDB()) {}
+
+Account* AccountStoreDryRun::GetAccount(const Address& address) {
+  Account* account =
+      AccountStoreBase<unordered_map<Address, Account>>::GetAccount(address);
+  if (account == nullptr) {
+    Account newaccount;
+    if (!m_parent.GetPrimaryAccount(address, newaccount)) {
+      return nullptr;
+    }
+    account =
+        &(m_addressToAccount->emplace(address, newaccount).first->second);
+  }
+
+  // Also catches accounts added by the transaction itself, before any
+  // contract storage is written
+  if (account->GetStorageDB() != &m_stateDB) {
+    account->SetStorageDB(&m_stateDB);
+  }
+  return account;
+}
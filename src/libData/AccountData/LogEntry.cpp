@@ -16,9 +16,21 @@
  */
 
 #include "LogEntry.h"
+#include "libCrypto/Sha2.h"
 
 using namespace std;
 
+namespace {
+dev::h256 GetBloomHash(const Address& address, const string& eventName) {
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
+  sha2.Update(address.asBytes());
+  if (!eventName.empty()) {
+    sha2.Update(bytes(eventName.begin(), eventName.end()));
+  }
+  return dev::h256(sha2.Finalize());
+}
+}  // namespace
+
 bool LogEntry::Install(const Json::Value& eventObj,
                        const Address& address)  //, unsigned int& numIndexed)
 {
@@ -44,3 +56,15 @@ bool LogEntry::Install(const Json::Value& eventObj,
   m_eventObj["address"] = "0x" + address.hex();
   return true;
 }
+
+void LogEntry::AddToBloom(LogBloom& bloom, const Address& address,
+                          const string& eventName) {
+  bloom.shiftBloom<3>(GetBloomHash(address, ""));
+  bloom.shiftBloom<3>(GetBloomHash(address, eventName));
+}
+
+bool LogEntry::BloomMayContain(const LogBloom& bloom, const Address& address,
+                               const string& eventName) {
+  return bloom.contains(
+      GetBloomHash(address, eventName).bloomPart<3, LogBloom::size>());
+}
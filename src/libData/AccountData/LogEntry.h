@@ -20,6 +20,10 @@
 
 #include <json/json.h>
 #include "Address.h"
+#include "depends/common/FixedHash.h"
+
+/// Per-block summary of the (contract address, event name) pairs of its logs
+using LogBloom = dev::h2048;
 
 class LogEntry {
   Json::Value m_eventObj;
@@ -30,6 +34,17 @@ class LogEntry {
   bool Install(const Json::Value& eventObj,
                const Address& address);  //, unsigned int& numIndexed);
   const Json::Value& GetJsonObject() const { return m_eventObj; }
+
+  /// Marks an event of the given contract in the bloom. Both the address
+  /// alone and the (address, event name) pair are added, so the bloom can
+  /// answer queries with or without an event name.
+  static void AddToBloom(LogBloom& bloom, const Address& address,
+                         const std::string& eventName);
+
+  /// Returns false if the bloom certainly has no matching event. An empty
+  /// event name matches any event from the contract.
+  static bool BloomMayContain(const LogBloom& bloom, const Address& address,
+                              const std::string& eventName);
 };
 
 #endif  // __LOGENTRY_H__
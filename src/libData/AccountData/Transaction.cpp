@@ -34,12 +34,19 @@ bool Transaction::SerializeCoreFields(bytes& dst, unsigned int offset) const {
   return Messenger::SetTransactionCoreInfo(dst, offset, m_coreInfo);
 }
 
+void Transaction::SetSenderAddr() {
+  if (m_coreInfo.senderPubKey.Initialized()) {
+    m_senderAddr = Account::GetAddressFromPublicKey(m_coreInfo.senderPubKey);
+  }
+}
+
 Transaction::Transaction() {}
 
 Transaction::Transaction(const Transaction& src)
     : m_tranID(src.m_tranID),
       m_coreInfo(src.m_coreInfo),
-      m_signature(src.m_signature) {}
+      m_signature(src.m_signature),
+      m_senderAddr(src.m_senderAddr) {}
 
 Transaction::Transaction(const bytes& src, unsigned int offset) {
   Deserialize(src, offset);
@@ -52,6 +59,8 @@ Transaction::Transaction(const uint32_t& version, const uint64_t& nonce,
                          const bytes& data)
     : m_coreInfo(version, nonce, toAddr, senderKeyPair.second, amount, gasPrice,
                  gasLimit, code, data) {
+  SetSenderAddr();
+
   bytes txnData;
   SerializeCoreFields(txnData, 0);
 
@@ -81,7 +90,9 @@ Transaction::Transaction(const TxnHash& tranID, const uint32_t& version,
     : m_tranID(tranID),
       m_coreInfo(version, nonce, toAddr, senderPubKey, amount, gasPrice,
                  gasLimit, code, data),
-      m_signature(signature) {}
+      m_signature(signature) {
+  SetSenderAddr();
+}
 
 Transaction::Transaction(const uint32_t& version, const uint64_t& nonce,
                          const Address& toAddr, const PubKey& senderPubKey,
@@ -91,6 +102,8 @@ Transaction::Transaction(const uint32_t& version, const uint64_t& nonce,
     : m_coreInfo(version, nonce, toAddr, senderPubKey, amount, gasPrice,
                  gasLimit, code, data),
       m_signature(signature) {
+  SetSenderAddr();
+
   bytes txnData;
   SerializeCoreFields(txnData, 0);
 
@@ -114,7 +127,9 @@ Transaction::Transaction(const uint32_t& version, const uint64_t& nonce,
 Transaction::Transaction(const TxnHash& tranID,
                          const TransactionCoreInfo coreInfo,
                          const Signature& signature)
-    : m_tranID(tranID), m_coreInfo(coreInfo), m_signature(signature) {}
+    : m_tranID(tranID), m_coreInfo(coreInfo), m_signature(signature) {
+  SetSenderAddr();
+}
 
 bool Transaction::Serialize(bytes& dst, unsigned int offset) const {
   if (!Messenger::SetTransaction(dst, offset, *this)) {
@@ -150,9 +165,7 @@ const PubKey& Transaction::GetSenderPubKey() const {
   return m_coreInfo.senderPubKey;
 }
 
-Address Transaction::GetSenderAddr() const {
-  return Account::GetAddressFromPublicKey(GetSenderPubKey());
-}
+const Address& Transaction::GetSenderAddr() const { return m_senderAddr; }
 
 const uint128_t& Transaction::GetAmount() const { return m_coreInfo.amount; }
 
@@ -189,6 +202,10 @@ unsigned int Transaction::GetShardIndex(const Address& fromAddr,
   return x % numShards;
 }
 
+unsigned int Transaction::GetShardIndex(unsigned int numShards) const {
+  return GetShardIndex(m_senderAddr, numShards);
+}
+
 bool Transaction::operator==(const Transaction& tran) const {
   return ((m_tranID == tran.m_tranID) && (m_signature == tran.m_signature));
 }
@@ -206,6 +223,7 @@ Transaction& Transaction::operator=(const Transaction& src) {
        m_tranID.asArray().begin());
   m_signature = src.m_signature;
   m_coreInfo = src.m_coreInfo;
+  m_senderAddr = src.m_senderAddr;
 
   return *this;
 }
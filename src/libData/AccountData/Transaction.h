@@ -69,6 +69,11 @@ class Transaction : public SerializableDataBlock {
   TxnHash m_tranID;
   TransactionCoreInfo m_coreInfo;
   Signature m_signature;
+  // Derived from m_coreInfo.senderPubKey whenever that is set; zero while the
+  // key is uninitialized
+  Address m_senderAddr;
+
+  void SetSenderAddr();
 
  public:
   /// Default constructor.
@@ -135,8 +140,8 @@ class Transaction : public SerializableDataBlock {
   //// Returns the sender's Public Key.
   const PubKey& GetSenderPubKey() const;
 
-  /// Returns the sender's Address
-  Address GetSenderAddr() const;
+  /// Returns the sender's Address, computed when the transaction was built.
+  const Address& GetSenderAddr() const;
 
   /// Returns the transaction amount.
   const boost::multiprecision::uint128_t& GetAmount() const;
@@ -163,6 +168,9 @@ class Transaction : public SerializableDataBlock {
   static unsigned int GetShardIndex(const Address& fromAddr,
                                     unsigned int numShards);
 
+  /// Identifies the shard number that should process this transaction.
+  unsigned int GetShardIndex(unsigned int numShards) const;
+
   /// Equality comparison operator.
   bool operator==(const Transaction& tran) const;
 
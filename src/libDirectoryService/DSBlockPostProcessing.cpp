@@ -202,6 +202,8 @@ void DirectoryService::SendDSBlockToShardNodes(
       P2PComm::GetInstance().SendBroadcastMessage(shardDSBlockReceivers,
                                                   dsblock_message_to_shard);
     } else {
+      // Not erasure-coded even with ERASURE_CODED_DISSEMINATION: shard nodes
+      // learn their relay peers from the sharding structure in this message
       vector<Peer> shard_peers;
       for (const auto& kv : *p) {
         shard_peers.emplace_back(std::get<SHARD_NODE_PEER>(kv));
@@ -175,7 +175,8 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
       *m_finalBlock, *m_mediator.m_DSCommittee, m_shards, t_microBlocks,
       m_mediator.m_lookup->GetLookupNodes(),
       m_mediator.m_txBlockChain.GetLastBlock().GetBlockHash(), m_consensusMyID,
-      composeFinalBlockMessageForSender);
+      composeFinalBlockMessageForSender, SendDataToLookupFuncDefault,
+      GetSendDataToShardFuncForDS());
 
   LOG_STATE(
       "[FLBLK]["
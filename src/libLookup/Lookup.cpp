@@ -3327,10 +3327,7 @@ bool Lookup::ProcessForwardTxn(const bytes& message, unsigned int offset,
     }
 
     for (const auto& txn : txns) {
-      const PubKey& senderPubKey = txn.GetSenderPubKey();
-      const Address fromAddr = Account::GetAddressFromPublicKey(senderPubKey);
-      unsigned int shard = Transaction::GetShardIndex(fromAddr, shard_size);
-      AddToTxnShardMap(txn, shard);
+      AddToTxnShardMap(txn, txn.GetShardIndex(shard_size));
     }
   } else {
     for (const auto& txn : txns) {
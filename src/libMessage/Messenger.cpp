@@ -16,6 +16,7 @@
  */
 
 #include "Messenger.h"
+#include "libCrypto/Sha256Batch.h"
 #include "libData/AccountData/AccountStore.h"
 #include "libData/AccountData/Transaction.h"
 #include "libData/BlockChainData/BlockLinkChain.h"
@@ -23,7 +24,10 @@
 #include "libMessage/ZilliqaMessage.pb.h"
 #include "libUtils/Logger.h"
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 #include <algorithm>
+#include <limits>
 #include <map>
 #include <random>
 #include <unordered_set>
@@ -32,6 +36,9 @@ using namespace boost::multiprecision;
 using namespace std;
 using namespace ZilliqaMessage;
 
+using google::protobuf::internal::WireFormatLite;
+using google::protobuf::io::CodedInputStream;
+
 // ============================================================================
 // Utility conversion functions
 // ============================================================================
@@ -80,15 +87,71 @@ void ProtobufByteArrayToNumber(const ByteArray& byteArray, T& number) {
   number = Serializable::GetNumber<T>(tmp, 0, S);
 }
 
+// Arena for the protobuf tree built or parsed by one Messenger call. Its
+// first block is a buffer kept per thread, so sub-messages are placed there
+// instead of being allocated one by one; trees that outgrow it continue in
+// heap blocks. A nested call on the same thread gets a plain arena.
+class MessageArena {
+  static const size_t INITIAL_BLOCK_SIZE = 256 * 1024;
+  static const size_t MAX_BLOCK_SIZE = 4 * 1024 * 1024;
+
+  static thread_local bool t_blockInUse;
+
+  bool m_ownsBlock;
+  google::protobuf::Arena m_arena;
+
+  static google::protobuf::ArenaOptions Options(bool useBlock) {
+    static thread_local vector<char> block(INITIAL_BLOCK_SIZE);
+
+    google::protobuf::ArenaOptions options;
+    options.start_block_size = INITIAL_BLOCK_SIZE;
+    options.max_block_size = MAX_BLOCK_SIZE;
+    if (useBlock) {
+      options.initial_block = block.data();
+      options.initial_block_size = block.size();
+    }
+    return options;
+  }
+
+ public:
+  MessageArena() : m_ownsBlock(!t_blockInUse), m_arena(Options(m_ownsBlock)) {
+    t_blockInUse = true;
+  }
+
+  ~MessageArena() {
+    if (m_ownsBlock) {
+      t_blockInUse = false;
+    }
+  }
+
+  MessageArena(MessageArena const&) = delete;
+  void operator=(MessageArena const&) = delete;
+
+  template <class T>
+  T& Create() {
+    return *google::protobuf::Arena::CreateMessage<T>(&m_arena);
+  }
+};
+
+thread_local bool MessageArena::t_blockInUse = false;
+
 template <class T>
 bool SerializeToArray(const T& protoMessage, bytes& dst,
                       const unsigned int offset) {
-  if ((offset + protoMessage.ByteSize()) > dst.size()) {
-    dst.resize(offset + protoMessage.ByteSize());
+  // Walk the tree for its size once; the serialization reuses the sizes
+  // cached by that walk
+  const size_t size = protoMessage.ByteSizeLong();
+  if (size > static_cast<size_t>(numeric_limits<int>::max())) {
+    LOG_GENERAL(WARNING, "Message too large to serialize: " << size);
+    return false;
+  }
+
+  if ((offset + size) > dst.size()) {
+    dst.resize(offset + size);
   }
 
-  return protoMessage.SerializeToArray(dst.data() + offset,
-                                       protoMessage.ByteSize());
+  protoMessage.SerializeWithCachedSizesToArray(dst.data() + offset);
+  return true;
 }
 
 template bool SerializeToArray<ProtoAccountStore>(
@@ -104,7 +167,7 @@ bool RepeatableToArray(const T& repeatable, bytes& dst,
       LOG_GENERAL(WARNING, "SerializeToArray failed, offset: " << tempOffset);
       return false;
     }
-    tempOffset += element.ByteSize();
+    tempOffset += element.GetCachedSize();
   }
   return true;
 }
@@ -114,6 +177,43 @@ void NumberToArray(const T& number, bytes& dst, const unsigned int offset) {
   Serializable::SetNumber<T>(dst, offset, number, S);
 }
 
+// Steps through the fields of a serialized message, handing each tag to
+// 'read'. Fields 'read' has no use for go to SkipField, which moves past them
+// without parsing or copying their contents.
+template <class Read>
+bool ReadFields(CodedInputStream& input, Read read) {
+  for (uint32_t tag = input.ReadTag(); tag != 0; tag = input.ReadTag()) {
+    if (!read(tag)) {
+      return false;
+    }
+  }
+  return input.ConsumedEntireMessage();
+}
+
+// Same for the fields of the sub-message that 'tag' starts
+template <class Read>
+bool ReadSubMessageFields(CodedInputStream& input, const uint32_t tag,
+                          Read read) {
+  int length;
+  if (WireFormatLite::GetTagWireType(tag) !=
+          WireFormatLite::WIRETYPE_LENGTH_DELIMITED ||
+      !input.ReadVarintSizeAsInt(&length)) {
+    return false;
+  }
+  const auto limit = input.PushLimit(length);
+  const bool result = ReadFields(input, read);
+  input.PopLimit(limit);
+  return result;
+}
+
+template <class T>
+bool ReadMessageField(CodedInputStream& input, const uint32_t tag,
+                      T& message) {
+  return WireFormatLite::GetTagWireType(tag) ==
+             WireFormatLite::WIRETYPE_LENGTH_DELIMITED &&
+         WireFormatLite::ReadMessage(&input, &message);
+}
+
 // ============================================================================
 // Functions to check for fields in primitives that are used for persistent
 // storage. Remove fields from the checks once they are deprecated.
@@ -355,8 +455,10 @@ bool ProtobufToAccount(const ProtoAccount& protoAccount, Account& account) {
         return false;
       }
 
-      account.SetStorage(tmpHash, entry.data());
+      account.BufferStorage(tmpHash,
+                            bytes(entry.data().begin(), entry.data().end()));
     }
+    account.FlushStorageBuffer();
 
     if (account.GetStorageRoot() != tmpStorageRoot) {
       std::string storagerootStr, tempstoragerootStr;
@@ -380,9 +482,70 @@ bool ProtobufToAccount(const ProtoAccount& protoAccount, Account& account) {
   return true;
 }
 
-void AccountDeltaToProtobuf(const Account* oldAccount,
-                            const Account& newAccount,
-                            ProtoAccount& protoAccount) {
+// State delta formats: 0 is ProtoAccountStore, 1 is ProtoAccountStoreDelta
+const unsigned int STATE_DELTA_VERSION_COMPACT = 1;
+
+void SetBalanceDelta(const int256_t& balanceDelta, ProtoAccount& protoAccount) {
+  protoAccount.set_numbersign(balanceDelta > 0);
+
+  uint128_t balanceDeltaNum(abs(balanceDelta));
+  NumberToProtobufByteArray<uint128_t, UINT128_SIZE>(
+      balanceDeltaNum, *protoAccount.mutable_balance());
+}
+
+// Only the non-zero parts are written, most changes fit in the low word
+void SetBalanceDelta(const int256_t& balanceDelta,
+                     ProtoAccountStoreDelta::AccountDelta& protoAccount) {
+  if (balanceDelta < 0) {
+    protoAccount.set_balancenegative(true);
+  }
+
+  const uint128_t balanceDeltaNum(abs(balanceDelta));
+  const uint64_t low = static_cast<uint64_t>(
+      balanceDeltaNum & numeric_limits<uint64_t>::max());
+  const uint64_t high = static_cast<uint64_t>(balanceDeltaNum >> 64);
+  if (low != 0) {
+    protoAccount.set_balancelow(low);
+  }
+  if (high != 0) {
+    protoAccount.set_balancehigh(high);
+  }
+}
+
+int256_t GetBalanceDelta(const ProtoAccount& protoAccount) {
+  uint128_t tmpNumber;
+
+  ProtobufByteArrayToNumber<uint128_t, UINT128_SIZE>(protoAccount.balance(),
+                                                     tmpNumber);
+
+  return protoAccount.numbersign() ? tmpNumber.convert_to<int256_t>()
+                                   : 0 - tmpNumber.convert_to<int256_t>();
+}
+
+int256_t GetBalanceDelta(
+    const ProtoAccountStoreDelta::AccountDelta& protoAccount) {
+  int256_t balanceDelta = protoAccount.balancehigh();
+  balanceDelta <<= 64;
+  balanceDelta |= protoAccount.balancelow();
+
+  return protoAccount.balancenegative() ? 0 - balanceDelta : balanceDelta;
+}
+
+void SetNonceDelta(const uint64_t nonceDelta, ProtoAccount& protoAccount) {
+  protoAccount.set_nonce(nonceDelta);
+}
+
+void SetNonceDelta(const uint64_t nonceDelta,
+                   ProtoAccountStoreDelta::AccountDelta& protoAccount) {
+  if (nonceDelta != 0) {
+    protoAccount.set_nonce(nonceDelta);
+  }
+}
+
+// 'T' is ProtoAccount or ProtoAccountStoreDelta::AccountDelta
+template <class T>
+bool AccountDeltaToProtobuf(const Account* oldAccount,
+                            const Account& newAccount, T& protoAccount) {
   Account acc(0, 0);
 
   bool fullCopy = false;
@@ -392,21 +555,17 @@ void AccountDeltaToProtobuf(const Account* oldAccount,
     fullCopy = true;
   }
 
-  int256_t balanceDelta =
-      int256_t(newAccount.GetBalance()) - int256_t(oldAccount->GetBalance());
-  protoAccount.set_numbersign(balanceDelta > 0);
-
-  uint128_t balanceDeltaNum(abs(balanceDelta));
-  NumberToProtobufByteArray<uint128_t, UINT128_SIZE>(
-      balanceDeltaNum, *protoAccount.mutable_balance());
+  SetBalanceDelta(
+      int256_t(newAccount.GetBalance()) - int256_t(oldAccount->GetBalance()),
+      protoAccount);
 
   uint64_t nonceDelta = 0;
   if (!SafeMath<uint64_t>::sub(newAccount.GetNonce(), oldAccount->GetNonce(),
                                nonceDelta)) {
-    return;
+    return false;
   }
 
-  protoAccount.set_nonce(nonceDelta);
+  SetNonceDelta(nonceDelta, protoAccount);
 
   if (!newAccount.GetCode().empty()) {
     if (fullCopy) {
@@ -431,19 +590,14 @@ void AccountDeltaToProtobuf(const Account* oldAccount,
       }
     }
   }
+
+  return true;
 }
 
-bool ProtobufToAccountDelta(const ProtoAccount& protoAccount, Account& account,
+template <class T>
+bool ProtobufToAccountDelta(const T& protoAccount, Account& account,
                             const bool fullCopy) {
-  uint128_t tmpNumber;
-
-  ProtobufByteArrayToNumber<uint128_t, UINT128_SIZE>(protoAccount.balance(),
-                                                     tmpNumber);
-
-  int256_t balanceDelta = protoAccount.numbersign()
-                              ? tmpNumber.convert_to<int256_t>()
-                              : 0 - tmpNumber.convert_to<int256_t>();
-  account.ChangeBalance(balanceDelta);
+  account.ChangeBalance(GetBalanceDelta(protoAccount));
 
   account.IncreaseNonceBy(protoAccount.nonce());
 
@@ -496,8 +650,10 @@ bool ProtobufToAccountDelta(const ProtoAccount& protoAccount, Account& account,
           return false;
         }
 
-        account.SetStorage(tmpHash, entry.data());
+        account.BufferStorage(tmpHash,
+                              bytes(entry.data().begin(), entry.data().end()));
       }
+      account.FlushStorageBuffer();
 
       if (tmpStorageRoot != account.GetStorageRoot()) {
         std::string storagerootStr, tempstoragerootStr;
@@ -833,7 +989,10 @@ void TransactionToProtobuf(const Transaction& transaction,
                                   *protoTransaction.mutable_signature());
 }
 
+/// Checks a transaction against the serialized core info and its hash
 void ProtobufToTransaction(const ProtoTransaction& protoTransaction,
+                           const bytes& txnData,
+                           const SHA256Batch::Digest& hash,
                            Transaction& transaction) {
   TxnHash tranID;
   TransactionCoreInfo txnCoreInfo;
@@ -849,16 +1008,6 @@ void ProtobufToTransaction(const ProtoTransaction& protoTransaction,
 
   ProtobufByteArrayToSerializable(protoTransaction.signature(), signature);
 
-  bytes txnData;
-  if (!SerializeToArray(protoTransaction.info(), txnData, 0)) {
-    LOG_GENERAL(WARNING, "Serialize Proto transaction core info failed.");
-    return;
-  }
-
-  SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
-  sha2.Update(txnData);
-  const bytes& hash = sha2.Finalize();
-
   if (!std::equal(hash.begin(), hash.end(), tranID.begin(), tranID.end())) {
     TxnHash expected;
     copy(hash.begin(), hash.end(), expected.asArray().begin());
@@ -880,6 +1029,58 @@ void ProtobufToTransaction(const ProtoTransaction& protoTransaction,
       txnCoreInfo.gasLimit, txnCoreInfo.code, txnCoreInfo.data, signature);
 }
 
+void ProtobufToTransaction(const ProtoTransaction& protoTransaction,
+                           Transaction& transaction) {
+  bytes txnData;
+  if (!SerializeToArray(protoTransaction.info(), txnData, 0)) {
+    LOG_GENERAL(WARNING, "Serialize Proto transaction core info failed.");
+    return;
+  }
+
+  SHA256Batch::Digest hash;
+  SHA256(txnData.data(), txnData.size(), hash.data());
+
+  ProtobufToTransaction(protoTransaction, txnData, hash, transaction);
+}
+
+/// Appends one Transaction per entry, hashing all the core infos in one batch.
+/// An entry that fails verification appends a default Transaction.
+void ProtobufToTransactions(
+    const std::vector<const ProtoTransaction*>& protoTransactions,
+    std::vector<Transaction>& txns) {
+  std::vector<bytes> txnDatas(protoTransactions.size());
+  std::vector<bool> serialized(protoTransactions.size(), false);
+  for (size_t i = 0; i < protoTransactions.size(); i++) {
+    serialized[i] =
+        SerializeToArray(protoTransactions[i]->info(), txnDatas[i], 0);
+  }
+
+  std::vector<SHA256Batch::Digest> hashes;
+  SHA256Batch::Hash(txnDatas, hashes);
+
+  txns.reserve(txns.size() + protoTransactions.size());
+  for (size_t i = 0; i < protoTransactions.size(); i++) {
+    Transaction txn;
+    if (serialized[i]) {
+      ProtobufToTransaction(*protoTransactions[i], txnDatas[i], hashes[i],
+                            txn);
+    } else {
+      LOG_GENERAL(WARNING, "Serialize Proto transaction core info failed.");
+    }
+    txns.emplace_back(txn);
+  }
+}
+
+void ProtobufToTransactions(
+    const google::protobuf::RepeatedPtrField<ProtoTransaction>&
+        protoTransactions,
+    std::vector<Transaction>& txns) {
+  ProtobufToTransactions(
+      std::vector<const ProtoTransaction*>(protoTransactions.pointer_begin(),
+                                           protoTransactions.pointer_end()),
+      txns);
+}
+
 void TransactionOffsetToProtobuf(const std::vector<uint32_t>& txnOffsets,
                                  ProtoTxnFileOffset& protoTxnFileOffset) {
   for (const auto& offset : txnOffsets) {
@@ -905,11 +1106,7 @@ void TransactionArrayToProtobuf(const std::vector<Transaction>& txns,
 void ProtobufToTransactionArray(
     const ProtoTransactionArray& protoTransactionArray,
     std::vector<Transaction>& txns) {
-  for (const auto& protoTransaction : protoTransactionArray.transactions()) {
-    Transaction txn;
-    ProtobufToTransaction(protoTransaction, txn);
-    txns.push_back(txn);
-  }
+  ProtobufToTransactions(protoTransactionArray.transactions(), txns);
 }
 
 void TransactionReceiptToProtobuf(const TransactionReceipt& transReceipt,
@@ -1764,13 +1961,9 @@ bool SetConsensusAnnouncementCore(
         LOG_GENERAL(WARNING, "Announcement dsblock content not initialized.");
         return false;
       }
-      inputToSigning.resize(announcement.consensusinfo().ByteSize() +
-                            announcement.dsblock().ByteSize());
-      announcement.consensusinfo().SerializeToArray(
-          inputToSigning.data(), announcement.consensusinfo().ByteSize());
-      announcement.dsblock().SerializeToArray(
-          inputToSigning.data() + announcement.consensusinfo().ByteSize(),
-          announcement.dsblock().ByteSize());
+      SerializeToArray(announcement.consensusinfo(), inputToSigning, 0);
+      SerializeToArray(announcement.dsblock(), inputToSigning,
+                       inputToSigning.size());
       break;
     case ConsensusAnnouncement::AnnouncementCase::kMicroblock:
       if (!announcement.microblock().IsInitialized()) {
@@ -1778,13 +1971,9 @@ bool SetConsensusAnnouncementCore(
                     "Announcement microblock content not initialized.");
         return false;
       }
-      inputToSigning.resize(announcement.consensusinfo().ByteSize() +
-                            announcement.microblock().ByteSize());
-      announcement.consensusinfo().SerializeToArray(
-          inputToSigning.data(), announcement.consensusinfo().ByteSize());
-      announcement.microblock().SerializeToArray(
-          inputToSigning.data() + announcement.consensusinfo().ByteSize(),
-          announcement.microblock().ByteSize());
+      SerializeToArray(announcement.consensusinfo(), inputToSigning, 0);
+      SerializeToArray(announcement.microblock(), inputToSigning,
+                       inputToSigning.size());
       break;
     case ConsensusAnnouncement::AnnouncementCase::kFinalblock:
       if (!announcement.finalblock().IsInitialized()) {
@@ -1792,26 +1981,18 @@ bool SetConsensusAnnouncementCore(
                     "Announcement finalblock content not initialized.");
         return false;
       }
-      inputToSigning.resize(announcement.consensusinfo().ByteSize() +
-                            announcement.finalblock().ByteSize());
-      announcement.consensusinfo().SerializeToArray(
-          inputToSigning.data(), announcement.consensusinfo().ByteSize());
-      announcement.finalblock().SerializeToArray(
-          inputToSigning.data() + announcement.consensusinfo().ByteSize(),
-          announcement.finalblock().ByteSize());
+      SerializeToArray(announcement.consensusinfo(), inputToSigning, 0);
+      SerializeToArray(announcement.finalblock(), inputToSigning,
+                       inputToSigning.size());
       break;
     case ConsensusAnnouncement::AnnouncementCase::kVcblock:
       if (!announcement.vcblock().IsInitialized()) {
         LOG_GENERAL(WARNING, "Announcement vcblock content not initialized.");
         return false;
       }
-      inputToSigning.resize(announcement.consensusinfo().ByteSize() +
-                            announcement.vcblock().ByteSize());
-      announcement.consensusinfo().SerializeToArray(
-          inputToSigning.data(), announcement.consensusinfo().ByteSize());
-      announcement.vcblock().SerializeToArray(
-          inputToSigning.data() + announcement.consensusinfo().ByteSize(),
-          announcement.vcblock().ByteSize());
+      SerializeToArray(announcement.consensusinfo(), inputToSigning, 0);
+      SerializeToArray(announcement.vcblock(), inputToSigning,
+                       inputToSigning.size());
       break;
     case ConsensusAnnouncement::AnnouncementCase::kFallbackblock:
       if (!announcement.fallbackblock().IsInitialized()) {
@@ -1819,13 +2000,9 @@ bool SetConsensusAnnouncementCore(
                     "Announcement fallbackblock content not initialized.");
         return false;
       }
-      inputToSigning.resize(announcement.consensusinfo().ByteSize() +
-                            announcement.fallbackblock().ByteSize());
-      announcement.consensusinfo().SerializeToArray(
-          inputToSigning.data(), announcement.consensusinfo().ByteSize());
-      announcement.fallbackblock().SerializeToArray(
-          inputToSigning.data() + announcement.consensusinfo().ByteSize(),
-          announcement.fallbackblock().ByteSize());
+      SerializeToArray(announcement.consensusinfo(), inputToSigning, 0);
+      SerializeToArray(announcement.fallbackblock(), inputToSigning,
+                       inputToSigning.size());
       break;
     case ConsensusAnnouncement::AnnouncementCase::ANNOUNCEMENT_NOT_SET:
     default:
@@ -1904,49 +2081,24 @@ bool GetConsensusAnnouncementCore(
   bytes tmp;
 
   if (announcement.has_dsblock() && announcement.dsblock().IsInitialized()) {
-    tmp.resize(announcement.consensusinfo().ByteSize() +
-               announcement.dsblock().ByteSize());
-    announcement.consensusinfo().SerializeToArray(
-        tmp.data(), announcement.consensusinfo().ByteSize());
-    announcement.dsblock().SerializeToArray(
-        tmp.data() + announcement.consensusinfo().ByteSize(),
-        announcement.dsblock().ByteSize());
+    SerializeToArray(announcement.consensusinfo(), tmp, 0);
+    SerializeToArray(announcement.dsblock(), tmp, tmp.size());
   } else if (announcement.has_microblock() &&
              announcement.microblock().IsInitialized()) {
-    tmp.resize(announcement.consensusinfo().ByteSize() +
-               announcement.microblock().ByteSize());
-    announcement.consensusinfo().SerializeToArray(
-        tmp.data(), announcement.consensusinfo().ByteSize());
-    announcement.microblock().SerializeToArray(
-        tmp.data() + announcement.consensusinfo().ByteSize(),
-        announcement.microblock().ByteSize());
+    SerializeToArray(announcement.consensusinfo(), tmp, 0);
+    SerializeToArray(announcement.microblock(), tmp, tmp.size());
   } else if (announcement.has_finalblock() &&
              announcement.finalblock().IsInitialized()) {
-    tmp.resize(announcement.consensusinfo().ByteSize() +
-               announcement.finalblock().ByteSize());
-    announcement.consensusinfo().SerializeToArray(
-        tmp.data(), announcement.consensusinfo().ByteSize());
-    announcement.finalblock().SerializeToArray(
-        tmp.data() + announcement.consensusinfo().ByteSize(),
-        announcement.finalblock().ByteSize());
+    SerializeToArray(announcement.consensusinfo(), tmp, 0);
+    SerializeToArray(announcement.finalblock(), tmp, tmp.size());
   } else if (announcement.has_vcblock() &&
              announcement.vcblock().IsInitialized()) {
-    tmp.resize(announcement.consensusinfo().ByteSize() +
-               announcement.vcblock().ByteSize());
-    announcement.consensusinfo().SerializeToArray(
-        tmp.data(), announcement.consensusinfo().ByteSize());
-    announcement.vcblock().SerializeToArray(
-        tmp.data() + announcement.consensusinfo().ByteSize(),
-        announcement.vcblock().ByteSize());
+    SerializeToArray(announcement.consensusinfo(), tmp, 0);
+    SerializeToArray(announcement.vcblock(), tmp, tmp.size());
   } else if (announcement.has_fallbackblock() &&
              announcement.fallbackblock().IsInitialized()) {
-    tmp.resize(announcement.consensusinfo().ByteSize() +
-               announcement.fallbackblock().ByteSize());
-    announcement.consensusinfo().SerializeToArray(
-        tmp.data(), announcement.consensusinfo().ByteSize());
-    announcement.fallbackblock().SerializeToArray(
-        tmp.data() + announcement.consensusinfo().ByteSize(),
-        announcement.fallbackblock().ByteSize());
+    SerializeToArray(announcement.consensusinfo(), tmp, 0);
+    SerializeToArray(announcement.fallbackblock(), tmp, tmp.size());
   } else {
     LOG_GENERAL(WARNING, "Announcement content not set.");
     return false;
@@ -2051,7 +2203,8 @@ bool Messenger::GetShardingStructureHash(const DequeOfShard& shards,
 
 bool Messenger::SetAccount(bytes& dst, const unsigned int offset,
                            const Account& account) {
-  ProtoAccount result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoAccount>();
 
   AccountToProtobuf(account, result);
 
@@ -2066,7 +2219,8 @@ bool Messenger::SetAccount(bytes& dst, const unsigned int offset,
 [[gnu::unused]] bool Messenger::GetAccount(const bytes& src,
                                            const unsigned int offset,
                                            Account& account) {
-  ProtoAccount result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoAccount>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2086,9 +2240,13 @@ bool Messenger::SetAccount(bytes& dst, const unsigned int offset,
 bool Messenger::SetAccountDelta(bytes& dst, const unsigned int offset,
                                 Account* oldAccount,
                                 const Account& newAccount) {
-  ProtoAccount result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoAccount>();
 
-  AccountDeltaToProtobuf(oldAccount, newAccount, result);
+  if (!AccountDeltaToProtobuf(oldAccount, newAccount, result)) {
+    LOG_GENERAL(WARNING, "AccountDeltaToProtobuf failed.");
+    return false;
+  }
 
   if (!result.IsInitialized()) {
     LOG_GENERAL(WARNING, "ProtoAccount initialization failed.");
@@ -2100,7 +2258,8 @@ bool Messenger::SetAccountDelta(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetAccountDelta(const bytes& src, const unsigned int offset,
                                 Account& account, const bool fullCopy) {
-  ProtoAccount result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoAccount>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2120,7 +2279,8 @@ bool Messenger::GetAccountDelta(const bytes& src, const unsigned int offset,
 template <class MAP>
 bool Messenger::SetAccountStore(bytes& dst, const unsigned int offset,
                                 const MAP& addressToAccount) {
-  ProtoAccountStore result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoAccountStore>();
 
   LOG_GENERAL(INFO, "Debug: Total number of accounts to serialize: "
                         << addressToAccount.size());
@@ -2147,7 +2307,8 @@ bool Messenger::SetAccountStore(bytes& dst, const unsigned int offset,
 template <class MAP>
 bool Messenger::GetAccountStore(const bytes& src, const unsigned int offset,
                                 MAP& addressToAccount) {
-  ProtoAccountStore result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoAccountStore>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2181,7 +2342,8 @@ bool Messenger::GetAccountStore(const bytes& src, const unsigned int offset,
 
 bool Messenger::GetAccountStore(const bytes& src, const unsigned int offset,
                                 AccountStore& accountStore) {
-  ProtoAccountStore result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoAccountStore>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2213,95 +2375,198 @@ bool Messenger::GetAccountStore(const bytes& src, const unsigned int offset,
   return true;
 }
 
-bool Messenger::SetAccountStoreDelta(bytes& dst, const unsigned int offset,
-                                     AccountStoreTemp& accountStoreTemp,
-                                     AccountStore& accountStore) {
-  ProtoAccountStore result;
+// Calls 'apply' with the address and delta of each account in a serialized
+// state delta, whether it is a ProtoAccountStore or a ProtoAccountStoreDelta
+template <class Apply>
+bool ForEachAccountDelta(const bytes& src, const unsigned int offset,
+                         Apply apply) {
+  if (offset > src.size()) {
+    LOG_GENERAL(WARNING, "Invalid offset " << offset
+                                           << " for state delta of size "
+                                           << src.size());
+    return false;
+  }
 
-  LOG_GENERAL(INFO, "Debug: Total number of account deltas to serialize: "
-                        << accountStoreTemp.GetNumOfAccounts());
+  MessageArena arena;
 
-  for (const auto& entry : *accountStoreTemp.GetAddressToAccount()) {
-    ProtoAccountStore::AddressAccount* protoEntry = result.add_entries();
-    protoEntry->set_address(entry.first.data(), entry.first.size);
-    ProtoAccount* protoEntryAccount = protoEntry->mutable_account();
-    AccountDeltaToProtobuf(accountStore.GetAccount(entry.first), entry.second,
-                           *protoEntryAccount);
-    if (!protoEntryAccount->IsInitialized()) {
-      LOG_GENERAL(WARNING, "ProtoAccount initialization failed.");
+  // ProtoAccountStoreDelta starts with its version, ProtoAccountStore has none
+  CodedInputStream input(src.data() + offset, src.size() - offset);
+  if (input.ReadTag() !=
+      WireFormatLite::MakeTag(ProtoAccountStoreDelta::kVersionFieldNumber,
+                              WireFormatLite::WIRETYPE_VARINT)) {
+    auto& result = arena.Create<ProtoAccountStore>();
+
+    result.ParseFromArray(src.data() + offset, src.size() - offset);
+
+    if (!result.IsInitialized()) {
+      LOG_GENERAL(WARNING, "ProtoAccountStore initialization failed.");
       return false;
     }
+
+    LOG_GENERAL(INFO,
+                "Total Number of Accounts Delta: " << result.entries().size());
+
+    for (const auto& entry : result.entries()) {
+      Address address;
+
+      copy(entry.address().begin(),
+           entry.address().begin() + min((unsigned int)entry.address().size(),
+                                         (unsigned int)address.size),
+           address.asArray().begin());
+
+      if (!apply(address, entry.account())) {
+        return false;
+      }
+    }
+
+    return true;
   }
 
-  if (!result.IsInitialized()) {
-    LOG_GENERAL(WARNING, "ProtoAccountStore initialization failed.");
+  auto& result = arena.Create<ProtoAccountStoreDelta>();
+
+  if (!result.ParseFromArray(src.data() + offset, src.size() - offset) ||
+      !result.IsInitialized()) {
+    LOG_GENERAL(WARNING, "ProtoAccountStoreDelta initialization failed.");
     return false;
   }
 
-  return SerializeToArray(result, dst, offset);
-}
+  if (result.version() != STATE_DELTA_VERSION_COMPACT) {
+    LOG_GENERAL(WARNING, "Unknown state delta version " << result.version());
+    return false;
+  }
 
-bool Messenger::StateDeltaToAddressMap(
-    const bytes& src, const unsigned int offset,
-    unordered_map<Address, int256_t>& accountMap) {
-  ProtoAccountStore result;
+  LOG_GENERAL(INFO,
+              "Total Number of Accounts Delta: " << result.accounts().size());
+
+  // Each address only carries the bytes that differ from the one before it
+  Address address;
+  bool first = true;
+  for (const auto& entry : result.accounts()) {
+    const unsigned int shared = entry.sharedprefix();
+    if ((first && shared > 0) || shared > address.size ||
+        shared + entry.addresssuffix().size() != address.size) {
+      LOG_GENERAL(WARNING, "Invalid address in state delta, shared prefix "
+                               << shared << " suffix size "
+                               << entry.addresssuffix().size());
+      return false;
+    }
+    copy(entry.addresssuffix().begin(), entry.addresssuffix().end(),
+         address.asArray().begin() + shared);
+    first = false;
 
-  result.ParseFromArray(src.data() + offset, src.size() - offset);
+    if (!apply(address, entry)) {
+      return false;
+    }
+  }
 
-  if (!result.IsInitialized()) {
-    LOG_GENERAL(WARNING, "ProtoAccountStore initialization failed");
-    return false;
+  return true;
+}
+
+bool Messenger::SetAccountStoreDelta(bytes& dst, const unsigned int offset,
+                                     AccountStoreTemp& accountStoreTemp,
+                                     AccountStore& accountStore,
+                                     const unsigned int version) {
+  LOG_GENERAL(INFO, "Debug: Total number of account deltas to serialize: "
+                        << accountStoreTemp.GetNumOfAccounts());
+
+  // The temp map is unordered, so emit the entries by address to keep the
+  // serialized delta (and its hash) identical across nodes
+  const auto& addressToAccount = *accountStoreTemp.GetAddressToAccount();
+  vector<Address> addresses;
+  addresses.reserve(addressToAccount.size());
+  for (const auto& entry : addressToAccount) {
+    addresses.emplace_back(entry.first);
   }
+  sort(addresses.begin(), addresses.end());
 
-  for (const auto& entry : result.entries()) {
-    Address address;
-    Account account;
+  MessageArena arena;
 
-    copy(entry.address().begin(),
-         entry.address().begin() + min((unsigned int)entry.address().size(),
-                                       (unsigned int)address.size),
-         address.asArray().begin());
+  if (version < STATE_DELTA_VERSION_COMPACT) {
+    auto& result = arena.Create<ProtoAccountStore>();
 
-    uint128_t tmpNumber;
+    for (const auto& address : addresses) {
+      ProtoAccountStore::AddressAccount* protoEntry = result.add_entries();
+      protoEntry->set_address(address.data(), address.size);
+      ProtoAccount* protoEntryAccount = protoEntry->mutable_account();
+      if (!AccountDeltaToProtobuf(accountStore.GetAccount(address),
+                                  addressToAccount.at(address),
+                                  *protoEntryAccount) ||
+          !protoEntryAccount->IsInitialized()) {
+        LOG_GENERAL(WARNING, "ProtoAccount initialization failed.");
+        return false;
+      }
+    }
 
-    ProtobufByteArrayToNumber<uint128_t, UINT128_SIZE>(
-        entry.account().balance(), tmpNumber);
+    if (!result.IsInitialized()) {
+      LOG_GENERAL(WARNING, "ProtoAccountStore initialization failed.");
+      return false;
+    }
 
-    int256_t balanceDelta = entry.account().numbersign()
-                                ? tmpNumber.convert_to<int256_t>()
-                                : 0 - tmpNumber.convert_to<int256_t>();
+    return SerializeToArray(result, dst, offset);
+  }
 
-    accountMap.insert(make_pair(address, balanceDelta));
+  if (version != STATE_DELTA_VERSION_COMPACT) {
+    LOG_GENERAL(WARNING, "Unknown state delta version " << version);
+    return false;
   }
 
-  return true;
-}
+  // Nothing changed serializes to nothing, as in the original format
+  if (addresses.empty()) {
+    return true;
+  }
 
-bool Messenger::GetAccountStoreDelta(const bytes& src,
-                                     const unsigned int offset,
-                                     AccountStore& accountStore,
-                                     const bool reversible) {
-  ProtoAccountStore result;
+  auto& result = arena.Create<ProtoAccountStoreDelta>();
+  result.set_version(version);
 
-  result.ParseFromArray(src.data() + offset, src.size() - offset);
+  const Address* previous = nullptr;
+  for (const auto& address : addresses) {
+    ProtoAccountStoreDelta::AccountDelta* protoEntry = result.add_accounts();
+
+    // Sorted addresses share leading bytes with their predecessor
+    unsigned int shared = 0;
+    if (previous != nullptr) {
+      while (shared < address.size && (*previous)[shared] == address[shared]) {
+        shared++;
+      }
+    }
+    if (shared > 0) {
+      protoEntry->set_sharedprefix(shared);
+    }
+    protoEntry->set_addresssuffix(address.data() + shared,
+                                  address.size - shared);
+    previous = &address;
+
+    if (!AccountDeltaToProtobuf(accountStore.GetAccount(address),
+                                addressToAccount.at(address), *protoEntry)) {
+      LOG_GENERAL(WARNING, "AccountDeltaToProtobuf failed for " << address);
+      return false;
+    }
+  }
 
   if (!result.IsInitialized()) {
-    LOG_GENERAL(WARNING, "ProtoAccountStore initialization failed.");
+    LOG_GENERAL(WARNING, "ProtoAccountStoreDelta initialization failed.");
     return false;
   }
 
-  LOG_GENERAL(INFO,
-              "Total Number of Accounts Delta: " << result.entries().size());
-
-  for (const auto& entry : result.entries()) {
-    Address address;
-    Account account;
+  return SerializeToArray(result, dst, offset);
+}
 
-    copy(entry.address().begin(),
-         entry.address().begin() + min((unsigned int)entry.address().size(),
-                                       (unsigned int)address.size),
-         address.asArray().begin());
+bool Messenger::StateDeltaToAddressMap(
+    const bytes& src, const unsigned int offset,
+    unordered_map<Address, int256_t>& accountMap) {
+  return ForEachAccountDelta(
+      src, offset, [&](const Address& address, const auto& protoAccount) {
+        accountMap.insert(make_pair(address, GetBalanceDelta(protoAccount)));
+        return true;
+      });
+}
 
+bool Messenger::GetAccountStoreDelta(const bytes& src,
+                                     const unsigned int offset,
+                                     AccountStore& accountStore,
+                                     const bool reversible) {
+  return ForEachAccountDelta(src, offset, [&](const Address& address,
+                                              const auto& protoAccount) {
     const Account* oriAccount = accountStore.GetAccount(address);
     bool fullCopy = false;
     if (oriAccount == nullptr) {
@@ -2316,45 +2581,25 @@ bool Messenger::GetAccountStoreDelta(const bytes& src,
       }
     }
 
-    account = *oriAccount;
-    if (!ProtobufToAccountDelta(entry.account(), account, fullCopy)) {
+    Account account = *oriAccount;
+    if (!ProtobufToAccountDelta(protoAccount, account, fullCopy)) {
       LOG_GENERAL(WARNING,
                   "ProtobufToAccountDelta failed for account at address "
-                      << entry.address());
+                      << address);
       return false;
     }
 
     accountStore.AddAccountDuringDeserialization(address, account, fullCopy,
                                                  reversible);
-  }
-
-  return true;
+    return true;
+  });
 }
 
 bool Messenger::GetAccountStoreDelta(const bytes& src,
                                      const unsigned int offset,
                                      AccountStoreTemp& accountStoreTemp) {
-  ProtoAccountStore result;
-
-  result.ParseFromArray(src.data() + offset, src.size() - offset);
-
-  if (!result.IsInitialized()) {
-    LOG_GENERAL(WARNING, "ProtoAccountStore initialization failed.");
-    return false;
-  }
-
-  LOG_GENERAL(INFO,
-              "Total Number of Accounts Delta: " << result.entries().size());
-
-  for (const auto& entry : result.entries()) {
-    Address address;
-    Account account;
-
-    copy(entry.address().begin(),
-         entry.address().begin() + min((unsigned int)entry.address().size(),
-                                       (unsigned int)address.size),
-         address.asArray().begin());
-
+  return ForEachAccountDelta(src, offset, [&](const Address& address,
+                                              const auto& protoAccount) {
     const Account* oriAccount = accountStoreTemp.GetAccount(address);
     bool fullCopy = false;
     if (oriAccount == nullptr) {
@@ -2371,19 +2616,18 @@ bool Messenger::GetAccountStoreDelta(const bytes& src,
       return false;
     }
 
-    account = *oriAccount;
+    Account account = *oriAccount;
 
-    if (!ProtobufToAccountDelta(entry.account(), account, fullCopy)) {
+    if (!ProtobufToAccountDelta(protoAccount, account, fullCopy)) {
       LOG_GENERAL(WARNING,
                   "ProtobufToAccountDelta failed for account at address "
-                      << entry.address());
+                      << address);
       return false;
     }
 
     accountStoreTemp.AddAccountDuringDeserialization(address, account);
-  }
-
-  return true;
+    return true;
+  });
 }
 
 bool Messenger::GetMbInfoHash(const std::vector<MicroBlockInfo>& mbInfos,
@@ -2422,7 +2666,8 @@ bool Messenger::GetMbInfoHash(const std::vector<MicroBlockInfo>& mbInfos,
 bool Messenger::SetDSBlockHeader(bytes& dst, const unsigned int offset,
                                  const DSBlockHeader& dsBlockHeader,
                                  bool concreteVarsOnly) {
-  ProtoDSBlock::DSBlockHeader result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoDSBlock::DSBlockHeader>();
 
   DSBlockHeaderToProtobuf(dsBlockHeader, result, concreteVarsOnly);
 
@@ -2436,7 +2681,8 @@ bool Messenger::SetDSBlockHeader(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetDSBlockHeader(const bytes& src, const unsigned int offset,
                                  DSBlockHeader& dsBlockHeader) {
-  ProtoDSBlock::DSBlockHeader result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoDSBlock::DSBlockHeader>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2450,7 +2696,8 @@ bool Messenger::GetDSBlockHeader(const bytes& src, const unsigned int offset,
 
 bool Messenger::SetDSBlock(bytes& dst, const unsigned int offset,
                            const DSBlock& dsBlock) {
-  ProtoDSBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoDSBlock>();
 
   DSBlockToProtobuf(dsBlock, result);
 
@@ -2464,7 +2711,8 @@ bool Messenger::SetDSBlock(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetDSBlock(const bytes& src, const unsigned int offset,
                            DSBlock& dsBlock) {
-  ProtoDSBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoDSBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2478,7 +2726,8 @@ bool Messenger::GetDSBlock(const bytes& src, const unsigned int offset,
 
 bool Messenger::SetMicroBlockHeader(bytes& dst, const unsigned int offset,
                                     const MicroBlockHeader& microBlockHeader) {
-  ProtoMicroBlock::MicroBlockHeader result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoMicroBlock::MicroBlockHeader>();
 
   MicroBlockHeaderToProtobuf(microBlockHeader, result);
 
@@ -2493,7 +2742,8 @@ bool Messenger::SetMicroBlockHeader(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetMicroBlockHeader(const bytes& src, const unsigned int offset,
                                     MicroBlockHeader& microBlockHeader) {
-  ProtoMicroBlock::MicroBlockHeader result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoMicroBlock::MicroBlockHeader>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2508,7 +2758,8 @@ bool Messenger::GetMicroBlockHeader(const bytes& src, const unsigned int offset,
 
 bool Messenger::SetMicroBlock(bytes& dst, const unsigned int offset,
                               const MicroBlock& microBlock) {
-  ProtoMicroBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoMicroBlock>();
 
   MicroBlockToProtobuf(microBlock, result);
 
@@ -2522,7 +2773,8 @@ bool Messenger::SetMicroBlock(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetMicroBlock(const bytes& src, const unsigned int offset,
                               MicroBlock& microBlock) {
-  ProtoMicroBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoMicroBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2536,7 +2788,8 @@ bool Messenger::GetMicroBlock(const bytes& src, const unsigned int offset,
 
 bool Messenger::SetTxBlockHeader(bytes& dst, const unsigned int offset,
                                  const TxBlockHeader& txBlockHeader) {
-  ProtoTxBlock::TxBlockHeader result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTxBlock::TxBlockHeader>();
 
   TxBlockHeaderToProtobuf(txBlockHeader, result);
 
@@ -2550,7 +2803,8 @@ bool Messenger::SetTxBlockHeader(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetTxBlockHeader(const bytes& src, const unsigned int offset,
                                  TxBlockHeader& txBlockHeader) {
-  ProtoTxBlock::TxBlockHeader result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTxBlock::TxBlockHeader>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2564,7 +2818,8 @@ bool Messenger::GetTxBlockHeader(const bytes& src, const unsigned int offset,
 
 bool Messenger::SetTxBlock(bytes& dst, const unsigned int offset,
                            const TxBlock& txBlock) {
-  ProtoTxBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTxBlock>();
 
   TxBlockToProtobuf(txBlock, result);
 
@@ -2578,7 +2833,8 @@ bool Messenger::SetTxBlock(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetTxBlock(const bytes& src, const unsigned int offset,
                            TxBlock& txBlock) {
-  ProtoTxBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTxBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2592,7 +2848,8 @@ bool Messenger::GetTxBlock(const bytes& src, const unsigned int offset,
 
 bool Messenger::SetVCBlockHeader(bytes& dst, const unsigned int offset,
                                  const VCBlockHeader& vcBlockHeader) {
-  ProtoVCBlock::VCBlockHeader result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoVCBlock::VCBlockHeader>();
 
   VCBlockHeaderToProtobuf(vcBlockHeader, result);
 
@@ -2606,7 +2863,8 @@ bool Messenger::SetVCBlockHeader(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetVCBlockHeader(const bytes& src, const unsigned int offset,
                                  VCBlockHeader& vcBlockHeader) {
-  ProtoVCBlock::VCBlockHeader result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoVCBlock::VCBlockHeader>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2620,7 +2878,8 @@ bool Messenger::GetVCBlockHeader(const bytes& src, const unsigned int offset,
 
 bool Messenger::SetVCBlock(bytes& dst, const unsigned int offset,
                            const VCBlock& vcBlock) {
-  ProtoVCBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoVCBlock>();
 
   VCBlockToProtobuf(vcBlock, result);
 
@@ -2634,7 +2893,8 @@ bool Messenger::SetVCBlock(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetVCBlock(const bytes& src, const unsigned int offset,
                            VCBlock& vcBlock) {
-  ProtoVCBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoVCBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2649,7 +2909,8 @@ bool Messenger::GetVCBlock(const bytes& src, const unsigned int offset,
 bool Messenger::SetFallbackBlockHeader(
     bytes& dst, const unsigned int offset,
     const FallbackBlockHeader& fallbackBlockHeader) {
-  ProtoFallbackBlock::FallbackBlockHeader result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoFallbackBlock::FallbackBlockHeader>();
 
   FallbackBlockHeaderToProtobuf(fallbackBlockHeader, result);
 
@@ -2666,7 +2927,8 @@ bool Messenger::SetFallbackBlockHeader(
 bool Messenger::GetFallbackBlockHeader(
     const bytes& src, const unsigned int offset,
     FallbackBlockHeader& fallbackBlockHeader) {
-  ProtoFallbackBlock::FallbackBlockHeader result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoFallbackBlock::FallbackBlockHeader>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2684,7 +2946,8 @@ bool Messenger::GetFallbackBlockHeader(
 
 bool Messenger::SetFallbackBlock(bytes& dst, const unsigned int offset,
                                  const FallbackBlock& fallbackBlock) {
-  ProtoFallbackBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoFallbackBlock>();
 
   FallbackBlockToProtobuf(fallbackBlock, result);
 
@@ -2698,7 +2961,8 @@ bool Messenger::SetFallbackBlock(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetFallbackBlock(const bytes& src, const unsigned int offset,
                                  FallbackBlock& fallbackBlock) {
-  ProtoFallbackBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoFallbackBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2714,7 +2978,8 @@ bool Messenger::GetFallbackBlock(const bytes& src, const unsigned int offset,
 
 bool Messenger::SetTransactionCoreInfo(bytes& dst, const unsigned int offset,
                                        const TransactionCoreInfo& transaction) {
-  ProtoTransactionCoreInfo result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTransactionCoreInfo>();
 
   TransactionCoreInfoToProtobuf(transaction, result);
 
@@ -2728,7 +2993,8 @@ bool Messenger::SetTransactionCoreInfo(bytes& dst, const unsigned int offset,
 bool Messenger::GetTransactionCoreInfo(const bytes& src,
                                        const unsigned int offset,
                                        TransactionCoreInfo& transaction) {
-  ProtoTransactionCoreInfo result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTransactionCoreInfo>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2744,7 +3010,8 @@ bool Messenger::GetTransactionCoreInfo(const bytes& src,
 
 bool Messenger::SetTransaction(bytes& dst, const unsigned int offset,
                                const Transaction& transaction) {
-  ProtoTransaction result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTransaction>();
 
   TransactionToProtobuf(transaction, result);
 
@@ -2757,7 +3024,8 @@ bool Messenger::SetTransaction(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetTransaction(const bytes& src, const unsigned int offset,
                                Transaction& transaction) {
-  ProtoTransaction result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTransaction>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2774,7 +3042,8 @@ bool Messenger::GetTransaction(const bytes& src, const unsigned int offset,
 bool Messenger::SetTransactionFileOffset(
     bytes& dst, const unsigned int offset,
     const std::vector<uint32_t>& txnOffsets) {
-  ProtoTxnFileOffset result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTxnFileOffset>();
   TransactionOffsetToProtobuf(txnOffsets, result);
   if (!result.IsInitialized()) {
     LOG_GENERAL(WARNING, "Transaction file offset initialization failed.");
@@ -2786,7 +3055,8 @@ bool Messenger::SetTransactionFileOffset(
 bool Messenger::GetTransactionFileOffset(const bytes& src,
                                          const unsigned int offset,
                                          std::vector<uint32_t>& txnOffsets) {
-  ProtoTxnFileOffset result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTxnFileOffset>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2801,7 +3071,8 @@ bool Messenger::GetTransactionFileOffset(const bytes& src,
 
 bool Messenger::SetTransactionArray(bytes& dst, const unsigned int offset,
                                     const std::vector<Transaction>& txns) {
-  ProtoTransactionArray result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTransactionArray>();
   TransactionArrayToProtobuf(txns, result);
   if (!result.IsInitialized()) {
     LOG_GENERAL(WARNING, "Transaction array initialization failed.");
@@ -2812,7 +3083,8 @@ bool Messenger::SetTransactionArray(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetTransactionArray(const bytes& src, const unsigned int offset,
                                     std::vector<Transaction>& txns) {
-  ProtoTransactionArray result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTransactionArray>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2828,7 +3100,8 @@ bool Messenger::GetTransactionArray(const bytes& src, const unsigned int offset,
 bool Messenger::SetTransactionReceipt(
     bytes& dst, const unsigned int offset,
     const TransactionReceipt& transactionReceipt) {
-  ProtoTransactionReceipt result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTransactionReceipt>();
 
   TransactionReceiptToProtobuf(transactionReceipt, result);
 
@@ -2842,7 +3115,8 @@ bool Messenger::SetTransactionReceipt(
 bool Messenger::GetTransactionReceipt(const bytes& src,
                                       const unsigned int offset,
                                       TransactionReceipt& transactionReceipt) {
-  ProtoTransactionReceipt result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTransactionReceipt>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2859,7 +3133,8 @@ bool Messenger::GetTransactionReceipt(const bytes& src,
 bool Messenger::SetTransactionWithReceipt(
     bytes& dst, const unsigned int offset,
     const TransactionWithReceipt& transactionWithReceipt) {
-  ProtoTransactionWithReceipt result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTransactionWithReceipt>();
 
   TransactionWithReceiptToProtobuf(transactionWithReceipt, result);
 
@@ -2873,7 +3148,8 @@ bool Messenger::SetTransactionWithReceipt(
 bool Messenger::GetTransactionWithReceipt(
     const bytes& src, const unsigned int offset,
     TransactionWithReceipt& transactionWithReceipt) {
-  ProtoTransactionWithReceipt result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoTransactionWithReceipt>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2889,7 +3165,8 @@ bool Messenger::GetTransactionWithReceipt(
 
 bool Messenger::SetPeer(bytes& dst, const unsigned int offset,
                         const Peer& peer) {
-  ProtoPeer result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoPeer>();
 
   PeerToProtobuf(peer, result);
 
@@ -2903,7 +3180,8 @@ bool Messenger::SetPeer(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetPeer(const bytes& src, const unsigned int offset,
                         Peer& peer) {
-  ProtoPeer result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoPeer>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2920,7 +3198,8 @@ bool Messenger::GetPeer(const bytes& src, const unsigned int offset,
 bool Messenger::SetBlockLink(
     bytes& dst, const unsigned int offset,
     const std::tuple<uint64_t, uint64_t, BlockType, BlockHash>& blocklink) {
-  ProtoBlockLink result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoBlockLink>();
 
   result.set_index(get<BlockLinkIndex::INDEX>(blocklink));
   result.set_dsindex(get<BlockLinkIndex::DSINDEX>(blocklink));
@@ -2938,7 +3217,8 @@ bool Messenger::SetBlockLink(
 bool Messenger::GetBlockLink(
     const bytes& src, const unsigned int offset,
     std::tuple<uint64_t, uint64_t, BlockType, BlockHash>& blocklink) {
-  ProtoBlockLink result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoBlockLink>();
   BlockHash blkhash;
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -2968,7 +3248,8 @@ bool Messenger::GetBlockLink(
 bool Messenger::SetFallbackBlockWShardingStructure(
     bytes& dst, const unsigned int offset, const FallbackBlock& fallbackblock,
     const DequeOfShard& shards) {
-  ProtoFallbackBlockWShardingStructure result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoFallbackBlockWShardingStructure>();
 
   FallbackBlockToProtobuf(fallbackblock, *result.mutable_fallbackblock());
   ShardingStructureToProtobuf(shards, *result.mutable_sharding());
@@ -2986,7 +3267,8 @@ bool Messenger::GetFallbackBlockWShardingStructure(const bytes& src,
                                                    const unsigned int offset,
                                                    FallbackBlock& fallbackblock,
                                                    DequeOfShard& shards) {
-  ProtoFallbackBlockWShardingStructure result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoFallbackBlockWShardingStructure>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3004,7 +3286,8 @@ bool Messenger::GetFallbackBlockWShardingStructure(const bytes& src,
 bool Messenger::SetDiagnosticData(bytes& dst, const unsigned int offset,
                                   const DequeOfShard& shards,
                                   const DequeOfDSNode& dsCommittee) {
-  ProtoDiagnosticData result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoDiagnosticData>();
 
   ShardingStructureToProtobuf(shards, *result.mutable_shards());
   DSCommitteeToProtobuf(dsCommittee, *result.mutable_dscommittee());
@@ -3020,7 +3303,8 @@ bool Messenger::SetDiagnosticData(bytes& dst, const unsigned int offset,
 bool Messenger::GetDiagnosticData(const bytes& src, const unsigned int offset,
                                   DequeOfShard& shards,
                                   DequeOfDSNode& dsCommittee) {
-  ProtoDiagnosticData result;
+  MessageArena arena;
+  auto& result = arena.Create<ProtoDiagnosticData>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3043,15 +3327,16 @@ bool Messenger::SetPMHello(bytes& dst, const unsigned int offset,
                            const uint32_t listenPort) {
   LOG_MARKER();
 
-  PMHello result;
+  MessageArena arena;
+  auto& result = arena.Create<PMHello>();
 
   SerializableToProtobufByteArray(key.second,
                                   *result.mutable_data()->mutable_pubkey());
   result.mutable_data()->set_listenport(listenPort);
 
   if (result.data().IsInitialized()) {
-    bytes tmp(result.data().ByteSize());
-    result.data().SerializeToArray(tmp.data(), tmp.size());
+    bytes tmp;
+    SerializeToArray(result.data(), tmp, 0);
 
     Signature signature;
     if (!Schnorr::GetInstance().Sign(tmp, key.first, key.second, signature)) {
@@ -3077,7 +3362,8 @@ bool Messenger::GetPMHello(const bytes& src, const unsigned int offset,
                            PubKey& pubKey, uint32_t& listenPort) {
   LOG_MARKER();
 
-  PMHello result;
+  MessageArena arena;
+  auto& result = arena.Create<PMHello>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3092,8 +3378,8 @@ bool Messenger::GetPMHello(const bytes& src, const unsigned int offset,
   Signature signature;
   ProtobufByteArrayToSerializable(result.signature(), signature);
 
-  bytes tmp(result.data().ByteSize());
-  result.data().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.data(), tmp, 0);
 
   if (!Schnorr::GetInstance().Verify(tmp, 0, tmp.size(), signature, pubKey)) {
     LOG_GENERAL(WARNING, "PMHello signature wrong.");
@@ -3115,7 +3401,8 @@ bool Messenger::SetDSPoWSubmission(
     const uint32_t& lookupId, const uint128_t& gasPrice) {
   LOG_MARKER();
 
-  DSPoWSubmission result;
+  MessageArena arena;
+  auto& result = arena.Create<DSPoWSubmission>();
 
   result.mutable_data()->set_blocknumber(blockNumber);
   result.mutable_data()->set_difficultylevel(difficultyLevel);
@@ -3134,8 +3421,8 @@ bool Messenger::SetDSPoWSubmission(
       gasPrice, *result.mutable_data()->mutable_gasprice());
 
   if (result.data().IsInitialized()) {
-    bytes tmp(result.data().ByteSize());
-    result.data().SerializeToArray(tmp.data(), tmp.size());
+    bytes tmp;
+    SerializeToArray(result.data(), tmp, 0);
 
     Signature signature;
     if (!MultiSig::GetInstance().SignKey(tmp, submitterKey, signature)) {
@@ -3166,7 +3453,8 @@ bool Messenger::GetDSPoWSubmission(const bytes& src, const unsigned int offset,
                                    uint32_t& lookupId, uint128_t& gasPrice) {
   LOG_MARKER();
 
-  DSPoWSubmission result;
+  MessageArena arena;
+  auto& result = arena.Create<DSPoWSubmission>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3189,8 +3477,8 @@ bool Messenger::GetDSPoWSubmission(const bytes& src, const unsigned int offset,
   ProtobufByteArrayToNumber<uint128_t, UINT128_SIZE>(result.data().gasprice(),
                                                      gasPrice);
 
-  bytes tmp(result.data().ByteSize());
-  result.data().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.data(), tmp, 0);
 
   if (!MultiSig::GetInstance().VerifyKey(tmp, signature, submitterPubKey)) {
     LOG_GENERAL(WARNING, "PoW submission signature wrong.");
@@ -3207,7 +3495,8 @@ bool Messenger::SetDSMicroBlockSubmission(bytes& dst, const unsigned int offset,
                                           const vector<bytes>& stateDeltas) {
   LOG_MARKER();
 
-  DSMicroBlockSubmission result;
+  MessageArena arena;
+  auto& result = arena.Create<DSMicroBlockSubmission>();
 
   result.set_microblocktype(microBlockType);
   result.set_epochnumber(epochNumber);
@@ -3232,7 +3521,8 @@ bool Messenger::SetDSPoWPacketSubmission(
     const pair<PrivKey, PubKey>& keys) {
   LOG_MARKER();
 
-  DSPoWPacketSubmission result;
+  MessageArena arena;
+  auto& result = arena.Create<DSPoWPacketSubmission>();
 
   for (const auto& sol : dsPowSolutions) {
     DSPowSolutionToProtobuf(sol,
@@ -3241,8 +3531,8 @@ bool Messenger::SetDSPoWPacketSubmission(
 
   SerializableToProtobufByteArray(keys.second, *result.mutable_pubkey());
 
-  bytes tmp(result.data().ByteSize());
-  result.data().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.data(), tmp, 0);
   Signature signature;
   if (!Schnorr::GetInstance().Sign(tmp, keys.first, keys.second, signature)) {
     LOG_GENERAL(WARNING, "Failed to sign DSPoWPacketSubmission");
@@ -3264,7 +3554,8 @@ bool Messenger::GetDSPowPacketSubmission(const bytes& src,
                                          PubKey& pubKey) {
   LOG_MARKER();
 
-  DSPoWPacketSubmission result;
+  MessageArena arena;
+  auto& result = arena.Create<DSPoWPacketSubmission>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3276,8 +3567,8 @@ bool Messenger::GetDSPowPacketSubmission(const bytes& src,
   ProtobufByteArrayToSerializable(result.pubkey(), pubKey);
   Signature signature;
   ProtobufByteArrayToSerializable(result.signature(), signature);
-  bytes tmp(result.data().ByteSize());
-  result.data().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.data(), tmp, 0);
   if (!Schnorr::GetInstance().Verify(tmp, 0, tmp.size(), signature, pubKey)) {
     LOG_GENERAL(WARNING, "DSPoWPacketSubmission signature wrong.");
     return false;
@@ -3300,7 +3591,8 @@ bool Messenger::GetDSMicroBlockSubmission(const bytes& src,
                                           vector<bytes>& stateDeltas) {
   LOG_MARKER();
 
-  DSMicroBlockSubmission result;
+  MessageArena arena;
+  auto& result = arena.Create<DSMicroBlockSubmission>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3662,7 +3954,8 @@ bool Messenger::SetDSMissingMicroBlocksErrorMsg(
     const uint32_t listenPort) {
   LOG_MARKER();
 
-  DSMissingMicroBlocksErrorMsg result;
+  MessageArena arena;
+  auto& result = arena.Create<DSMissingMicroBlocksErrorMsg>();
 
   for (const auto& hash : missingMicroBlockHashes) {
     result.add_mbhashes(hash.data(), hash.size);
@@ -3685,7 +3978,8 @@ bool Messenger::GetDSMissingMicroBlocksErrorMsg(
     uint32_t& listenPort) {
   LOG_MARKER();
 
-  DSMissingMicroBlocksErrorMsg result;
+  MessageArena arena;
+  auto& result = arena.Create<DSMissingMicroBlocksErrorMsg>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3719,7 +4013,8 @@ bool Messenger::SetNodeVCDSBlocksMessage(bytes& dst, const unsigned int offset,
                                          const DequeOfShard& shards) {
   LOG_MARKER();
 
-  NodeDSBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeDSBlock>();
 
   result.set_shardid(shardId);
   DSBlockToProtobuf(dsBlock, *result.mutable_dsblock());
@@ -3744,7 +4039,8 @@ bool Messenger::GetNodeVCDSBlocksMessage(const bytes& src,
                                          DequeOfShard& shards) {
   LOG_MARKER();
 
-  NodeDSBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeDSBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3769,6 +4065,48 @@ bool Messenger::GetNodeVCDSBlocksMessage(const bytes& src,
   return ProtobufToShardingStructure(result.sharding(), shards);
 }
 
+bool Messenger::GetNodeVCDSBlocksMessageHeader(const bytes& src,
+                                               const unsigned int offset,
+                                               uint32_t& shardId,
+                                               DSBlock& dsBlock) {
+  LOG_MARKER();
+
+  if (offset > src.size()) {
+    LOG_GENERAL(WARNING, "Invalid offset " << offset << " for message of size "
+                                           << src.size());
+    return false;
+  }
+
+  MessageArena arena;
+  auto& protoDSBlock = arena.Create<ProtoDSBlock>();
+  bool hasShardId = false;
+  bool hasDSBlock = false;
+
+  CodedInputStream input(src.data() + offset, src.size() - offset);
+  const bool parsed = ReadFields(input, [&](const uint32_t tag) {
+    switch (WireFormatLite::GetTagFieldNumber(tag)) {
+      case NodeDSBlock::kShardidFieldNumber:
+        hasShardId = true;
+        return WireFormatLite::GetTagWireType(tag) ==
+                   WireFormatLite::WIRETYPE_VARINT &&
+               input.ReadVarint32(&shardId);
+      case NodeDSBlock::kDsblockFieldNumber:
+        hasDSBlock = true;
+        return ReadMessageField(input, tag, protoDSBlock);
+      default:
+        // VC blocks and sharding structure
+        return WireFormatLite::SkipField(&input, tag);
+    }
+  });
+
+  if (!parsed || !hasShardId || !hasDSBlock) {
+    LOG_GENERAL(WARNING, "NodeDSBlock header parsing failed.");
+    return false;
+  }
+
+  return ProtobufToDSBlock(protoDSBlock, dsBlock);
+}
+
 bool Messenger::SetNodeFinalBlock(bytes& dst, const unsigned int offset,
                                   const uint64_t dsBlockNumber,
                                   const uint32_t consensusID,
@@ -3776,7 +4114,8 @@ bool Messenger::SetNodeFinalBlock(bytes& dst, const unsigned int offset,
                                   const bytes& stateDelta) {
   LOG_MARKER();
 
-  NodeFinalBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeFinalBlock>();
 
   result.set_dsblocknumber(dsBlockNumber);
   result.set_consensusid(consensusID);
@@ -3797,7 +4136,8 @@ bool Messenger::GetNodeFinalBlock(const bytes& src, const unsigned int offset,
                                   bytes& stateDelta) {
   LOG_MARKER();
 
-  NodeFinalBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeFinalBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3818,12 +4158,78 @@ bool Messenger::GetNodeFinalBlock(const bytes& src, const unsigned int offset,
   return true;
 }
 
+bool Messenger::GetNodeFinalBlockHeader(const bytes& src,
+                                        const unsigned int offset,
+                                        uint64_t& dsBlockNumber,
+                                        uint32_t& consensusID,
+                                        TxBlock& txBlock) {
+  LOG_MARKER();
+
+  if (offset > src.size()) {
+    LOG_GENERAL(WARNING, "Invalid offset " << offset << " for message of size "
+                                           << src.size());
+    return false;
+  }
+
+  MessageArena arena;
+  auto& protoTxBlock = arena.Create<ProtoTxBlock>();
+  bool hasDSBlockNumber = false;
+  bool hasConsensusID = false;
+  bool hasTxBlock = false;
+
+  // Only the header and block base of the Tx block are parsed
+  auto readTxBlock = [&](CodedInputStream& input, const uint32_t tag) {
+    switch (WireFormatLite::GetTagFieldNumber(tag)) {
+      case ProtoTxBlock::kHeaderFieldNumber:
+        return ReadMessageField(input, tag, *protoTxBlock.mutable_header());
+      case ProtoTxBlock::kBlockbaseFieldNumber:
+        return ReadMessageField(input, tag,
+                                *protoTxBlock.mutable_blockbase());
+      default:
+        // Microblock infos
+        return WireFormatLite::SkipField(&input, tag);
+    }
+  };
+
+  CodedInputStream input(src.data() + offset, src.size() - offset);
+  const bool parsed = ReadFields(input, [&](const uint32_t tag) {
+    switch (WireFormatLite::GetTagFieldNumber(tag)) {
+      case NodeFinalBlock::kDsblocknumberFieldNumber:
+        hasDSBlockNumber = true;
+        return WireFormatLite::GetTagWireType(tag) ==
+                   WireFormatLite::WIRETYPE_VARINT &&
+               input.ReadVarint64(&dsBlockNumber);
+      case NodeFinalBlock::kConsensusidFieldNumber:
+        hasConsensusID = true;
+        return WireFormatLite::GetTagWireType(tag) ==
+                   WireFormatLite::WIRETYPE_VARINT &&
+               input.ReadVarint32(&consensusID);
+      case NodeFinalBlock::kTxblockFieldNumber:
+        hasTxBlock = true;
+        return ReadSubMessageFields(input, tag, [&](const uint32_t txTag) {
+          return readTxBlock(input, txTag);
+        });
+      default:
+        // State delta and shard IDs
+        return WireFormatLite::SkipField(&input, tag);
+    }
+  });
+
+  if (!parsed || !hasDSBlockNumber || !hasConsensusID || !hasTxBlock) {
+    LOG_GENERAL(WARNING, "NodeFinalBlock header parsing failed.");
+    return false;
+  }
+
+  return ProtobufToTxBlock(protoTxBlock, txBlock);
+}
+
 bool Messenger::SetNodeMBnForwardTransaction(
     bytes& dst, const unsigned int offset, const MicroBlock& microBlock,
     const vector<TransactionWithReceipt>& txns) {
   LOG_MARKER();
 
-  NodeMBnForwardTransaction result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeMBnForwardTransaction>();
 
   MicroBlockToProtobuf(microBlock, *result.mutable_microblock());
 
@@ -3851,7 +4257,8 @@ bool Messenger::GetNodeMBnForwardTransaction(const bytes& src,
                                              MBnForwardedTxnEntry& entry) {
   LOG_MARKER();
 
-  NodeMBnForwardTransaction result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeMBnForwardTransaction>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3862,16 +4269,37 @@ bool Messenger::GetNodeMBnForwardTransaction(const bytes& src,
 
   ProtobufToMicroBlock(result.microblock(), entry.m_microBlock);
 
-  unsigned int txnsCount = 0;
-
+  // Parse every entry first so the transaction hashes, which the microblock
+  // tx root is checked against, are computed in one batch
+  vector<ProtoTransactionWithReceipt*> protoTxrs;
+  vector<const ProtoTransaction*> protoTxns;
   for (const auto& txn : result.txnswithreceipt()) {
-    TransactionWithReceipt txr;
-    ProtobufByteArrayToSerializable(txn, txr);
-    entry.m_transactions.emplace_back(txr);
-    txnsCount++;
+    auto& protoTxr = arena.Create<ProtoTransactionWithReceipt>();
+    protoTxr.ParseFromArray(txn.data().data(), txn.data().size());
+    if (!protoTxr.IsInitialized()) {
+      LOG_GENERAL(WARNING, "TransactionWithReceipt initialization failed.");
+      protoTxrs.emplace_back(nullptr);
+      continue;
+    }
+    protoTxrs.emplace_back(&protoTxr);
+    protoTxns.emplace_back(&protoTxr.transaction());
+  }
+
+  vector<Transaction> txns;
+  ProtobufToTransactions(protoTxns, txns);
+
+  auto txn = txns.begin();
+  for (const auto* protoTxr : protoTxrs) {
+    if (protoTxr == nullptr) {
+      entry.m_transactions.emplace_back();
+      continue;
+    }
+    TransactionReceipt receipt;
+    ProtobufToTransactionReceipt(protoTxr->receipt(), receipt);
+    entry.m_transactions.emplace_back(*txn++, receipt);
   }
 
-  LOG_GENERAL(INFO, entry << endl << " Txns: " << txnsCount);
+  LOG_GENERAL(INFO, entry << endl << " Txns: " << protoTxrs.size());
 
   return true;
 }
@@ -3880,7 +4308,8 @@ bool Messenger::SetNodeVCBlock(bytes& dst, const unsigned int offset,
                                const VCBlock& vcBlock) {
   LOG_MARKER();
 
-  NodeVCBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeVCBlock>();
 
   VCBlockToProtobuf(vcBlock, *result.mutable_vcblock());
 
@@ -3896,7 +4325,8 @@ bool Messenger::GetNodeVCBlock(const bytes& src, const unsigned int offset,
                                VCBlock& vcBlock) {
   LOG_MARKER();
 
-  NodeVCBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeVCBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3915,7 +4345,8 @@ bool Messenger::SetNodeForwardTxnBlock(
     const std::vector<Transaction>& txnsGenerated) {
   LOG_MARKER();
 
-  NodeForwardTxnBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeForwardTxnBlock>();
 
   result.set_epochnumber(epochNumber);
   result.set_dsblocknum(dsBlockNum);
@@ -3971,7 +4402,8 @@ bool Messenger::GetNodeForwardTxnBlock(const bytes& src,
                                        std::vector<Transaction>& txns) {
   LOG_MARKER();
 
-  NodeForwardTxnBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeForwardTxnBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -3999,11 +4431,7 @@ bool Messenger::GetNodeForwardTxnBlock(const bytes& src,
       return false;
     }
 
-    for (const auto& txn : result.transactions()) {
-      Transaction t;
-      ProtobufToTransaction(txn, t);
-      txns.emplace_back(t);
-    }
+    ProtobufToTransactions(result.transactions(), txns);
   }
 
   LOG_GENERAL(INFO, "Epoch: " << epochNumber << " Shard: " << shardId
@@ -4194,7 +4622,8 @@ bool Messenger::SetNodeFallbackBlock(bytes& dst, const unsigned int offset,
                                      const FallbackBlock& fallbackBlock) {
   LOG_MARKER();
 
-  NodeFallbackBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeFallbackBlock>();
 
   FallbackBlockToProtobuf(fallbackBlock, *result.mutable_fallbackblock());
 
@@ -4211,7 +4640,8 @@ bool Messenger::GetNodeFallbackBlock(const bytes& src,
                                      FallbackBlock& fallbackBlock) {
   LOG_MARKER();
 
-  NodeFallbackBlock result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeFallbackBlock>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4258,7 +4688,8 @@ bool Messenger::SetNodeMissingTxnsErrorMsg(
     const uint32_t listenPort) {
   LOG_MARKER();
 
-  NodeMissingTxnsErrorMsg result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeMissingTxnsErrorMsg>();
 
   for (const auto& hash : missingTxnHashes) {
     LOG_EPOCH(INFO, to_string(epochNum).c_str(), "Missing txn: " << hash);
@@ -4283,7 +4714,8 @@ bool Messenger::GetNodeMissingTxnsErrorMsg(const bytes& src,
                                            uint32_t& listenPort) {
   LOG_MARKER();
 
-  NodeMissingTxnsErrorMsg result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeMissingTxnsErrorMsg>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4314,7 +4746,8 @@ bool Messenger::SetLookupGetSeedPeers(bytes& dst, const unsigned int offset,
                                       const uint32_t listenPort) {
   LOG_MARKER();
 
-  LookupGetSeedPeers result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetSeedPeers>();
 
   result.set_listenport(listenPort);
 
@@ -4331,7 +4764,8 @@ bool Messenger::GetLookupGetSeedPeers(const bytes& src,
                                       uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetSeedPeers result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetSeedPeers>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4350,7 +4784,8 @@ bool Messenger::SetLookupSetSeedPeers(bytes& dst, const unsigned int offset,
                                       const vector<Peer>& candidateSeeds) {
   LOG_MARKER();
 
-  LookupSetSeedPeers result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetSeedPeers>();
 
   unordered_set<uint32_t> indicesAlreadyAdded;
 
@@ -4401,7 +4836,8 @@ bool Messenger::GetLookupSetSeedPeers(const bytes& src,
                                       vector<Peer>& candidateSeeds) {
   LOG_MARKER();
 
-  LookupSetSeedPeers result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetSeedPeers>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4443,7 +4879,8 @@ bool Messenger::SetLookupGetDSInfoFromSeed(bytes& dst,
                                            const bool initialDS) {
   LOG_MARKER();
 
-  LookupGetDSInfoFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetDSInfoFromSeed>();
 
   result.set_listenport(listenPort);
   result.set_initialds(initialDS);
@@ -4462,7 +4899,8 @@ bool Messenger::GetLookupGetDSInfoFromSeed(const bytes& src,
                                            bool& initialDS) {
   LOG_MARKER();
 
-  LookupGetDSInfoFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetDSInfoFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4482,7 +4920,8 @@ bool Messenger::SetLookupSetDSInfoFromSeed(
     const deque<pair<PubKey, Peer>>& dsNodes, const bool initialDS) {
   LOG_MARKER();
 
-  LookupSetDSInfoFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetDSInfoFromSeed>();
 
   DSCommitteeToProtobuf(dsNodes, *result.mutable_dscommittee());
 
@@ -4520,7 +4959,8 @@ bool Messenger::GetLookupSetDSInfoFromSeed(const bytes& src,
                                            bool& initialDS) {
   LOG_MARKER();
 
-  LookupSetDSInfoFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetDSInfoFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
   ProtobufByteArrayToSerializable(result.pubkey(), senderPubKey);
@@ -4560,7 +5000,8 @@ bool Messenger::SetLookupGetDSBlockFromSeed(bytes& dst,
                                             const uint32_t listenPort) {
   LOG_MARKER();
 
-  LookupGetDSBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetDSBlockFromSeed>();
 
   result.set_lowblocknum(lowBlockNum);
   result.set_highblocknum(highBlockNum);
@@ -4581,7 +5022,8 @@ bool Messenger::GetLookupGetDSBlockFromSeed(const bytes& src,
                                             uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetDSBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetDSBlockFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4605,7 +5047,8 @@ bool Messenger::SetLookupSetDSBlockFromSeed(bytes& dst,
                                             const vector<DSBlock>& dsBlocks) {
   LOG_MARKER();
 
-  LookupSetDSBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetDSBlockFromSeed>();
 
   result.set_lowblocknum(lowBlockNum);
   result.set_highblocknum(highBlockNum);
@@ -4646,7 +5089,8 @@ bool Messenger::GetLookupSetDSBlockFromSeed(
     uint64_t& highBlockNum, PubKey& lookupPubKey, vector<DSBlock>& dsBlocks) {
   LOG_MARKER();
 
-  LookupSetDSBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetDSBlockFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4693,7 +5137,8 @@ bool Messenger::SetLookupGetTxBlockFromSeed(bytes& dst,
                                             const uint32_t listenPort) {
   LOG_MARKER();
 
-  LookupGetTxBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetTxBlockFromSeed>();
 
   result.set_lowblocknum(lowBlockNum);
   result.set_highblocknum(highBlockNum);
@@ -4714,7 +5159,8 @@ bool Messenger::GetLookupGetTxBlockFromSeed(const bytes& src,
                                             uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetTxBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetTxBlockFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4738,7 +5184,8 @@ bool Messenger::SetLookupSetTxBlockFromSeed(bytes& dst,
                                             const vector<TxBlock>& txBlocks) {
   LOG_MARKER();
 
-  LookupSetTxBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetTxBlockFromSeed>();
 
   result.set_lowblocknum(lowBlockNum);
   result.set_highblocknum(highBlockNum);
@@ -4779,7 +5226,8 @@ bool Messenger::GetLookupSetTxBlockFromSeed(
     uint64_t& highBlockNum, PubKey& lookupPubKey, vector<TxBlock>& txBlocks) {
   LOG_MARKER();
 
-  LookupSetTxBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetTxBlockFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4825,7 +5273,8 @@ bool Messenger::SetLookupGetStateDeltaFromSeed(bytes& dst,
                                                const uint32_t listenPort) {
   LOG_MARKER();
 
-  LookupGetStateDeltaFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetStateDeltaFromSeed>();
 
   result.set_blocknum(blockNum);
   result.set_listenport(listenPort);
@@ -4844,7 +5293,8 @@ bool Messenger::GetLookupGetStateDeltaFromSeed(const bytes& src,
                                                uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetStateDeltaFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetStateDeltaFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4866,7 +5316,8 @@ bool Messenger::SetLookupSetStateDeltaFromSeed(bytes& dst,
                                                const bytes& stateDelta) {
   LOG_MARKER();
 
-  LookupSetStateDeltaFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetStateDeltaFromSeed>();
 
   result.set_blocknum(blockNum);
 
@@ -4899,7 +5350,8 @@ bool Messenger::GetLookupSetStateDeltaFromSeed(const bytes& src,
                                                bytes& stateDelta) {
   LOG_MARKER();
 
-  LookupSetStateDeltaFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetStateDeltaFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4932,7 +5384,8 @@ bool Messenger::SetLookupGetTxBodyFromSeed(bytes& dst,
                                            const uint32_t listenPort) {
   LOG_MARKER();
 
-  LookupGetTxBodyFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetTxBodyFromSeed>();
 
   result.set_txhash(txHash.data(), txHash.size());
   result.set_listenport(listenPort);
@@ -4951,7 +5404,8 @@ bool Messenger::GetLookupGetTxBodyFromSeed(const bytes& src,
                                            uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetTxBodyFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetTxBodyFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -4974,7 +5428,8 @@ bool Messenger::SetLookupSetTxBodyFromSeed(
     const TransactionWithReceipt& txBody) {
   LOG_MARKER();
 
-  LookupSetTxBodyFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetTxBodyFromSeed>();
 
   result.set_txhash(txHash.data(), txHash.size);
   SerializableToProtobufByteArray(txBody, *result.mutable_txbody());
@@ -4993,7 +5448,8 @@ bool Messenger::GetLookupSetTxBodyFromSeed(const bytes& src,
                                            TransactionWithReceipt& txBody) {
   LOG_MARKER();
 
-  LookupSetTxBodyFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetTxBodyFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5016,7 +5472,8 @@ bool Messenger::SetLookupSetNetworkIDFromSeed(bytes& dst,
                                               const string& networkID) {
   LOG_MARKER();
 
-  LookupSetNetworkIDFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetNetworkIDFromSeed>();
 
   result.set_networkid(networkID);
 
@@ -5033,7 +5490,8 @@ bool Messenger::GetLookupSetNetworkIDFromSeed(const bytes& src,
                                               string& networkID) {
   LOG_MARKER();
 
-  LookupSetNetworkIDFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetNetworkIDFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5051,7 +5509,8 @@ bool Messenger::SetLookupGetStateFromSeed(bytes& dst, const unsigned int offset,
                                           const uint32_t listenPort) {
   LOG_MARKER();
 
-  LookupGetStateFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetStateFromSeed>();
 
   result.set_listenport(listenPort);
 
@@ -5068,7 +5527,8 @@ bool Messenger::GetLookupGetStateFromSeed(const bytes& src,
                                           uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetStateFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetStateFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5087,7 +5547,8 @@ bool Messenger::SetLookupSetStateFromSeed(bytes& dst, const unsigned int offset,
                                           const AccountStore& accountStore) {
   LOG_MARKER();
 
-  LookupSetStateFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetStateFromSeed>();
 
   SerializableToProtobufByteArray(lookupKey.second, *result.mutable_pubkey());
   Signature signature;
@@ -5122,7 +5583,8 @@ bool Messenger::GetLookupSetStateFromSeed(const bytes& src,
                                           bytes& accountStoreBytes) {
   LOG_MARKER();
 
-  LookupSetStateFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetStateFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5151,7 +5613,8 @@ bool Messenger::SetLookupSetLookupOffline(bytes& dst, const unsigned int offset,
                                           const uint32_t listenPort) {
   LOG_MARKER();
 
-  LookupSetLookupOffline result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetLookupOffline>();
 
   result.set_listenport(listenPort);
 
@@ -5168,7 +5631,8 @@ bool Messenger::GetLookupSetLookupOffline(const bytes& src,
                                           uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupSetLookupOffline result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetLookupOffline>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5187,7 +5651,8 @@ bool Messenger::SetLookupSetLookupOnline(bytes& dst, const unsigned int offset,
                                          const PubKey& pubKey) {
   LOG_MARKER();
 
-  LookupSetLookupOnline result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetLookupOnline>();
 
   result.set_listenport(listenPort);
   SerializableToProtobufByteArray(pubKey, *result.mutable_pubkey());
@@ -5205,7 +5670,8 @@ bool Messenger::GetLookupSetLookupOnline(const bytes& src,
                                          uint32_t& listenPort, PubKey& pubKey) {
   LOG_MARKER();
 
-  LookupSetLookupOnline result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetLookupOnline>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5226,7 +5692,8 @@ bool Messenger::SetLookupGetOfflineLookups(bytes& dst,
                                            const uint32_t listenPort) {
   LOG_MARKER();
 
-  LookupGetOfflineLookups result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetOfflineLookups>();
 
   result.set_listenport(listenPort);
 
@@ -5243,7 +5710,8 @@ bool Messenger::GetLookupGetOfflineLookups(const bytes& src,
                                            uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetOfflineLookups result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetOfflineLookups>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5263,7 +5731,8 @@ bool Messenger::SetLookupSetOfflineLookups(bytes& dst,
                                            const vector<Peer>& nodes) {
   LOG_MARKER();
 
-  LookupSetOfflineLookups result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetOfflineLookups>();
 
   for (const auto& node : nodes) {
     SerializableToProtobufByteArray(node, *result.add_nodes());
@@ -5301,7 +5770,8 @@ bool Messenger::GetLookupSetOfflineLookups(const bytes& src,
                                            vector<Peer>& nodes) {
   LOG_MARKER();
 
-  LookupSetOfflineLookups result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetOfflineLookups>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5341,7 +5811,8 @@ bool Messenger::SetLookupGetStartPoWFromSeed(bytes& dst,
                                              const uint32_t listenPort) {
   LOG_MARKER();
 
-  LookupGetStartPoWFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetStartPoWFromSeed>();
 
   result.set_listenport(listenPort);
 
@@ -5358,7 +5829,8 @@ bool Messenger::GetLookupGetStartPoWFromSeed(const bytes& src,
                                              uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetStartPoWFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetStartPoWFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5378,7 +5850,8 @@ bool Messenger::SetLookupSetStartPoWFromSeed(bytes& dst,
                                              const PairOfKey& lookupKey) {
   LOG_MARKER();
 
-  LookupSetStartPoWFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetStartPoWFromSeed>();
 
   result.set_blocknumber(blockNumber);
   SerializableToProtobufByteArray(lookupKey.second, *result.mutable_pubkey());
@@ -5408,7 +5881,8 @@ bool Messenger::GetLookupSetStartPoWFromSeed(const bytes& src,
                                              PubKey& lookupPubKey) {
   LOG_MARKER();
 
-  LookupSetStartPoWFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetStartPoWFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5437,7 +5911,8 @@ bool Messenger::SetLookupGetShardsFromSeed(bytes& dst,
                                            const uint32_t listenPort) {
   LOG_MARKER();
 
-  LookupGetShardsFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetShardsFromSeed>();
 
   result.set_listenport(listenPort);
 
@@ -5454,7 +5929,8 @@ bool Messenger::GetLookupGetShardsFromSeed(const bytes& src,
                                            uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetShardsFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetShardsFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5474,7 +5950,8 @@ bool Messenger::SetLookupSetShardsFromSeed(bytes& dst,
                                            const DequeOfShard& shards) {
   LOG_MARKER();
 
-  LookupSetShardsFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetShardsFromSeed>();
 
   ShardingStructureToProtobuf(shards, *result.mutable_sharding());
 
@@ -5508,7 +5985,8 @@ bool Messenger::GetLookupSetShardsFromSeed(const bytes& src,
                                            DequeOfShard& shards) {
   LOG_MARKER();
 
-  LookupSetShardsFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetShardsFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5544,7 +6022,8 @@ bool Messenger::SetLookupGetMicroBlockFromLookup(
     const vector<BlockHash>& microBlockHashes, uint32_t portNo) {
   LOG_MARKER();
 
-  LookupGetMicroBlockFromLookup result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetMicroBlockFromLookup>();
 
   result.set_portno(portNo);
 
@@ -5565,7 +6044,8 @@ bool Messenger::GetLookupGetMicroBlockFromLookup(
     vector<BlockHash>& microBlockHashes, uint32_t& portNo) {
   LOG_MARKER();
 
-  LookupGetMicroBlockFromLookup result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetMicroBlockFromLookup>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5592,7 +6072,8 @@ bool Messenger::SetLookupSetMicroBlockFromLookup(
     bytes& dst, const unsigned int offset, const PairOfKey& lookupKey,
     const vector<MicroBlock>& mbs) {
   LOG_MARKER();
-  LookupSetMicroBlockFromLookup result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetMicroBlockFromLookup>();
 
   for (const auto& mb : mbs) {
     MicroBlockToProtobuf(mb, *result.add_microblocks());
@@ -5629,7 +6110,8 @@ bool Messenger::GetLookupSetMicroBlockFromLookup(const bytes& src,
                                                  PubKey& lookupPubKey,
                                                  vector<MicroBlock>& mbs) {
   LOG_MARKER();
-  LookupSetMicroBlockFromLookup result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetMicroBlockFromLookup>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5672,7 +6154,8 @@ bool Messenger::SetLookupGetTxnsFromLookup(bytes& dst,
                                            uint32_t portNo) {
   LOG_MARKER();
 
-  LookupGetTxnsFromLookup result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetTxnsFromLookup>();
 
   result.set_portno(portNo);
 
@@ -5694,7 +6177,8 @@ bool Messenger::GetLookupGetTxnsFromLookup(const bytes& src,
                                            uint32_t& portNo) {
   LOG_MARKER();
 
-  LookupGetTxnsFromLookup result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetTxnsFromLookup>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5719,7 +6203,8 @@ bool Messenger::SetLookupSetTxnsFromLookup(
     const vector<TransactionWithReceipt>& txns) {
   LOG_MARKER();
 
-  LookupSetTxnsFromLookup result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetTxnsFromLookup>();
 
   for (auto const& txn : txns) {
     SerializableToProtobufByteArray(txn, *result.add_transactions());
@@ -5756,7 +6241,8 @@ bool Messenger::GetLookupSetTxnsFromLookup(
     vector<TransactionWithReceipt>& txns) {
   LOG_MARKER();
 
-  LookupSetTxnsFromLookup result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetTxnsFromLookup>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5795,7 +6281,8 @@ bool Messenger::SetLookupGetDirectoryBlocksFromSeed(bytes& dst,
                                                     const unsigned int offset,
                                                     const uint32_t portNo,
                                                     const uint64_t& indexNum) {
-  LookupGetDirectoryBlocksFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetDirectoryBlocksFromSeed>();
 
   result.set_portno(portNo);
   result.set_indexnum(indexNum);
@@ -5813,7 +6300,8 @@ bool Messenger::GetLookupGetDirectoryBlocksFromSeed(const bytes& src,
                                                     const unsigned int offset,
                                                     uint32_t& portNo,
                                                     uint64_t& indexNum) {
-  LookupGetDirectoryBlocksFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetDirectoryBlocksFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5836,7 +6324,8 @@ bool Messenger::SetLookupSetDirectoryBlocksFromSeed(
         boost::variant<DSBlock, VCBlock, FallbackBlockWShardingStructure>>&
         directoryBlocks,
     const uint64_t& indexNum) {
-  LookupSetDirectoryBlocksFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetDirectoryBlocksFromSeed>();
 
   result.set_indexnum(indexNum);
 
@@ -5872,7 +6361,8 @@ bool Messenger::GetLookupSetDirectoryBlocksFromSeed(
     vector<boost::variant<DSBlock, VCBlock, FallbackBlockWShardingStructure>>&
         directoryBlocks,
     uint64_t& indexNum) {
-  LookupSetDirectoryBlocksFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupSetDirectoryBlocksFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -5944,7 +6434,8 @@ bool Messenger::SetConsensusCommit(
     const pair<PrivKey, PubKey>& backupKey) {
   LOG_MARKER();
 
-  ConsensusCommit result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusCommit>();
 
   result.mutable_consensusinfo()->set_consensusid(consensusID);
   result.mutable_consensusinfo()->set_blocknumber(blockNumber);
@@ -5964,8 +6455,8 @@ bool Messenger::SetConsensusCommit(
     return false;
   }
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -5992,7 +6483,8 @@ bool Messenger::GetConsensusCommit(
     const deque<pair<PubKey, Peer>>& committeeKeys) {
   LOG_MARKER();
 
-  ConsensusCommit result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusCommit>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -6055,8 +6547,8 @@ bool Messenger::GetConsensusCommit(
   ProtobufByteArrayToSerializable(result.consensusinfo().commitpointhash(),
                                   commitPointHash);
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -6079,7 +6571,8 @@ bool Messenger::SetConsensusChallenge(
     const pair<PrivKey, PubKey>& leaderKey) {
   LOG_MARKER();
 
-  ConsensusChallenge result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusChallenge>();
 
   result.mutable_consensusinfo()->set_consensusid(consensusID);
   result.mutable_consensusinfo()->set_blocknumber(blockNumber);
@@ -6100,8 +6593,8 @@ bool Messenger::SetConsensusChallenge(
     return false;
   }
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -6128,7 +6621,8 @@ bool Messenger::GetConsensusChallenge(
     PubKey& aggregatedKey, Challenge& challenge, const PubKey& leaderKey) {
   LOG_MARKER();
 
-  ConsensusChallenge result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusChallenge>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -6192,8 +6686,8 @@ bool Messenger::GetConsensusChallenge(
   ProtobufByteArrayToSerializable(result.consensusinfo().challenge(),
                                   challenge);
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -6214,7 +6708,8 @@ bool Messenger::SetConsensusResponse(
     const pair<PrivKey, PubKey>& backupKey) {
   LOG_MARKER();
 
-  ConsensusResponse result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusResponse>();
 
   result.mutable_consensusinfo()->set_consensusid(consensusID);
   result.mutable_consensusinfo()->set_blocknumber(blockNumber);
@@ -6230,8 +6725,8 @@ bool Messenger::SetConsensusResponse(
     return false;
   }
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -6258,7 +6753,8 @@ bool Messenger::GetConsensusResponse(
     const deque<pair<PubKey, Peer>>& committeeKeys) {
   LOG_MARKER();
 
-  ConsensusResponse result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusResponse>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -6320,8 +6816,8 @@ bool Messenger::GetConsensusResponse(
 
   ProtobufByteArrayToSerializable(result.consensusinfo().response(), response);
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -6343,7 +6839,8 @@ bool Messenger::SetConsensusCollectiveSig(
     const pair<PrivKey, PubKey>& leaderKey) {
   LOG_MARKER();
 
-  ConsensusCollectiveSig result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusCollectiveSig>();
 
   result.mutable_consensusinfo()->set_consensusid(consensusID);
   result.mutable_consensusinfo()->set_blocknumber(blockNumber);
@@ -6361,8 +6858,8 @@ bool Messenger::SetConsensusCollectiveSig(
     return false;
   }
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -6388,7 +6885,8 @@ bool Messenger::GetConsensusCollectiveSig(
     vector<bool>& bitmap, Signature& collectiveSig, const PubKey& leaderKey) {
   LOG_MARKER();
 
-  ConsensusCollectiveSig result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusCollectiveSig>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -6451,8 +6949,8 @@ bool Messenger::GetConsensusCollectiveSig(
     bitmap.emplace_back(i);
   }
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -6472,7 +6970,8 @@ bool Messenger::SetConsensusCommitFailure(
     const bytes& errorMsg, const pair<PrivKey, PubKey>& backupKey) {
   LOG_MARKER();
 
-  ConsensusCommitFailure result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusCommitFailure>();
 
   result.mutable_consensusinfo()->set_consensusid(consensusID);
   result.mutable_consensusinfo()->set_blocknumber(blockNumber);
@@ -6487,8 +6986,8 @@ bool Messenger::SetConsensusCommitFailure(
     return false;
   }
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -6514,7 +7013,8 @@ bool Messenger::GetConsensusCommitFailure(
     bytes& errorMsg, const deque<pair<PubKey, Peer>>& committeeKeys) {
   LOG_MARKER();
 
-  ConsensusCommitFailure result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusCommitFailure>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -6576,8 +7076,8 @@ bool Messenger::GetConsensusCommitFailure(
   copy(result.consensusinfo().errormsg().begin(),
        result.consensusinfo().errormsg().end(), errorMsg.begin());
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -6598,7 +7098,8 @@ bool Messenger::SetConsensusConsensusFailure(
     const pair<PrivKey, PubKey>& leaderKey) {
   LOG_MARKER();
 
-  ConsensusConsensusFailure result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusConsensusFailure>();
 
   result.mutable_consensusinfo()->set_consensusid(consensusID);
   result.mutable_consensusinfo()->set_blocknumber(blockNumber);
@@ -6612,8 +7113,8 @@ bool Messenger::SetConsensusConsensusFailure(
     return false;
   }
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -6639,7 +7140,8 @@ bool Messenger::GetConsensusConsensusFailure(
     const PubKey& leaderKey) {
   LOG_MARKER();
 
-  ConsensusConsensusFailure result;
+  MessageArena arena;
+  auto& result = arena.Create<ConsensusConsensusFailure>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -6695,8 +7197,8 @@ bool Messenger::GetConsensusConsensusFailure(
     return false;
   }
 
-  bytes tmp(result.consensusinfo().ByteSize());
-  result.consensusinfo().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.consensusinfo(), tmp, 0);
 
   Signature signature;
 
@@ -6720,7 +7222,8 @@ bool Messenger::SetLookupGetDSTxBlockFromSeed(
     const uint64_t txHighBlockNum, const uint32_t listenPort) {
   LOG_MARKER();
 
-  LookupGetDSTxBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetDSTxBlockFromSeed>();
 
   result.set_dslowblocknum(dsLowBlockNum);
   result.set_dshighblocknum(dsHighBlockNum);
@@ -6742,7 +7245,8 @@ bool Messenger::GetLookupGetDSTxBlockFromSeed(
     uint32_t& listenPort) {
   LOG_MARKER();
 
-  LookupGetDSTxBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<LookupGetDSTxBlockFromSeed>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -6767,7 +7271,8 @@ bool Messenger::SetVCNodeSetDSTxBlockFromSeed(bytes& dst,
                                               const vector<TxBlock>& txBlocks) {
   LOG_MARKER();
 
-  VCNodeSetDSTxBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<VCNodeSetDSTxBlockFromSeed>();
 
   for (const auto& dsblock : DSBlocks) {
     DSBlockToProtobuf(dsblock, *result.add_dsblocks());
@@ -6819,7 +7324,8 @@ bool Messenger::GetVCNodeSetDSTxBlockFromSeed(const bytes& src,
                                               vector<TxBlock>& txBlocks,
                                               PubKey& lookupPubKey) {
   LOG_MARKER();
-  VCNodeSetDSTxBlockFromSeed result;
+  MessageArena arena;
+  auto& result = arena.Create<VCNodeSetDSTxBlockFromSeed>();
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
   if (!result.IsInitialized()) {
@@ -6878,7 +7384,8 @@ bool Messenger::SetDSLookupNewDSGuardNetworkInfo(
     const Peer& dsGuardNewNetworkInfo, const uint64_t timestamp,
     const pair<PrivKey, PubKey>& dsguardkey) {
   LOG_MARKER();
-  DSLookupSetDSGuardNetworkInfoUpdate result;
+  MessageArena arena;
+  auto& result = arena.Create<DSLookupSetDSGuardNetworkInfoUpdate>();
 
   result.mutable_data()->set_dsepochnumber(dsEpochNumber);
   SerializableToProtobufByteArray(
@@ -6888,8 +7395,8 @@ bool Messenger::SetDSLookupNewDSGuardNetworkInfo(
   result.mutable_data()->set_timestamp(timestamp);
 
   if (result.data().IsInitialized()) {
-    bytes tmp(result.data().ByteSize());
-    result.data().SerializeToArray(tmp.data(), tmp.size());
+    bytes tmp;
+    SerializeToArray(result.data(), tmp, 0);
 
     Signature signature;
     if (!Schnorr::GetInstance().Sign(tmp, dsguardkey.first, dsguardkey.second,
@@ -6919,7 +7426,8 @@ bool Messenger::GetDSLookupNewDSGuardNetworkInfo(
     Peer& dsGuardNewNetworkInfo, uint64_t& timestamp, PubKey& dsGuardPubkey) {
   LOG_MARKER();
 
-  DSLookupSetDSGuardNetworkInfoUpdate result;
+  MessageArena arena;
+  auto& result = arena.Create<DSLookupSetDSGuardNetworkInfoUpdate>();
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
   if (!result.IsInitialized() || !result.data().IsInitialized()) {
@@ -6934,8 +7442,8 @@ bool Messenger::GetDSLookupNewDSGuardNetworkInfo(
   ProtobufByteArrayToSerializable(result.signature(), signature);
 
   // Check signature
-  bytes tmp(result.data().ByteSize());
-  result.data().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.data(), tmp, 0);
   if (!Schnorr::GetInstance().Verify(tmp, 0, tmp.size(), signature,
                                      dsGuardPubkey)) {
     LOG_GENERAL(WARNING,
@@ -6956,7 +7464,8 @@ bool Messenger::SetLookupGetNewDSGuardNetworkInfoFromLookup(
     const uint64_t dsEpochNumber) {
   LOG_MARKER();
 
-  NodeGetGuardNodeNetworkInfoUpdate result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeGetGuardNodeNetworkInfoUpdate>();
   result.set_portno(portNo);
   result.set_dsepochnumber(dsEpochNumber);
 
@@ -6974,7 +7483,8 @@ bool Messenger::GetLookupGetNewDSGuardNetworkInfoFromLookup(
     uint64_t& dsEpochNumber) {
   LOG_MARKER();
 
-  NodeGetGuardNodeNetworkInfoUpdate result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeGetGuardNodeNetworkInfoUpdate>();
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
   if (!result.IsInitialized()) {
@@ -6995,7 +7505,8 @@ bool Messenger::SetNodeSetNewDSGuardNetworkInfo(
     const vector<DSGuardUpdateStruct>& vecOfDSGuardUpdateStruct,
     const PairOfKey& lookupKey) {
   LOG_MARKER();
-  NodeSetGuardNodeNetworkInfoUpdate result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeSetGuardNodeNetworkInfoUpdate>();
 
   for (const auto& dsguardupdate : vecOfDSGuardUpdateStruct) {
     ProtoDSGuardUpdateStruct* proto_DSGuardUpdateStruct =
@@ -7009,8 +7520,8 @@ bool Messenger::SetNodeSetNewDSGuardNetworkInfo(
   }
 
   if (result.data().IsInitialized()) {
-    bytes tmp(result.data().ByteSize());
-    result.data().SerializeToArray(tmp.data(), tmp.size());
+    bytes tmp;
+    SerializeToArray(result.data(), tmp, 0);
 
     Signature signature;
     if (!Schnorr::GetInstance().Sign(tmp, lookupKey.first, lookupKey.second,
@@ -7041,7 +7552,8 @@ bool Messenger::SetNodeGetNewDSGuardNetworkInfo(
     vector<DSGuardUpdateStruct>& vecOfDSGuardUpdateStruct,
     PubKey& lookupPubKey) {
   LOG_MARKER();
-  NodeSetGuardNodeNetworkInfoUpdate result;
+  MessageArena arena;
+  auto& result = arena.Create<NodeSetGuardNodeNetworkInfoUpdate>();
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
   if (!result.IsInitialized()) {
@@ -7053,8 +7565,8 @@ bool Messenger::SetNodeGetNewDSGuardNetworkInfo(
   ProtobufByteArrayToSerializable(result.lookuppubkey(), lookupPubKey);
   Signature signature;
   ProtobufByteArrayToSerializable(result.signature(), signature);
-  bytes tmp(result.data().ByteSize());
-  result.data().SerializeToArray(tmp.data(), tmp.size());
+  bytes tmp;
+  SerializeToArray(result.data(), tmp, 0);
   if (!Schnorr::GetInstance().Verify(tmp, 0, tmp.size(), signature,
                                      lookupPubKey)) {
     LOG_GENERAL(WARNING, "NodeSetGuardNodeNetworkInfoUpdate signature wrong.");
@@ -7080,7 +7592,8 @@ bool Messenger::SetSeedNodeHistoricalDB(
     bytes& dst, const unsigned int offset,
     const pair<PrivKey, PubKey>& archivalKeys, const uint32_t code,
     const string& path) {
-  SeedSetHistoricalDB result;
+  MessageArena arena;
+  auto& result = arena.Create<SeedSetHistoricalDB>();
 
   result.mutable_data()->set_code(code);
   result.mutable_data()->set_path(path);
@@ -7088,8 +7601,8 @@ bool Messenger::SetSeedNodeHistoricalDB(
                                   *result.mutable_pubkey());
 
   if (result.data().IsInitialized()) {
-    vector<unsigned char> tmp(result.data().ByteSize());
-    result.data().SerializeToArray(tmp.data(), tmp.size());
+    vector<unsigned char> tmp;
+    SerializeToArray(result.data(), tmp, 0);
     Signature signature;
     if (!Schnorr::GetInstance().Sign(tmp, archivalKeys.first,
                                      archivalKeys.second, signature)) {
@@ -7112,7 +7625,8 @@ bool Messenger::GetSeedNodeHistoricalDB(const bytes& src,
                                         const unsigned int offset,
                                         PubKey& archivalPubKey, uint32_t& code,
                                         string& path) {
-  SeedSetHistoricalDB result;
+  MessageArena arena;
+  auto& result = arena.Create<SeedSetHistoricalDB>();
 
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
@@ -7124,8 +7638,8 @@ bool Messenger::GetSeedNodeHistoricalDB(const bytes& src,
   ProtobufByteArrayToSerializable(result.pubkey(), archivalPubKey);
   Signature signature;
   ProtobufByteArrayToSerializable(result.signature(), signature);
-  vector<unsigned char> tmp(result.data().ByteSize());
-  result.data().SerializeToArray(tmp.data(), tmp.size());
+  vector<unsigned char> tmp;
+  SerializeToArray(result.data(), tmp, 0);
   if (!Schnorr::GetInstance().Verify(tmp, 0, tmp.size(), signature,
                                      archivalPubKey)) {
     LOG_GENERAL(WARNING, "SeedSetHistoricalDB signature wrong.");
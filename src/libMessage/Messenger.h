@@ -77,9 +77,11 @@ class Messenger {
                               AccountStore& accountStore);
 
   // These are called by AccountStore class
-  static bool SetAccountStoreDelta(bytes& dst, const unsigned int offset,
-                                   AccountStoreTemp& accountStoreTemp,
-                                   AccountStore& accountStore);
+  // Decoding accepts every version, encoding defaults to STATE_DELTA_VERSION
+  static bool SetAccountStoreDelta(
+      bytes& dst, const unsigned int offset,
+      AccountStoreTemp& accountStoreTemp, AccountStore& accountStore,
+      const unsigned int version = STATE_DELTA_VERSION);
   static bool GetAccountStoreDelta(const bytes& src, const unsigned int offset,
                                    AccountStore& accountStore,
                                    const bool reversible);
@@ -311,6 +313,13 @@ class Messenger {
                                        std::vector<VCBlock>& vcBlocks,
                                        DequeOfShard& shards);
 
+  /// Decodes only the shard ID and DS block, skipping the VC blocks and
+  /// sharding structure, so a stale DS block can be dropped cheaply
+  static bool GetNodeVCDSBlocksMessageHeader(const bytes& src,
+                                             const unsigned int offset,
+                                             uint32_t& shardId,
+                                             DSBlock& dsBlock);
+
   static bool SetNodeFinalBlock(bytes& dst, const unsigned int offset,
                                 const uint64_t dsBlockNumber,
                                 const uint32_t consensusID,
@@ -321,6 +330,14 @@ class Messenger {
                                 uint64_t& dsBlockNumber, uint32_t& consensusID,
                                 TxBlock& txBlock, bytes& stateDelta);
 
+  /// Decodes the Tx block header, hash and co-signatures of a final block,
+  /// skipping the microblock infos and state delta. The returned block has no
+  /// microblock infos.
+  static bool GetNodeFinalBlockHeader(const bytes& src,
+                                      const unsigned int offset,
+                                      uint64_t& dsBlockNumber,
+                                      uint32_t& consensusID, TxBlock& txBlock);
+
   static bool SetNodeVCBlock(bytes& dst, const unsigned int offset,
                              const VCBlock& vcBlock);
   static bool GetNodeVCBlock(const bytes& src, const unsigned int offset,
@@ -26,12 +26,13 @@ using namespace ZilliqaMessage;
 template <class T = ProtoSWInfo>
 bool SerializeToArray(const T& protoMessage, bytes& dst,
                       const unsigned int offset) {
-  if ((offset + protoMessage.ByteSize()) > dst.size()) {
-    dst.resize(offset + protoMessage.ByteSize());
+  const size_t size = protoMessage.ByteSizeLong();
+  if ((offset + size) > dst.size()) {
+    dst.resize(offset + size);
   }
 
-  return protoMessage.SerializeToArray(dst.data() + offset,
-                                       protoMessage.ByteSize());
+  protoMessage.SerializeWithCachedSizesToArray(dst.data() + offset);
+  return true;
 }
 
 void SWInfoToProtobuf(const SWInfo& swInfo, ProtoSWInfo& protoSWInfo) {
@@ -31,25 +31,21 @@ Blacklist& Blacklist::GetInstance() {
 
 /// P2PComm may use this function
 bool Blacklist::Exist(const boost::multiprecision::uint128_t& ip) {
-  lock_guard<mutex> g(m_mutexBlacklistIP);
-  return (m_blacklistIP.end() != m_blacklistIP.find(ip));
+  return m_blacklistIP.Contains(ip);
 }
 
 /// Reputation Manager may use this function
 void Blacklist::Add(const boost::multiprecision::uint128_t& ip) {
-  lock_guard<mutex> g(m_mutexBlacklistIP);
-  m_blacklistIP.emplace(ip, true);
+  m_blacklistIP.Insert(ip, true);
 }
 
 /// Reputation Manager may use this function
 void Blacklist::Remove(const boost::multiprecision::uint128_t& ip) {
-  lock_guard<mutex> g(m_mutexBlacklistIP);
-  m_blacklistIP.erase(ip);
+  m_blacklistIP.Erase(ip);
 }
 
 /// Reputation Manager may use this function
 void Blacklist::Clear() {
-  lock_guard<mutex> g(m_mutexBlacklistIP);
-  m_blacklistIP.clear();
+  m_blacklistIP.Clear();
   LOG_GENERAL(INFO, "[blacklist] Blacklist cleared.");
 }
@@ -18,21 +18,7 @@
 #ifndef __BLACKLIST_H__
 #define __BLACKLIST_H__
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#include <boost/multiprecision/cpp_int.hpp>
-#pragma GCC diagnostic pop
-#include <mutex>
-#include <unordered_map>
-
-namespace std {
-template <>
-struct hash<boost::multiprecision::uint128_t> {
-  std::size_t operator()(const boost::multiprecision::uint128_t& key) const {
-    return std::hash<std::string>()(key.convert_to<std::string>());
-  }
-};
-}  // namespace std
+#include "IPTable.h"
 
 class Blacklist {
   Blacklist();
@@ -42,13 +28,12 @@ class Blacklist {
   Blacklist(Blacklist const&) = delete;
   void operator=(Blacklist const&) = delete;
 
-  std::mutex m_mutexBlacklistIP;
-  std::unordered_map<boost::multiprecision::uint128_t, bool> m_blacklistIP;
+  IPTable<bool> m_blacklistIP;
 
  public:
   static Blacklist& GetInstance();
 
-  /// P2PComm may use this function
+  /// P2PComm may use this function. Takes no lock.
   bool Exist(const boost::multiprecision::uint128_t& ip);
 
   /// P2PComm may use this function to blacklist certain non responding nodes
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "BroadcastDedupSet.h"
+
+using namespace std;
+
+BroadcastDedupSet::BroadcastDedupSet(size_t capacity,
+                                     const chrono::seconds& expiry,
+                                     const chrono::seconds& tick)
+    : m_start(Clock::now()),
+      m_tick(max(tick, chrono::seconds(1))),
+      m_expiryTicks(max<uint32_t>(
+          1, (expiry + m_tick - Clock::duration(1)) / m_tick)) {
+  // Round the bucket count up to a power of two so a mask selects the bucket
+  size_t buckets = 1;
+  while (buckets * WAYS < capacity) {
+    buckets <<= 1;
+  }
+  m_bucketMask = buckets - 1;
+  m_slots.resize(buckets * WAYS, Slot{{}, 0, 0});
+}
+
+uint32_t BroadcastDedupSet::GetTick(const Clock::time_point& now) const {
+  return static_cast<uint32_t>((now - m_start) / m_tick);
+}
+
+size_t BroadcastDedupSet::GetBucket(const unsigned char* digest) const {
+  // Digests are uniformly distributed, so their leading bytes are a good hash
+  uint64_t key = 0;
+  memcpy(&key, digest, sizeof(key));
+  return key & m_bucketMask;
+}
+
+bool BroadcastDedupSet::IsLive(const Slot& slot, uint32_t tick) const {
+  return slot.tick != 0 && tick - (slot.tick - 1) < m_expiryTicks;
+}
+
+bool BroadcastDedupSet::Insert(const unsigned char* digest,
+                               const Clock::time_point& now) {
+  const uint32_t tick = GetTick(now);
+  const size_t bucket = GetBucket(digest);
+  Slot* slots = &m_slots[bucket * WAYS];
+
+  const unsigned int stripe = bucket % LOCK_STRIPES;
+  lock_guard<mutex> g(m_locks[stripe]);
+
+  const uint32_t sequence = m_sequences[stripe];
+  Slot* victim = nullptr;
+  bool victimLive = true;
+  for (unsigned int i = 0; i < WAYS; i++) {
+    Slot& slot = slots[i];
+    if (!IsLive(slot, tick)) {
+      if (victimLive) {
+        victim = &slot;
+        victimLive = false;
+      }
+      continue;
+    }
+    if (memcmp(slot.digest.data(), digest, DIGEST_SIZE) == 0) {
+      return false;
+    }
+    // Unsigned differences keep the age order correct across wrap-around
+    if (victimLive && (victim == nullptr || sequence - slot.sequence >
+                                                sequence - victim->sequence)) {
+      victim = &slot;
+    }
+  }
+
+  if (victimLive) {
+    m_evictions++;
+  }
+  memcpy(victim->digest.data(), digest, DIGEST_SIZE);
+  victim->tick = tick + 1;
+  victim->sequence = m_sequences[stripe]++;
+  return true;
+}
+
+bool BroadcastDedupSet::Contains(const unsigned char* digest,
+                                 const Clock::time_point& now) {
+  const uint32_t tick = GetTick(now);
+  const size_t bucket = GetBucket(digest);
+  const Slot* slots = &m_slots[bucket * WAYS];
+
+  lock_guard<mutex> g(m_locks[bucket % LOCK_STRIPES]);
+
+  for (unsigned int i = 0; i < WAYS; i++) {
+    if (IsLive(slots[i], tick) &&
+        memcmp(slots[i].digest.data(), digest, DIGEST_SIZE) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
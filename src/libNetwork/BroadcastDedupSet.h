@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __BROADCASTDEDUPSET_H__
+#define __BROADCASTDEDUPSET_H__
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+/// Fixed-memory set of recently seen 32-byte message digests.
+///
+/// Entries live in a set-associative table: a digest maps to one bucket of
+/// WAYS slots and is compared only against those. Time is divided into ticks
+/// (a timing wheel without a sweeper); each slot remembers the tick it was
+/// written in, and slots older than the expiry window are simply reused. When
+/// a bucket is full of live entries the oldest one is evicted. All storage is
+/// allocated up front, and buckets are guarded by striped locks.
+class BroadcastDedupSet {
+ public:
+  static const unsigned int DIGEST_SIZE = 32;
+  using Clock = std::chrono::steady_clock;
+
+  BroadcastDedupSet(size_t capacity, const std::chrono::seconds& expiry,
+                    const std::chrono::seconds& tick);
+
+  /// Records the digest. Returns false if it was already present.
+  bool Insert(const unsigned char* digest,
+              const Clock::time_point& now = Clock::now());
+
+  /// Returns true if the digest was recorded within the expiry window.
+  bool Contains(const unsigned char* digest,
+                const Clock::time_point& now = Clock::now());
+
+  /// Number of live entries that were pushed out by newer ones
+  uint64_t GetEvictions() const { return m_evictions; }
+
+ private:
+  static const unsigned int WAYS = 8;
+  static const unsigned int LOCK_STRIPES = 256;
+
+  struct Slot {
+    std::array<unsigned char, DIGEST_SIZE> digest;
+    uint32_t tick;      // tick of insertion plus one, zero when unused
+    uint32_t sequence;  // insertion order within the lock stripe
+  };
+
+  std::vector<Slot> m_slots;
+  size_t m_bucketMask;
+  const Clock::time_point m_start;
+  const Clock::duration m_tick;
+  const uint32_t m_expiryTicks;
+  std::array<std::mutex, LOCK_STRIPES> m_locks;
+  std::array<uint32_t, LOCK_STRIPES> m_sequences{};
+  std::atomic<uint64_t> m_evictions{0};
+
+  uint32_t GetTick(const Clock::time_point& now) const;
+  size_t GetBucket(const unsigned char* digest) const;
+  bool IsLive(const Slot& slot, uint32_t tick) const;
+};
+
+#endif  // __BROADCASTDEDUPSET_H__
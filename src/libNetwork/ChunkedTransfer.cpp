@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "ChunkedTransfer.h"
+#include "P2PComm.h"
+#include "common/Constants.h"
+#include "libCrypto/Sha2.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+// Bound by reference by chrono::seconds
+const unsigned int ChunkedTransfer::TRANSFER_TIMEOUT_IN_SECONDS;
+
+static void WriteUint32(unsigned char* dst, uint32_t value) {
+  dst[0] = (value >> 24) & 0xFF;
+  dst[1] = (value >> 16) & 0xFF;
+  dst[2] = (value >> 8) & 0xFF;
+  dst[3] = value & 0xFF;
+}
+
+static uint32_t ReadUint32(const unsigned char* src) {
+  return (src[0] << 24) + (src[1] << 16) + (src[2] << 8) + src[3];
+}
+
+ChunkedTransfer::ChunkedTransfer() {}
+
+ChunkedTransfer::~ChunkedTransfer() {}
+
+ChunkedTransfer& ChunkedTransfer::GetInstance() {
+  static ChunkedTransfer chunkedTransfer;
+  return chunkedTransfer;
+}
+
+vector<MessageFrame> ChunkedTransfer::Split(const MessageFrame& frame) {
+  return Split(frame, CHUNKED_TRANSFER_THRESHOLD_IN_BYTES,
+               CHUNK_SIZE_IN_BYTES);
+}
+
+vector<MessageFrame> ChunkedTransfer::Split(const MessageFrame& frame,
+                                            uint32_t threshold,
+                                            uint32_t chunkSize) {
+  if (threshold == 0 || frame->size() < threshold || chunkSize == 0) {
+    return {frame};
+  }
+
+  const uint32_t total = frame->size();
+  const uint32_t numChunks = (total + chunkSize - 1) / chunkSize;
+
+  bytes chunkHashes;
+  chunkHashes.reserve(numChunks * DIGEST_LEN);
+  for (uint32_t offset = 0; offset < total; offset += chunkSize) {
+    SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+    sha256.Update(*frame, offset, min(chunkSize, total - offset));
+    const bytes hash = sha256.Finalize();
+    chunkHashes.insert(chunkHashes.end(), hash.begin(), hash.end());
+  }
+
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+  sha256.Update(chunkHashes);
+  const bytes transferId = sha256.Finalize();
+
+  vector<MessageFrame> chunks;
+  chunks.reserve(numChunks);
+  for (uint32_t index = 0; index < numChunks; index++) {
+    const uint32_t offset = index * chunkSize;
+    const uint32_t dataLen = min(chunkSize, total - offset);
+    const uint32_t length = CHUNK_HDR_LEN + dataLen;
+
+    auto chunk = make_shared<bytes>(HDR_LEN + CHUNK_HDR_LEN);
+    unsigned char* out = chunk->data();
+    out[0] = MSG_VERSION & 0xFF;
+    out[1] = START_BYTE_CHUNK;
+    WriteUint32(out + 2, length);
+    out += HDR_LEN;
+
+    memcpy(out, transferId.data(), DIGEST_LEN);
+    WriteUint32(out + DIGEST_LEN, total);
+    WriteUint32(out + DIGEST_LEN + 4, chunkSize);
+    WriteUint32(out + DIGEST_LEN + 8, offset);
+    memcpy(out + DIGEST_LEN + 12, chunkHashes.data() + index * DIGEST_LEN,
+           DIGEST_LEN);
+
+    chunk->reserve(HDR_LEN + length);
+    chunk->insert(chunk->end(), frame->begin() + offset,
+                  frame->begin() + offset + dataLen);
+    chunks.emplace_back(move(chunk));
+  }
+
+  LOG_GENERAL(INFO, "Split " << total << " byte message into " << numChunks
+                             << " chunks");
+  return chunks;
+}
+
+void ChunkedTransfer::DropStaleTransfers(const Clock::time_point& now) {
+  for (auto it = m_transfers.begin(); it != m_transfers.end();) {
+    if (now - it->second.lastUpdate >
+        chrono::seconds(TRANSFER_TIMEOUT_IN_SECONDS)) {
+      LOG_GENERAL(WARNING, "Dropping incomplete transfer of "
+                               << it->second.total << " bytes, "
+                               << it->second.numChunks -
+                                      it->second.chunks.size()
+                               << " chunks missing");
+      it = m_transfers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ChunkedTransfer::LimitPeerTransfers(
+    const boost::multiprecision::uint128_t& ip) {
+  // Keys are ordered by IP first, so a peer's transfers are adjacent
+  while (true) {
+    auto oldest = m_transfers.end();
+    unsigned int count = 0;
+    for (auto it = m_transfers.lower_bound({ip, Digest{}});
+         it != m_transfers.end() && it->first.first == ip; ++it) {
+      count++;
+      if (oldest == m_transfers.end() ||
+          it->second.lastUpdate < oldest->second.lastUpdate) {
+        oldest = it;
+      }
+    }
+
+    if (count < MAX_PENDING_TRANSFERS_PER_PEER) {
+      return;
+    }
+
+    LOG_GENERAL(WARNING, "Too many pending transfers from one peer, dropping "
+                         "one with "
+                             << oldest->second.bytesReceived
+                             << " bytes received");
+    m_transfers.erase(oldest);
+  }
+}
+
+bool ChunkedTransfer::AddChunk(const unsigned char* payload, size_t size,
+                               const Peer& from, bytes& frame) {
+  if (size <= CHUNK_HDR_LEN) {
+    LOG_GENERAL(WARNING, "Chunk too short (" << size << " bytes)");
+    return false;
+  }
+
+  TransferKey key;
+  key.first = from.m_ipAddress;
+  copy(payload, payload + DIGEST_LEN, key.second.begin());
+  const uint32_t total = ReadUint32(payload + DIGEST_LEN);
+  const uint32_t chunkSize = ReadUint32(payload + DIGEST_LEN + 4);
+  const uint32_t offset = ReadUint32(payload + DIGEST_LEN + 8);
+  Digest chunkHash;
+  copy(payload + DIGEST_LEN + 12, payload + CHUNK_HDR_LEN, chunkHash.begin());
+  const unsigned char* data = payload + CHUNK_HDR_LEN;
+  const size_t dataLen = size - CHUNK_HDR_LEN;
+
+  if (total == 0 || total > MAX_MSG_SIZE_IN_BYTES + HDR_LEN ||
+      chunkSize == 0 || offset >= total || offset % chunkSize != 0 ||
+      dataLen != min<size_t>(chunkSize, total - offset)) {
+    LOG_GENERAL(WARNING, "Invalid chunk from "
+                             << from << " (total " << total << ", chunk size "
+                             << chunkSize << ", offset " << offset
+                             << ", length " << dataLen << ")");
+    return false;
+  }
+
+  // Verify before taking the lock, chunks from other connections can be
+  // hashed in parallel
+  Chunk chunk{chunkHash, bytes(data, data + dataLen)};
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+  sha256.Update(chunk.data);
+  const bytes hash = sha256.Finalize();
+  if (!equal(hash.begin(), hash.end(), chunkHash.begin())) {
+    LOG_GENERAL(WARNING, "Chunk hash mismatch from " << from << " at offset "
+                                                      << offset);
+    return false;
+  }
+
+  const auto now = Clock::now();
+  lock_guard<mutex> g(m_mutex);
+
+  DropStaleTransfers(now);
+
+  if (find(m_completed.begin(), m_completed.end(), key) != m_completed.end()) {
+    return false;
+  }
+
+  auto it = m_transfers.find(key);
+  if (it == m_transfers.end()) {
+    LimitPeerTransfers(key.first);
+
+    // Nothing is allocated for the frame until its chunks arrive
+    Transfer transfer;
+    transfer.total = total;
+    transfer.chunkSize = chunkSize;
+    transfer.numChunks = (total + chunkSize - 1) / chunkSize;
+    transfer.bytesReceived = 0;
+    it = m_transfers.emplace(key, move(transfer)).first;
+  }
+
+  Transfer& transfer = it->second;
+  if (transfer.total != total || transfer.chunkSize != chunkSize) {
+    LOG_GENERAL(WARNING, "Chunk from " << from
+                                       << " does not match its transfer");
+    return false;
+  }
+
+  transfer.lastUpdate = now;
+  const uint32_t index = offset / chunkSize;
+  if (!transfer.chunks.emplace(index, move(chunk)).second) {
+    // Resent after a reconnect
+    return false;
+  }
+  transfer.bytesReceived += dataLen;
+
+  if (transfer.chunks.size() < transfer.numChunks) {
+    return false;
+  }
+
+  // Chunks are keyed by index, so iterating the map visits them in order
+  SHA2<HASH_TYPE::HASH_VARIANT_256> idHash;
+  for (const auto& entry : transfer.chunks) {
+    idHash.Update(bytes(entry.second.hash.begin(), entry.second.hash.end()));
+  }
+  const bytes transferId = idHash.Finalize();
+  const bool valid =
+      equal(transferId.begin(), transferId.end(), key.second.begin());
+
+  if (valid) {
+    frame.clear();
+    frame.reserve(total);
+    for (const auto& entry : transfer.chunks) {
+      frame.insert(frame.end(), entry.second.data.begin(),
+                   entry.second.data.end());
+    }
+    m_completed.emplace_back(key);
+    if (m_completed.size() > MAX_COMPLETED_TRANSFERS) {
+      m_completed.pop_front();
+    }
+  } else {
+    LOG_GENERAL(WARNING, "Transfer ID mismatch from " << from);
+  }
+
+  m_transfers.erase(it);
+  return valid;
+}
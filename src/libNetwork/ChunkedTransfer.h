@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CHUNKEDTRANSFER_H__
+#define __CHUNKEDTRANSFER_H__
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Peer.h"
+#include "PeerSendQueue.h"
+#include "common/BaseType.h"
+
+/// Splits large frames into chunks that are verified independently, and
+/// reassembles them on the receiving side.
+///
+/// Chunk payload:
+/// <32-byte transfer ID> <4-byte frame length> <4-byte chunk size>
+/// <4-byte offset> <32-byte chunk hash> <chunk data>
+///
+/// The chunk hash is the SHA-256 of the chunk data, and the transfer ID is the
+/// SHA-256 of all chunk hashes in order, so every chunk is bound to its
+/// transfer. Chunks may arrive out of order, over several connections and more
+/// than once, which lets a sender resume an interrupted transfer by resending
+/// only the chunks that were in flight.
+class ChunkedTransfer {
+ public:
+  static const unsigned int DIGEST_LEN = 32;
+  static const unsigned int CHUNK_HDR_LEN = DIGEST_LEN + 4 + 4 + 4 + DIGEST_LEN;
+
+  static ChunkedTransfer& GetInstance();
+
+  /// Returns the frame itself if it is below CHUNKED_TRANSFER_THRESHOLD or
+  /// chunking is disabled, otherwise the chunk frames that carry it
+  static std::vector<MessageFrame> Split(const MessageFrame& frame);
+
+  /// Same as above with an explicit threshold and chunk size, a threshold of
+  /// 0 disables chunking
+  static std::vector<MessageFrame> Split(const MessageFrame& frame,
+                                         uint32_t threshold,
+                                         uint32_t chunkSize);
+
+  /// Adds a received chunk payload. Returns true and moves the original frame
+  /// into frame once every chunk has arrived and the transfer is verified.
+  bool AddChunk(const unsigned char* payload, size_t size, const Peer& from,
+                bytes& frame);
+
+ private:
+  using Digest = std::array<unsigned char, DIGEST_LEN>;
+  using TransferKey = std::pair<boost::multiprecision::uint128_t, Digest>;
+  using Clock = std::chrono::steady_clock;
+
+  /// Transfers are dropped if no chunk arrives for this long
+  static const unsigned int TRANSFER_TIMEOUT_IN_SECONDS = 60;
+  /// Partial transfers kept per peer, that peer's oldest is dropped beyond
+  /// this so one peer cannot evict the transfers of others
+  static const unsigned int MAX_PENDING_TRANSFERS_PER_PEER = 2;
+  /// Recently completed transfers whose late duplicate chunks are ignored
+  static const unsigned int MAX_COMPLETED_TRANSFERS = 64;
+
+  struct Chunk {
+    Digest hash;
+    bytes data;
+  };
+
+  /// Only the chunks received so far are held, so memory grows with the
+  /// data a peer actually sends rather than the size it claims
+  struct Transfer {
+    uint32_t total;
+    uint32_t chunkSize;
+    uint32_t numChunks;
+    std::map<uint32_t, Chunk> chunks;
+    size_t bytesReceived;
+    Clock::time_point lastUpdate;
+  };
+
+  std::mutex m_mutex;
+  std::map<TransferKey, Transfer> m_transfers;
+  std::deque<TransferKey> m_completed;
+
+  ChunkedTransfer();
+  ~ChunkedTransfer();
+
+  // Singleton should not implement these
+  ChunkedTransfer(ChunkedTransfer const&) = delete;
+  void operator=(ChunkedTransfer const&) = delete;
+
+  void DropStaleTransfers(const Clock::time_point& now);
+  void LimitPeerTransfers(const boost::multiprecision::uint128_t& ip);
+};
+
+#endif  // __CHUNKEDTRANSFER_H__
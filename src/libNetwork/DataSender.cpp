@@ -73,6 +73,36 @@ SendDataToLookupFunc SendDataToLookupFuncDefault =
   SendDataToLookupNodesDefault(lookups, message);
 };
 
+SendDataToShardFunc SendDataToShardFuncErasureCoded =
+    [](const bytes& message, const DequeOfShard& shards,
+       const unsigned int& my_shards_lo,
+       const unsigned int& my_shards_hi) mutable -> void {
+  if (LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING,
+                "SendDataToShardFuncErasureCoded not expected to be called "
+                "from LookUp node.");
+    return;
+  }
+
+  auto p = shards.begin();
+  advance(p, my_shards_lo);
+
+  for (unsigned int i = my_shards_lo; i < my_shards_hi; i++, p++) {
+    vector<Peer> receivers;
+    for (const auto& kv : *p) {
+      receivers.emplace_back(std::get<SHARD_NODE_PEER>(kv));
+    }
+    P2PComm::GetInstance().SendErasureCodedMessage(receivers, message);
+  }
+};
+
+const SendDataToShardFunc& GetSendDataToShardFuncForDS() {
+  static const SendDataToShardFunc none = nullptr;
+  return (ERASURE_CODED_DISSEMINATION && !BROADCAST_GOSSIP_MODE)
+             ? SendDataToShardFuncErasureCoded
+             : none;
+}
+
 DataSender::DataSender() {}
 
 DataSender::~DataSender() {}
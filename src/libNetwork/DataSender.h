@@ -39,6 +39,15 @@ extern SendDataToLookupFunc SendDataToLookupFuncDefault;
 
 extern SendDataToShardFunc SendDataToShardFuncDefault;
 
+/// Sends the message to every member of each target shard as erasure-coded
+/// chunks. Shard members only relay chunks from the current DS committee.
+extern SendDataToShardFunc SendDataToShardFuncErasureCoded;
+
+/// Shard send function for the blocks the DS committee sends to the shards
+/// it already announced: erasure-coded if ERASURE_CODED_DISSEMINATION is set
+/// and gossip is off, otherwise empty so SendDataToOthers uses the default.
+const SendDataToShardFunc& GetSendDataToShardFuncForDS();
+
 class DataSender : Singleton<DataSender> {
   DataSender();
   ~DataSender();
@@ -0,0 +1,328 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "ErasureCodedTransfer.h"
+#include "common/Constants.h"
+#include "libCrypto/Sha2.h"
+#include "libUtils/Logger.h"
+#include "libUtils/ReedSolomon.h"
+
+using namespace std;
+
+// Bound by reference by chrono::seconds
+const unsigned int ErasureCodedTransfer::TRANSFER_TIMEOUT_IN_SECONDS;
+
+ErasureCodedTransfer::ErasureCodedTransfer() {}
+
+ErasureCodedTransfer::~ErasureCodedTransfer() {}
+
+ErasureCodedTransfer& ErasureCodedTransfer::GetInstance() {
+  static ErasureCodedTransfer erasureCodedTransfer;
+  return erasureCodedTransfer;
+}
+
+unsigned int ErasureCodedTransfer::ProofDepth(unsigned int chunks) {
+  unsigned int depth = 0;
+  while ((1u << depth) < chunks) {
+    depth++;
+  }
+  return depth;
+}
+
+ErasureCodedTransfer::Digest ErasureCodedTransfer::LeafHash(
+    const unsigned char* header, const unsigned char* data, size_t dataLen) {
+  // The relay flag is changed by forwarders and the root cannot cover itself
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+  sha256.Update(header, DIGEST_LEN);
+  sha256.Update(header + RELAY_FLAG_OFFSET + 1,
+                MERKLE_ROOT_OFFSET - RELAY_FLAG_OFFSET - 1);
+  sha256.Update(data, dataLen);
+  const bytes hash = sha256.Finalize();
+
+  Digest digest;
+  copy(hash.begin(), hash.end(), digest.begin());
+  return digest;
+}
+
+ErasureCodedTransfer::Digest ErasureCodedTransfer::NodeHash(
+    const Digest& left, const Digest& right) {
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+  sha256.Update(left.data(), left.size());
+  sha256.Update(right.data(), right.size());
+  const bytes hash = sha256.Finalize();
+
+  Digest digest;
+  copy(hash.begin(), hash.end(), digest.begin());
+  return digest;
+}
+
+bool ErasureCodedTransfer::Encode(const bytes& message, size_t receivers,
+                                  vector<bytes>& chunks) {
+  if (message.empty() || receivers == 0) {
+    LOG_GENERAL(WARNING, "Nothing to encode");
+    return false;
+  }
+
+  // Chunk indexes are a single byte
+  const unsigned int total =
+      min<size_t>(receivers, ReedSolomon::MAX_SHARDS - 1);
+  const unsigned int dataChunks = total - total / 3;
+  const ReedSolomon codec(dataChunks, total - dataChunks);
+
+  vector<bytes> shards;
+  if (!codec.Encode(message, shards)) {
+    return false;
+  }
+
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+  sha256.Update(message);
+  const bytes hash = sha256.Finalize();
+
+  const uint32_t length = message.size();
+  const unsigned int depth = ProofDepth(total);
+  chunks.clear();
+  chunks.reserve(total);
+
+  // Tree levels from the leaves up, missing leaves are all zero
+  vector<vector<Digest>> levels(depth + 1);
+  levels[0].resize(1u << depth, Digest{});
+  for (unsigned int index = 0; index < total; index++) {
+    bytes chunk(CHUNK_HDR_LEN + depth * DIGEST_LEN);
+    copy(hash.begin(), hash.end(), chunk.begin());
+    chunk[RELAY_FLAG_OFFSET] = 1;
+    chunk[DIGEST_LEN + 1] = dataChunks;
+    chunk[DIGEST_LEN + 2] = total - dataChunks;
+    chunk[DIGEST_LEN + 3] = index;
+    chunk[DIGEST_LEN + 4] = (length >> 24) & 0xFF;
+    chunk[DIGEST_LEN + 5] = (length >> 16) & 0xFF;
+    chunk[DIGEST_LEN + 6] = (length >> 8) & 0xFF;
+    chunk[DIGEST_LEN + 7] = length & 0xFF;
+    levels[0][index] =
+        LeafHash(chunk.data(), shards[index].data(), shards[index].size());
+    chunk.insert(chunk.end(), shards[index].begin(), shards[index].end());
+    chunks.emplace_back(move(chunk));
+  }
+
+  for (unsigned int level = 1; level <= depth; level++) {
+    const vector<Digest>& below = levels[level - 1];
+    for (unsigned int i = 0; i < below.size(); i += 2) {
+      levels[level].emplace_back(NodeHash(below[i], below[i + 1]));
+    }
+  }
+
+  const Digest& root = levels[depth][0];
+  for (unsigned int index = 0; index < total; index++) {
+    unsigned char* out = chunks[index].data() + MERKLE_ROOT_OFFSET;
+    out = copy(root.begin(), root.end(), out);
+    for (unsigned int level = 0; level < depth; level++) {
+      const Digest& sibling = levels[level][(index >> level) ^ 1];
+      out = copy(sibling.begin(), sibling.end(), out);
+    }
+  }
+
+  return true;
+}
+
+void ErasureCodedTransfer::DropStaleTransfers(const Clock::time_point& now) {
+  for (auto it = m_transfers.begin(); it != m_transfers.end();) {
+    if (now - it->second.lastUpdate >
+        chrono::seconds(TRANSFER_TIMEOUT_IN_SECONDS)) {
+      LOG_GENERAL(WARNING, "Dropping incomplete transfer of "
+                               << it->second.length << " bytes with "
+                               << it->second.chunks.size() << " of "
+                               << it->second.dataChunks << " chunks");
+      it = m_transfers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ErasureCodedTransfer::LimitPeerTransfers(
+    const boost::multiprecision::uint128_t& ip) {
+  while (true) {
+    auto oldest = m_transfers.end();
+    unsigned int count = 0;
+    for (auto it = m_transfers.begin(); it != m_transfers.end(); ++it) {
+      if (it->second.shared || it->second.owner != ip) {
+        continue;
+      }
+      count++;
+      if (oldest == m_transfers.end() ||
+          it->second.lastUpdate < oldest->second.lastUpdate) {
+        oldest = it;
+      }
+    }
+
+    if (count < MAX_PENDING_TRANSFERS_PER_PEER) {
+      return;
+    }
+
+    LOG_GENERAL(WARNING, "Too many pending transfers from one peer, dropping "
+                         "one of "
+                             << oldest->second.length << " bytes");
+    m_transfers.erase(oldest);
+  }
+}
+
+bool ErasureCodedTransfer::AddChunk(const unsigned char* payload, size_t size,
+                                    const Peer& from, bool& relay,
+                                    bytes& message) {
+  relay = false;
+
+  if (size <= CHUNK_HDR_LEN) {
+    LOG_GENERAL(WARNING, "Chunk too short (" << size << " bytes)");
+    return false;
+  }
+
+  TransferKey key;
+  Digest& hash = key.first;
+  copy(payload, payload + DIGEST_LEN, hash.begin());
+  copy(payload + MERKLE_ROOT_OFFSET, payload + CHUNK_HDR_LEN,
+       key.second.begin());
+  const bool relayFlag = payload[RELAY_FLAG_OFFSET] != 0;
+  const unsigned int dataChunks = payload[DIGEST_LEN + 1];
+  const unsigned int parityChunks = payload[DIGEST_LEN + 2];
+  const unsigned int index = payload[DIGEST_LEN + 3];
+  const uint32_t length = (payload[DIGEST_LEN + 4] << 24) +
+                          (payload[DIGEST_LEN + 5] << 16) +
+                          (payload[DIGEST_LEN + 6] << 8) +
+                          payload[DIGEST_LEN + 7];
+  const unsigned int depth = ProofDepth(dataChunks + parityChunks);
+  const size_t proofLen = depth * DIGEST_LEN;
+  const size_t chunkLen =
+      size > CHUNK_HDR_LEN + proofLen ? size - CHUNK_HDR_LEN - proofLen : 0;
+
+  if (dataChunks == 0 || dataChunks + parityChunks >= ReedSolomon::MAX_SHARDS ||
+      index >= dataChunks + parityChunks || length == 0 ||
+      length > MAX_MSG_SIZE_IN_BYTES ||
+      chunkLen != (length + dataChunks - 1) / dataChunks) {
+    LOG_GENERAL(WARNING, "Invalid chunk from "
+                             << from << " (" << dataChunks << "+"
+                             << parityChunks << " chunks, index " << index
+                             << ", length " << length << ", chunk length "
+                             << chunkLen << ")");
+    return false;
+  }
+
+  // Verify the proof before taking the lock, chunks from other connections
+  // can be hashed in parallel
+  const unsigned char* proof = payload + CHUNK_HDR_LEN;
+  const unsigned char* data = proof + proofLen;
+  Digest node = LeafHash(payload, data, chunkLen);
+  for (unsigned int level = 0; level < depth; level++) {
+    Digest sibling;
+    copy(proof + level * DIGEST_LEN, proof + (level + 1) * DIGEST_LEN,
+         sibling.begin());
+    node = (index >> level) & 1 ? NodeHash(sibling, node)
+                                : NodeHash(node, sibling);
+  }
+  if (node != key.second) {
+    LOG_GENERAL(WARNING, "Chunk " << index << " from " << from
+                                  << " does not match its Merkle root");
+    return false;
+  }
+
+  const auto now = Clock::now();
+  map<unsigned int, bytes> chunks;
+  {
+    lock_guard<mutex> g(m_mutex);
+
+    DropStaleTransfers(now);
+
+    if (find(m_completed.begin(), m_completed.end(), hash) !=
+        m_completed.end()) {
+      // Peers get enough chunks from the ones that completed the transfer
+      return false;
+    }
+
+    auto it = m_transfers.find(key);
+    if (it == m_transfers.end()) {
+      LimitPeerTransfers(from.m_ipAddress);
+
+      // The root commits to the parameters, so every chunk under it agrees
+      // with the first one
+      it = m_transfers
+               .emplace(key, Transfer{dataChunks, parityChunks, length, {},
+                                      now, from.m_ipAddress, false})
+               .first;
+    }
+
+    Transfer& transfer = it->second;
+    transfer.lastUpdate = now;
+    if (!transfer.chunks.emplace(index, bytes(data, data + chunkLen)).second) {
+      return false;
+    }
+    relay = relayFlag;
+
+    // A verified chunk from a second peer means it is no longer one peer's
+    // transfer to lose
+    if (transfer.owner != from.m_ipAddress) {
+      transfer.shared = true;
+    }
+
+    if (transfer.chunks.size() < dataChunks) {
+      return false;
+    }
+
+    // Decode outside the lock. The message is only marked completed once it
+    // decodes to its hash, so a sender that committed to bad chunks cannot
+    // block an honest transfer of the same message.
+    chunks = move(transfer.chunks);
+    m_transfers.erase(it);
+  }
+
+  if (!ReedSolomon(dataChunks, parityChunks).Decode(chunks, length,
+                                                     message)) {
+    LOG_GENERAL(WARNING, "Failed to decode message, last chunk from " << from);
+    message.clear();
+    return false;
+  }
+
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+  sha256.Update(message);
+  const bytes decodedHash = sha256.Finalize();
+  if (!equal(decodedHash.begin(), decodedHash.end(), hash.begin())) {
+    LOG_GENERAL(WARNING, "Decoded message hash mismatch, last chunk from "
+                             << from);
+    message.clear();
+    return false;
+  }
+
+  lock_guard<mutex> g(m_mutex);
+  if (find(m_completed.begin(), m_completed.end(), hash) !=
+      m_completed.end()) {
+    // Rebuilt concurrently from another set of chunks
+    message.clear();
+    return false;
+  }
+  m_completed.emplace_back(hash);
+  if (m_completed.size() > MAX_COMPLETED_TRANSFERS) {
+    m_completed.pop_front();
+  }
+
+  // Transfers of the same message under other roots are no longer needed
+  for (auto it = m_transfers.lower_bound({hash, Digest{}});
+       it != m_transfers.end() && it->first.first == hash;) {
+    it = m_transfers.erase(it);
+  }
+
+  return true;
+}
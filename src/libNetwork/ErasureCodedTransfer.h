@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ERASURECODEDTRANSFER_H__
+#define __ERASURECODEDTRANSFER_H__
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "Peer.h"
+#include "common/BaseType.h"
+
+/// Erasure-coded dissemination of a message to a group of receivers.
+///
+/// The sender Reed-Solomon encodes the message into one chunk per receiver
+/// (up to 255 distinct chunks), of which any two thirds rebuild it. Every
+/// receiver forwards the chunk it got from the sender to the rest of its
+/// group once, so the sender's egress is about 1.5 times the message instead
+/// of the message times the group size, and up to a third of the chunks may
+/// be lost.
+///
+/// Chunk payload:
+/// <32-byte message hash> <1-byte relay flag> <1-byte data chunks>
+/// <1-byte parity chunks> <1-byte index> <4-byte message length>
+/// <32-byte Merkle root> <32-byte proof hashes> <chunk data>
+///
+/// The Merkle tree is built over the chunks, each leaf being the SHA-256 of
+/// the chunk header without the relay flag and root, followed by the chunk
+/// data. The proof holds the sibling hashes from the leaf up to the root, one
+/// per tree level, so a chunk is verified on its own before it is kept and a
+/// forged chunk cannot spoil the honest ones.
+class ErasureCodedTransfer {
+ public:
+  static const unsigned int DIGEST_LEN = 32;
+  static const unsigned int RELAY_FLAG_OFFSET = DIGEST_LEN;
+  static const unsigned int MERKLE_ROOT_OFFSET = DIGEST_LEN + 4 + 4;
+  /// Fixed part of the header, the proof that follows it varies in length
+  static const unsigned int CHUNK_HDR_LEN = MERKLE_ROOT_OFFSET + DIGEST_LEN;
+
+  static ErasureCodedTransfer& GetInstance();
+
+  /// Encodes the message into chunk payloads for the given number of
+  /// receivers, receiver i is sent chunk i % chunks.size()
+  static bool Encode(const bytes& message, size_t receivers,
+                     std::vector<bytes>& chunks);
+
+  /// Adds a received chunk payload. relay is set for the first copy of a
+  /// chunk that the receiver should forward. Returns true and sets message
+  /// once enough chunks have arrived and the message hash is verified.
+  bool AddChunk(const unsigned char* payload, size_t size, const Peer& from,
+                bool& relay, bytes& message);
+
+ private:
+  using Digest = std::array<unsigned char, DIGEST_LEN>;
+  /// Message hash and Merkle root, so chunks under a forged root are kept
+  /// apart from the honest ones for the same message
+  using TransferKey = std::pair<Digest, Digest>;
+  using Clock = std::chrono::steady_clock;
+
+  /// Transfers are dropped if no chunk arrives for this long
+  static const unsigned int TRANSFER_TIMEOUT_IN_SECONDS = 60;
+  /// Partial transfers started by one peer that no other peer has added to
+  /// yet. That peer's oldest is dropped beyond this, so one peer cannot evict
+  /// the transfers of others.
+  static const unsigned int MAX_PENDING_TRANSFERS_PER_PEER = 4;
+  /// Recently completed transfers whose remaining chunks are ignored
+  static const unsigned int MAX_COMPLETED_TRANSFERS = 64;
+
+  struct Transfer {
+    unsigned int dataChunks;
+    unsigned int parityChunks;
+    uint32_t length;
+    std::map<unsigned int, bytes> chunks;
+    Clock::time_point lastUpdate;
+    /// Peer that sent the first chunk, until a chunk arrives from another
+    boost::multiprecision::uint128_t owner;
+    bool shared;
+  };
+
+  std::mutex m_mutex;
+  std::map<TransferKey, Transfer> m_transfers;
+  std::deque<Digest> m_completed;
+
+  ErasureCodedTransfer();
+  ~ErasureCodedTransfer();
+
+  // Singleton should not implement these
+  ErasureCodedTransfer(ErasureCodedTransfer const&) = delete;
+  void operator=(ErasureCodedTransfer const&) = delete;
+
+  void DropStaleTransfers(const Clock::time_point& now);
+  void LimitPeerTransfers(const boost::multiprecision::uint128_t& ip);
+
+  /// Number of proof hashes for a tree over the given number of chunks
+  static unsigned int ProofDepth(unsigned int chunks);
+  static Digest LeafHash(const unsigned char* header,
+                         const unsigned char* data, size_t dataLen);
+  static Digest NodeHash(const Digest& left, const Digest& right);
+};
+
+#endif  // __ERASURECODEDTRANSFER_H__
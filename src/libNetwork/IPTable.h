@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __IPTABLE_H__
+#define __IPTABLE_H__
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include <boost/multiprecision/cpp_int.hpp>
+#pragma GCC diagnostic pop
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+/// Open-addressing hash table keyed by IP address, for lookups on the
+/// connection accept path.
+///
+/// Keys are stored as two native 64-bit words and probed linearly, so a
+/// lookup neither allocates nor converts the address. Reads take no lock:
+/// they run under a sequence counter and retry if a write overlapped them.
+/// Writes are serialized by a mutex. Arrays replaced on growth are kept until
+/// the table is destroyed, so a reader that raced a growth never touches
+/// freed memory; growth doubles the size, so this at most doubles the
+/// footprint.
+template <class V>
+class IPTable {
+  static_assert(std::is_trivially_copyable<V>::value,
+                "IPTable values are read without a lock");
+
+  struct Slot {
+    std::atomic<uint64_t> hi{0};
+    std::atomic<uint64_t> lo{0};
+    std::atomic<V> value{V()};
+    std::atomic<bool> used{false};
+  };
+
+  struct Slots {
+    size_t mask;
+    std::unique_ptr<Slot[]> slot;
+
+    explicit Slots(size_t capacity)
+        : mask(capacity - 1), slot(new Slot[capacity]) {}
+  };
+
+  static const size_t INITIAL_CAPACITY = 64;
+
+  std::atomic<uint64_t> m_sequence{0};
+  std::atomic<Slots*> m_slots{nullptr};
+  std::vector<std::unique_ptr<Slots>> m_arrays;
+  size_t m_size{0};
+  mutable std::mutex m_mutexWrite;
+
+  static void Split(const boost::multiprecision::uint128_t& ip, uint64_t& hi,
+                    uint64_t& lo) {
+    lo = static_cast<uint64_t>(ip & 0xFFFFFFFFFFFFFFFFULL);
+    hi = static_cast<uint64_t>(ip >> 64);
+  }
+
+  static size_t Hash(uint64_t hi, uint64_t lo) {
+    uint64_t h = (lo ^ (hi * 0x9E3779B97F4A7C15ULL)) * 0xBF58476D1CE4E5B9ULL;
+    return static_cast<size_t>(h ^ (h >> 31));
+  }
+
+  /// Index of the key or of the empty slot that ends its probe sequence
+  static size_t Probe(const Slots& slots, uint64_t hi, uint64_t lo) {
+    size_t i = Hash(hi, lo) & slots.mask;
+    for (size_t n = 0; n <= slots.mask; n++, i = (i + 1) & slots.mask) {
+      const Slot& s = slots.slot[i];
+      if (!s.used.load(std::memory_order_relaxed) ||
+          (s.hi.load(std::memory_order_relaxed) == hi &&
+           s.lo.load(std::memory_order_relaxed) == lo)) {
+        return i;
+      }
+    }
+    return i;
+  }
+
+  static void Copy(Slot& to, const Slot& from) {
+    to.hi.store(from.hi.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+    to.lo.store(from.lo.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+    to.value.store(from.value.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+    to.used.store(true, std::memory_order_relaxed);
+  }
+
+  // Writers call these between BeginWrite and EndWrite
+  void BeginWrite() {
+    m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  void EndWrite() {
+    m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_release);
+  }
+
+  /// Keeps the load factor at or below one half
+  void Reserve(size_t size) {
+    Slots* current = m_slots.load(std::memory_order_relaxed);
+    if (2 * size <= current->mask + 1) {
+      return;
+    }
+
+    std::unique_ptr<Slots> grown(new Slots(2 * (current->mask + 1)));
+    for (size_t i = 0; i <= current->mask; i++) {
+      const Slot& s = current->slot[i];
+      if (s.used.load(std::memory_order_relaxed)) {
+        Copy(grown->slot[Probe(*grown, s.hi.load(std::memory_order_relaxed),
+                               s.lo.load(std::memory_order_relaxed))],
+             s);
+      }
+    }
+    m_slots.store(grown.get(), std::memory_order_release);
+    m_arrays.emplace_back(std::move(grown));
+  }
+
+  template <class Read>
+  void ReadConsistent(Read read) const {
+    while (true) {
+      const uint64_t before = m_sequence.load(std::memory_order_acquire);
+      if (before & 1) {
+        continue;
+      }
+      read(*m_slots.load(std::memory_order_acquire));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (m_sequence.load(std::memory_order_relaxed) == before) {
+        return;
+      }
+    }
+  }
+
+ public:
+  IPTable() {
+    m_arrays.emplace_back(new Slots(INITIAL_CAPACITY));
+    m_slots.store(m_arrays.back().get(), std::memory_order_release);
+  }
+
+  // Should not implement these
+  IPTable(IPTable const&) = delete;
+  void operator=(IPTable const&) = delete;
+
+  /// Lock-free. Returns true and sets value if ip is in the table.
+  bool Find(const boost::multiprecision::uint128_t& ip, V& value) const {
+    uint64_t hi, lo;
+    Split(ip, hi, lo);
+
+    bool found = false;
+    ReadConsistent([&](const Slots& slots) {
+      const Slot& s = slots.slot[Probe(slots, hi, lo)];
+      found = s.used.load(std::memory_order_relaxed);
+      if (found) {
+        value = s.value.load(std::memory_order_relaxed);
+      }
+    });
+    return found;
+  }
+
+  /// Lock-free
+  bool Contains(const boost::multiprecision::uint128_t& ip) const {
+    V value;
+    return Find(ip, value);
+  }
+
+  /// Adds ip with value unless it is already there. Returns true if added.
+  bool Insert(const boost::multiprecision::uint128_t& ip, const V& value) {
+    std::lock_guard<std::mutex> g(m_mutexWrite);
+    if (Contains(ip)) {
+      return false;
+    }
+    SetInternal(ip, value);
+    return true;
+  }
+
+  /// Adds ip or replaces its value
+  void Set(const boost::multiprecision::uint128_t& ip, const V& value) {
+    std::lock_guard<std::mutex> g(m_mutexWrite);
+    SetInternal(ip, value);
+  }
+
+  /// Returns true if ip was in the table
+  bool Erase(const boost::multiprecision::uint128_t& ip) {
+    uint64_t hi, lo;
+    Split(ip, hi, lo);
+
+    std::lock_guard<std::mutex> g(m_mutexWrite);
+    Slots& slots = *m_slots.load(std::memory_order_relaxed);
+    size_t i = Probe(slots, hi, lo);
+    if (!slots.slot[i].used.load(std::memory_order_relaxed)) {
+      return false;
+    }
+
+    BeginWrite();
+    slots.slot[i].used.store(false, std::memory_order_relaxed);
+
+    // Shift back later entries of the probe run so that no lookup stops at
+    // the slot just freed
+    for (size_t j = (i + 1) & slots.mask;
+         slots.slot[j].used.load(std::memory_order_relaxed);
+         j = (j + 1) & slots.mask) {
+      const size_t home =
+          Hash(slots.slot[j].hi.load(std::memory_order_relaxed),
+               slots.slot[j].lo.load(std::memory_order_relaxed)) &
+          slots.mask;
+      if (((j - home) & slots.mask) >= ((j - i) & slots.mask)) {
+        Copy(slots.slot[i], slots.slot[j]);
+        slots.slot[j].used.store(false, std::memory_order_relaxed);
+        i = j;
+      }
+    }
+    m_size--;
+    EndWrite();
+    return true;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> g(m_mutexWrite);
+    Slots& slots = *m_slots.load(std::memory_order_relaxed);
+    BeginWrite();
+    for (size_t i = 0; i <= slots.mask; i++) {
+      slots.slot[i].used.store(false, std::memory_order_relaxed);
+    }
+    m_size = 0;
+    EndWrite();
+  }
+
+  std::vector<boost::multiprecision::uint128_t> Keys() const {
+    std::lock_guard<std::mutex> g(m_mutexWrite);
+    const Slots& slots = *m_slots.load(std::memory_order_relaxed);
+
+    std::vector<boost::multiprecision::uint128_t> keys;
+    keys.reserve(m_size);
+    for (size_t i = 0; i <= slots.mask; i++) {
+      const Slot& s = slots.slot[i];
+      if (s.used.load(std::memory_order_relaxed)) {
+        boost::multiprecision::uint128_t ip =
+            s.hi.load(std::memory_order_relaxed);
+        ip <<= 64;
+        ip |= s.lo.load(std::memory_order_relaxed);
+        keys.emplace_back(ip);
+      }
+    }
+    return keys;
+  }
+
+  size_t Size() const {
+    std::lock_guard<std::mutex> g(m_mutexWrite);
+    return m_size;
+  }
+
+ private:
+  /// Caller holds m_mutexWrite
+  void SetInternal(const boost::multiprecision::uint128_t& ip,
+                   const V& value) {
+    uint64_t hi, lo;
+    Split(ip, hi, lo);
+
+    BeginWrite();
+    Reserve(m_size + 1);
+    Slots& slots = *m_slots.load(std::memory_order_relaxed);
+    Slot& s = slots.slot[Probe(slots, hi, lo)];
+    if (!s.used.load(std::memory_order_relaxed)) {
+      s.hi.store(hi, std::memory_order_relaxed);
+      s.lo.store(lo, std::memory_order_relaxed);
+      s.used.store(true, std::memory_order_relaxed);
+      m_size++;
+    }
+    s.value.store(value, std::memory_order_relaxed);
+    EndWrite();
+  }
+};
+
+#endif  // __IPTABLE_H__
@@ -34,7 +34,10 @@
 #include <memory>
 
 #include "Blacklist.h"
+#include "ChunkedTransfer.h"
+#include "ErasureCodedTransfer.h"
 #include "P2PComm.h"
+#include "P2PCompression.h"
 #include "PeerStore.h"
 #include "common/Messages.h"
 #include "libCrypto/Sha2.h"
@@ -50,6 +53,10 @@ using namespace boost::multiprecision;
 const unsigned char START_BYTE_NORMAL = 0x11;
 const unsigned char START_BYTE_BROADCAST = 0x22;
 const unsigned char START_BYTE_GOSSIP = 0x33;
+const unsigned char START_BYTE_NORMAL_COMPRESSED = 0x44;
+const unsigned char START_BYTE_BROADCAST_COMPRESSED = 0x55;
+const unsigned char START_BYTE_CHUNK = 0x66;
+const unsigned char START_BYTE_ERASURE_CODED = 0x77;
 const unsigned int HDR_LEN = 6;
 const unsigned int HASH_LEN = 32;
 const unsigned int GOSSIP_MSGTYPE_LEN = 1;
@@ -59,13 +66,6 @@ const unsigned int GOSSIP_SNDR_LISTNR_PORT_LEN = 4;
 P2PComm::Dispatcher P2PComm::m_dispatcher;
 P2PComm::BroadcastListFunc P2PComm::m_broadcast_list_retriever;
 
-/// Comparison operator for ordering the list of message hashes.
-struct hash_compare {
-  bool operator()(const bytes& l, const bytes& r) {
-    return equal(l.begin(), l.end(), r.begin(), r.end());
-  }
-};
-
 static void close_socket(int* cli_sock) {
   if (cli_sock != NULL) {
     shutdown(*cli_sock, SHUT_RDWR);
@@ -73,48 +73,15 @@ static void close_socket(int* cli_sock) {
   }
 }
 
-static bool comparePairSecond(
-    const pair<bytes, chrono::time_point<chrono::system_clock>>& a,
-    const pair<bytes, chrono::time_point<chrono::system_clock>>& b) {
-  return a.second < b.second;
-}
-
-P2PComm::P2PComm() : m_sendQueue(SENDQUEUE_SIZE) {
-  auto func = [this]() -> void {
-    bytes emptyHash;
-
-    while (true) {
-      this_thread::sleep_for(chrono::seconds(BROADCAST_INTERVAL));
-      lock(m_broadcastToRemoveMutex, m_broadcastHashesMutex);
-      lock_guard<mutex> g(m_broadcastToRemoveMutex, adopt_lock);
-      lock_guard<mutex> g2(m_broadcastHashesMutex, adopt_lock);
-
-      if (m_broadcastToRemove.empty() ||
-          m_broadcastToRemove.front().second >
-              chrono::system_clock::now() - chrono::seconds(BROADCAST_EXPIRY)) {
-        continue;
-      }
-
-      auto up = upper_bound(
-          m_broadcastToRemove.begin(), m_broadcastToRemove.end(),
-          make_pair(emptyHash, chrono::system_clock::now() -
-                                   chrono::seconds(BROADCAST_EXPIRY)),
-          comparePairSecond);
-
-      for (auto it = m_broadcastToRemove.begin(); it != up; ++it) {
-        m_broadcastHashes.erase(it->first);
-      }
-
-      m_broadcastToRemove.erase(m_broadcastToRemove.begin(), up);
-    }
-  };
-
-  DetachedFunction(1, func);
-}
+P2PComm::P2PComm()
+    : m_broadcastHashes(BROADCAST_DEDUP_CAPACITY,
+                        chrono::seconds(BROADCAST_EXPIRY),
+                        chrono::seconds(BROADCAST_INTERVAL)),
+      m_sendQueue(SENDQUEUE_SIZE) {}
 
 P2PComm::~P2PComm() {
   SendJob* job = NULL;
-  while (m_sendQueue.pop(job)) {
+  while (m_sendQueue.TryPop(job)) {
     delete job;
   }
 }
@@ -166,11 +133,66 @@ uint32_t SendJob::writeMsg(const void* buf, int cli_sock, const Peer& from,
   return written_length;
 }
 
-bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& message,
-                                    unsigned char start_byte,
-                                    const bytes& msg_hash) {
+MessageFrame SendJob::MakeFrame(const bytes& message, unsigned char startbyte,
+                               const bytes& hash) {
+  // Transmission format:
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x11 - start byte
+  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
+  // <message>
+
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x22 - start byte (broadcast)
+  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + message
+  // <32-byte hash> <message>
+
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x33 - start byte (report)
+  // 0x00 0x00 0x00 0x01 - 4-byte length of message
+  // 0x00
+
+  // 0x44 / 0x55 - same as 0x11 / 0x22, with the message snappy-compressed
+  bytes compressed;
+  const bool isCompressed =
+      (startbyte == START_BYTE_NORMAL || startbyte == START_BYTE_BROADCAST) &&
+      P2PCompression::GetInstance().Compress(message, compressed);
+  const bytes& payload = isCompressed ? compressed : message;
+
+  if (isCompressed) {
+    startbyte = (startbyte == START_BYTE_NORMAL)
+                    ? START_BYTE_NORMAL_COMPRESSED
+                    : START_BYTE_BROADCAST_COMPRESSED;
+  }
+
+  const bool isBroadcast = (startbyte == START_BYTE_BROADCAST ||
+                            startbyte == START_BYTE_BROADCAST_COMPRESSED);
+
+  uint32_t length = payload.size();
+
+  if (isBroadcast) {
+    length += HASH_LEN;
+  }
+
+  auto frame = make_shared<bytes>();
+  frame->reserve(HDR_LEN + length);
+  *frame = {(unsigned char)(MSG_VERSION & 0xFF),
+            startbyte,
+            (unsigned char)((length >> 24) & 0xFF),
+            (unsigned char)((length >> 16) & 0xFF),
+            (unsigned char)((length >> 8) & 0xFF),
+            (unsigned char)(length & 0xFF)};
+
+  if (isBroadcast) {
+    frame->insert(frame->end(), hash.begin(), hash.end());
+  }
+
+  frame->insert(frame->end(), payload.begin(), payload.end());
+  return frame;
+}
+
+bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& frame) {
   // LOG_MARKER();
-  LOG_PAYLOAD(DEBUG, "Sending message to " << peer, message,
+  LOG_PAYLOAD(DEBUG, "Sending message to " << peer, frame,
               Logger::MAX_BYTES_TO_DISPLAY);
 
   if (peer.m_ipAddress == 0 && peer.m_listenPortHost == 0) {
@@ -220,50 +242,9 @@ bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& message,
       return false;
     }
 
-    // Transmission format:
-    // 0x01 ~ 0xFF - version, defined in constant file
-    // 0x11 - start byte
-    // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
-    // <message>
-
-    // 0x01 ~ 0xFF - version, defined in constant file
-    // 0x22 - start byte (broadcast)
-    // 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + message
-    // <32-byte hash> <message>
-
-    // 0x01 ~ 0xFF - version, defined in constant file
-    // 0x33 - start byte (report)
-    // 0x00 0x00 0x00 0x01 - 4-byte length of message
-    // 0x00
-    uint32_t length = message.size();
-
-    if (start_byte == START_BYTE_BROADCAST) {
-      length += HASH_LEN;
-    }
-
-    unsigned char buf[HDR_LEN] = {(unsigned char)(MSG_VERSION & 0xFF),
-                                  start_byte,
-                                  (unsigned char)((length >> 24) & 0xFF),
-                                  (unsigned char)((length >> 16) & 0xFF),
-                                  (unsigned char)((length >> 8) & 0xFF),
-                                  (unsigned char)(length & 0xFF)};
-
-    if (HDR_LEN != writeMsg(buf, cli_sock, peer, HDR_LEN)) {
-      LOG_GENERAL(INFO, "DEBUG: not written_length == " << HDR_LEN);
+    if (frame.size() != writeMsg(frame.data(), cli_sock, peer, frame.size())) {
+      LOG_GENERAL(INFO, "DEBUG: not written_length == " << frame.size());
     }
-
-    if (start_byte != START_BYTE_BROADCAST) {
-      writeMsg(&message.at(0), cli_sock, peer, length);
-      return true;
-    }
-
-    if (HASH_LEN != writeMsg(&msg_hash.at(0), cli_sock, peer, HASH_LEN)) {
-      LOG_GENERAL(WARNING, "Wrong message hash length.");
-      return false;
-    }
-
-    length -= HASH_LEN;
-    writeMsg(&message.at(0), cli_sock, peer, length);
   } catch (const std::exception& e) {
     LOG_GENERAL(WARNING, "Error with write socket." << ' ' << e.what());
     return false;
@@ -271,10 +252,9 @@ bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& message,
   return true;
 }
 
-void SendJob::SendMessageCore(const Peer& peer, const bytes message,
-                              unsigned char startbyte, const bytes hash) {
+void SendJob::SendMessageCore(const Peer& peer, const MessageFrame& frame) {
   uint32_t retry_counter = 0;
-  while (!SendMessageSocketCore(peer, message, startbyte, hash)) {
+  while (!SendMessageSocketCore(peer, *frame)) {
     retry_counter++;
     LOG_GENERAL(WARNING, "Socket connect failed " << retry_counter << "/"
                                                   << MAXRETRYCONN
@@ -299,7 +279,7 @@ void SendJob::SendMessageCore(const Peer& peer, const bytes message,
   }
 }
 
-void SendJobPeer::DoSend() {
+void SendJobPeer::DoSend(const FrameSink& sink) {
   if (Blacklist::GetInstance().Exist(m_peer.m_ipAddress)) {
     LOG_GENERAL(INFO, "The node "
                           << m_peer
@@ -307,11 +287,11 @@ void SendJobPeer::DoSend() {
     return;
   }
 
-  SendMessageCore(m_peer, m_message, m_startbyte, m_hash);
+  sink(m_peer, m_frames);
 }
 
 template <class T>
-void SendJobPeers<T>::DoSend() {
+void SendJobPeers<T>::DoSend(const FrameSink& sink) {
   vector<unsigned int> indexes(m_peers.size());
 
   for (unsigned int i = 0; i < indexes.size(); i++) {
@@ -341,7 +321,7 @@ void SendJobPeers<T>::DoSend() {
       continue;
     }
 
-    SendMessageCore(peer, m_message, m_startbyte, m_hash);
+    sink(peer, m_frames);
   }
 
   if ((m_startbyte == START_BYTE_BROADCAST) && (m_selfPeer != Peer())) {
@@ -352,17 +332,29 @@ void SendJobPeers<T>::DoSend() {
 }
 
 void P2PComm::ProcessSendJob(SendJob* job) {
-  auto funcSendMsg = [job]() mutable -> void {
-    job->DoSend();
-    delete job;
-  };
-  m_SendPool.AddJob(funcSendMsg);
+  // Only fans the frame out to the per-peer queues, so this never blocks on
+  // the network
+  job->DoSend([this](const Peer& peer, const vector<MessageFrame>& frames) {
+    m_peerSendQueue.Push(peer, frames);
+  });
+  delete job;
 }
 
-void P2PComm::ClearBroadcastHashAsync(const bytes& message_hash) {
-  LOG_MARKER();
-  lock_guard<mutex> guard(m_broadcastToRemoveMutex);
-  m_broadcastToRemove.emplace_back(message_hash, chrono::system_clock::now());
+void P2PComm::QueueSendJob(SendJob* job) {
+  if (m_frameSender) {
+    job->DoSend([this](const Peer& peer, const vector<MessageFrame>& frames) {
+      for (const auto& frame : frames) {
+        m_frameSender(peer, frame);
+      }
+    });
+    delete job;
+    return;
+  }
+
+  if (!m_sendQueue.Push(job)) {
+    LOG_GENERAL(WARNING, "SendQueue is full");
+    delete job;
+  }
 }
 
 /*static*/ void P2PComm::ProcessBroadCastMsg(bytes& message,
@@ -374,39 +366,49 @@ void P2PComm::ClearBroadcastHashAsync(const bytes& message_hash) {
   P2PComm& p2p = P2PComm::GetInstance();
 
   // Check if this message has been received before
-  bool found = false;
-  {
-    lock_guard<mutex> guard(p2p.m_broadcastHashesMutex);
-
-    found =
-        (p2p.m_broadcastHashes.find(msg_hash) != p2p.m_broadcastHashes.end());
-    // While we have the lock, we should quickly add the hash
-    if (!found) {
-      SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
-      sha256.Update(message, HDR_LEN + HASH_LEN,
-                    message.size() - HDR_LEN - HASH_LEN);
-      bytes this_msg_hash = sha256.Finalize();
-
-      if (this_msg_hash == msg_hash) {
-        p2p.m_broadcastHashes.insert(this_msg_hash);
-      } else {
-        LOG_GENERAL(WARNING, "Incorrect message hash.");
-        return;
-      }
-    }
+  if (p2p.m_broadcastHashes.Contains(msg_hash.data())) {
+    // We already sent and/or received this message before -> discard
+    LOG_GENERAL(INFO, "Discarding duplicate broadcast message.");
+    return;
   }
 
-  if (found) {
-    // We already sent and/or received this message before -> discard
+  // The hash covers the uncompressed message, and a compressed frame is
+  // rebroadcast as it is
+  const bool compressed = (message.at(1) == START_BYTE_BROADCAST_COMPRESSED);
+  bytes decompressed;
+  if (compressed &&
+      !P2PCompression::GetInstance().Decompress(
+          message.data() + HDR_LEN + HASH_LEN, messageLength - HASH_LEN,
+          decompressed)) {
+    return;
+  }
+
+  const unsigned char* body =
+      compressed ? decompressed.data() : message.data() + HDR_LEN + HASH_LEN;
+  const size_t bodyLength =
+      compressed ? decompressed.size() : messageLength - HASH_LEN;
+
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+  if (compressed) {
+    sha256.Update(decompressed);
+  } else {
+    sha256.Update(message, HDR_LEN + HASH_LEN, bodyLength);
+  }
+  if (sha256.Finalize() != msg_hash) {
+    LOG_GENERAL(WARNING, "Incorrect message hash.");
+    return;
+  }
+
+  if (!p2p.m_broadcastHashes.Insert(msg_hash.data())) {
     LOG_GENERAL(INFO, "Discarding duplicate broadcast message.");
     return;
   }
 
   unsigned char msg_type = 0xFF;
   unsigned char ins_type = 0xFF;
-  if (messageLength - HASH_LEN > MessageOffset::INST) {
-    msg_type = message.at(HDR_LEN + HASH_LEN + MessageOffset::TYPE);
-    ins_type = message.at(HDR_LEN + HASH_LEN + MessageOffset::INST);
+  if (bodyLength > MessageOffset::INST) {
+    msg_type = body[MessageOffset::TYPE];
+    ins_type = body[MessageOffset::INST];
   }
 
   vector<Peer> broadcast_list =
@@ -416,8 +418,6 @@ void P2PComm::ClearBroadcastHashAsync(const bytes& message_hash) {
     p2p.RebroadcastMessage(broadcast_list, message, msg_hash);
   }
 
-  p2p.ClearBroadcastHashAsync(msg_hash);
-
   string msgHashStr;
   if (!DataConversion::Uint8VecToHexStr(msg_hash, msgHashStr)) {
     return;
@@ -427,8 +427,9 @@ void P2PComm::ClearBroadcastHashAsync(const bytes& message_hash) {
                        << msgHashStr.substr(0, 6) << "] RECV");
 
   // Move the shared_ptr message to raw pointer type
-  pair<bytes, Peer>* raw_message = new pair<bytes, Peer>(
-      bytes(message.begin() + HDR_LEN + HASH_LEN, message.end()), from);
+  pair<bytes, Peer>* raw_message =
+      compressed ? new pair<bytes, Peer>(move(decompressed), from)
+                 : new pair<bytes, Peer>(bytes(body, body + bodyLength), from);
   LOG_GENERAL(INFO, "Size of broadcast message: " << message.size());
 
   // Queue the message
@@ -487,19 +488,120 @@ void P2PComm::ClearBroadcastHashAsync(const bytes& message_hash) {
   }
 }
 
-void P2PComm::EventCallback(struct bufferevent* bev, short events,
-                            [[gnu::unused]] void* ctx) {
-  unique_ptr<struct bufferevent, decltype(&bufferevent_free)> socket_closer(
-      bev, bufferevent_free);
+// Reception format:
+// 0x01 ~ 0xFF - version, defined in constant file
+// 0x11 - start byte
+// 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
+// <message>
+
+// 0x01 ~ 0xFF - version, defined in constant file
+// 0x22 - start byte (broadcast)
+// 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + message
+// <32-byte hash> <message>
+
+// 0x01 ~ 0xFF - version, defined in constant file
+// 0x33 - start byte (gossip)
+// 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
+// 0x01 ~ 0x04 - Gossip_Message_Type
+// <4-byte Age> <message>
+
+// 0x01 ~ 0xFF - version, defined in constant file
+// 0x33 - start byte (report)
+// 0x00 0x00 0x00 0x01 - 4-byte length of message
+// 0x00
+/*static*/ bool P2PComm::ValidateHeader(const unsigned char* header,
+                                        const Peer& from,
+                                        uint32_t& messageLength) {
+  const unsigned char version = header[0];
+  const unsigned char startByte = header[1];
 
-  if (events & BEV_EVENT_ERROR) {
-    LOG_GENERAL(WARNING, "Error from bufferevent.");
-    return;
+  // Check for version requirement
+  if (version != (unsigned char)(MSG_VERSION & 0xFF)) {
+    LOG_GENERAL(WARNING, "Header version wrong, received ["
+                             << version - 0x00 << "] while expected ["
+                             << MSG_VERSION << "].");
+    return false;
   }
 
-  // Not all bytes read out
-  if (!(events & (BEV_EVENT_EOF | BEV_EVENT_ERROR))) {
-    LOG_GENERAL(WARNING, "Unknown error from bufferevent.");
+  messageLength =
+      (header[2] << 24) + (header[3] << 16) + (header[4] << 8) + header[5];
+
+  // Check for minimum message size
+  if (messageLength == 0) {
+    LOG_GENERAL(WARNING, "Empty message received.");
+    return false;
+  }
+
+  if (messageLength > MAX_MSG_SIZE_IN_BYTES) {
+    LOG_GENERAL(WARNING, "Message received [Size:"
+                             << messageLength << "] is unexpectedly large [ >"
+                             << MAX_MSG_SIZE_IN_BYTES << " ]");
+    return false;
+  }
+
+  if (startByte == START_BYTE_BROADCAST ||
+      startByte == START_BYTE_BROADCAST_COMPRESSED) {
+    if (messageLength <= HASH_LEN) {
+      LOG_GENERAL(WARNING,
+                  "Hash missing or empty broadcast message (messageLength = "
+                      << messageLength << ")");
+      return false;
+    }
+  } else if (startByte == START_BYTE_GOSSIP) {
+    // Check for the maximum gossiped-message size
+    if (messageLength + HDR_LEN >= MAX_GOSSIP_MSG_SIZE_IN_BYTES) {
+      LOG_GENERAL(WARNING, "Gossip message received [Size:"
+                               << messageLength + HDR_LEN
+                               << "] is unexpectedly large [ >"
+                               << MAX_GOSSIP_MSG_SIZE_IN_BYTES
+                               << " ]. Will be blacklisting the sender");
+      Blacklist::GetInstance().Add(
+          from.m_ipAddress);  // so we dont spend cost sending any data to this
+                              // sender as well.
+      return false;
+    }
+    if (messageLength <
+        GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN + GOSSIP_SNDR_LISTNR_PORT_LEN) {
+      LOG_GENERAL(
+          WARNING,
+          "Gossip Msg Type and/or Gossip Round and/or SNDR LISTNR is missing "
+          "(messageLength = "
+              << messageLength << ")");
+      return false;
+    }
+  } else if (startByte == START_BYTE_ERASURE_CODED) {
+    if (messageLength <= ErasureCodedTransfer::CHUNK_HDR_LEN) {
+      LOG_GENERAL(WARNING,
+                  "Erasure-coded chunk header missing or empty chunk "
+                  "(messageLength = "
+                      << messageLength << ")");
+      return false;
+    }
+  } else if (startByte == START_BYTE_CHUNK) {
+    if (messageLength <= ChunkedTransfer::CHUNK_HDR_LEN) {
+      LOG_GENERAL(WARNING,
+                  "Chunk header missing or empty chunk (messageLength = "
+                      << messageLength << ")");
+      return false;
+    }
+  } else if (startByte != START_BYTE_NORMAL &&
+             startByte != START_BYTE_NORMAL_COMPRESSED) {
+    // Unexpected start byte. Drop this message
+    LOG_GENERAL(WARNING, "Incorrect start byte.");
+    return false;
+  }
+
+  return true;
+}
+
+void P2PComm::ReadCallback(struct bufferevent* bev,
+                           [[gnu::unused]] void* ctx) {
+  unique_ptr<struct bufferevent, decltype(&bufferevent_free)> socket_closer(
+      bev, bufferevent_free);
+
+  struct evbuffer* input = bufferevent_get_input(bev);
+  if (input == NULL) {
+    LOG_GENERAL(WARNING, "bufferevent_get_input failure.");
     return;
   }
 
@@ -510,135 +612,225 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
   getpeername(fd, (struct sockaddr*)&cli_addr, &addr_size);
   Peer from(cli_addr.sin_addr.s_addr, cli_addr.sin_port);
 
-  // Get the data stored in buffer
-  struct evbuffer* input = bufferevent_get_input(bev);
-  if (input == NULL) {
-    LOG_GENERAL(WARNING, "bufferevent_get_input failure.");
-    return;
-  }
-  size_t len = evbuffer_get_length(input);
-  if (len == 0) {
-    LOG_GENERAL(WARNING, "evbuffer_get_length failure.");
-    return;
-  }
-  bytes message(len);
-  if (evbuffer_copyout(input, message.data(), len) !=
-      static_cast<ev_ssize_t>(len)) {
-    LOG_GENERAL(WARNING, "evbuffer_copyout failure.");
-    return;
-  }
-  if (evbuffer_drain(input, len) != 0) {
-    LOG_GENERAL(WARNING, "evbuffer_drain failure.");
-    return;
-  }
+  // A sender may write several frames back to back over one connection, so
+  // keep consuming until only a partial frame is left
+  while (evbuffer_get_length(input) >= HDR_LEN) {
+    // Validate the header as soon as it arrives, so bad or oversized frames
+    // are dropped before their body is buffered
+    unsigned char header[HDR_LEN];
+    if (evbuffer_copyout(input, header, HDR_LEN) !=
+        static_cast<ev_ssize_t>(HDR_LEN)) {
+      LOG_GENERAL(WARNING, "evbuffer_copyout failure.");
+      return;
+    }
 
-  // Reception format:
-  // 0x01 ~ 0xFF - version, defined in constant file
-  // 0x11 - start byte
-  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
-  // <message>
+    uint32_t messageLength = 0;
+    if (!ValidateHeader(header, from, messageLength)) {
+      return;
+    }
 
-  // 0x01 ~ 0xFF - version, defined in constant file
-  // 0x22 - start byte (broadcast)
-  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + message
-  // <32-byte hash> <message>
+    if (evbuffer_get_length(input) < HDR_LEN + messageLength) {
+      // Only wake up again once the whole frame is buffered
+      bufferevent_setwatermark(bev, EV_READ, HDR_LEN + messageLength, 0);
+      socket_closer.release();
+      return;
+    }
 
-  // 0x01 ~ 0xFF - version, defined in constant file
-  // 0x33 - start byte (gossip)
-  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
-  // 0x01 ~ 0x04 - Gossip_Message_Type
-  // <4-byte Age> <message>
+    if (!ProcessFrame(input, header[1], messageLength, from)) {
+      return;
+    }
+  }
 
-  // 0x01 ~ 0xFF - version, defined in constant file
-  // 0x33 - start byte (report)
-  // 0x00 0x00 0x00 0x01 - 4-byte length of message
-  // 0x00
+  bufferevent_setwatermark(bev, EV_READ, HDR_LEN, 0);
+  socket_closer.release();
+}
 
-  // Check for minimum message size
-  if (message.size() <= HDR_LEN) {
-    LOG_GENERAL(WARNING, "Empty message received.");
-    return;
-  }
+/*static*/ bool P2PComm::ProcessFrame(struct evbuffer* input,
+                                      const unsigned char startByte,
+                                      const uint32_t messageLength,
+                                      const Peer& from) {
+  const size_t len = HDR_LEN + messageLength;
 
-  const unsigned char version = message[0];
-  const unsigned char startByte = message[1];
+  if (startByte == START_BYTE_NORMAL) {
+    // Skip the header and copy the payload straight into the dispatched buffer
+    if (evbuffer_drain(input, HDR_LEN) != 0) {
+      LOG_GENERAL(WARNING, "evbuffer_drain failure.");
+      return false;
+    }
 
-  // Check for version requirement
-  if (version != (unsigned char)(MSG_VERSION & 0xFF)) {
-    LOG_GENERAL(WARNING, "Header version wrong, received ["
-                             << version - 0x00 << "] while expected ["
-                             << MSG_VERSION << "].");
-    return;
-  }
+    pair<bytes, Peer>* raw_message =
+        new pair<bytes, Peer>(bytes(messageLength), from);
+    if (evbuffer_remove(input, raw_message->first.data(), messageLength) !=
+        static_cast<int>(messageLength)) {
+      LOG_GENERAL(WARNING, "evbuffer_remove failure.");
+      delete raw_message;
+      return false;
+    }
 
-  const uint32_t messageLength =
-      (message[2] << 24) + (message[3] << 16) + (message[4] << 8) + message[5];
+    LOG_PAYLOAD(INFO, "Incoming normal message from " << from,
+                raw_message->first, Logger::MAX_BYTES_TO_DISPLAY);
+    LOG_GENERAL(INFO, "Size of normal message: " << len);
 
-  {
-    // Check for length consistency
-    uint32_t res;
+    // Queue the message
+    m_dispatcher(raw_message);
+    return true;
+  }
 
-    if (!SafeMath<uint32_t>::sub(message.size(), HDR_LEN, res)) {
-      LOG_GENERAL(WARNING, "Unexpected subtraction operation!");
-      return;
+  if (startByte == START_BYTE_NORMAL_COMPRESSED) {
+    const unsigned char* frame = evbuffer_pullup(input, len);
+    if (frame == NULL) {
+      LOG_GENERAL(WARNING, "evbuffer_pullup failure.");
+      return false;
     }
 
-    if (messageLength != res) {
-      LOG_GENERAL(WARNING, "Incorrect message length.");
-      return;
+    pair<bytes, Peer>* raw_message = new pair<bytes, Peer>(bytes(), from);
+    if (!P2PCompression::GetInstance().Decompress(
+            frame + HDR_LEN, messageLength, raw_message->first)) {
+      delete raw_message;
+      return false;
     }
+    evbuffer_drain(input, len);
+
+    LOG_PAYLOAD(INFO, "Incoming compressed message from " << from,
+                raw_message->first, Logger::MAX_BYTES_TO_DISPLAY);
+    LOG_GENERAL(INFO, "Size of compressed message: "
+                          << len << " (" << raw_message->first.size()
+                          << " uncompressed)");
+
+    // Queue the message
+    m_dispatcher(raw_message);
+    return true;
   }
 
-  if (startByte == START_BYTE_BROADCAST) {
-    LOG_PAYLOAD(INFO, "Incoming broadcast message from " << from, message,
-                Logger::MAX_BYTES_TO_DISPLAY);
+  if (startByte == START_BYTE_ERASURE_CODED) {
+    const unsigned char* frame = evbuffer_pullup(input, len);
+    if (frame == NULL) {
+      LOG_GENERAL(WARNING, "evbuffer_pullup failure.");
+      return false;
+    }
 
-    if (messageLength <= HASH_LEN) {
-      LOG_GENERAL(WARNING,
-                  "Hash missing or empty broadcast message (messageLength = "
-                      << messageLength << ")");
-      return;
+    bool relay = false;
+    pair<bytes, Peer>* raw_message = new pair<bytes, Peer>(bytes(), from);
+    const bool complete = ErasureCodedTransfer::GetInstance().AddChunk(
+        frame + HDR_LEN, messageLength, from, relay, raw_message->first);
+
+    if (relay) {
+      // Only chunks straight from the DS committee are fanned out, so other
+      // peers cannot use this node to flood its shard
+      P2PComm& p2p = P2PComm::GetInstance();
+      vector<Peer> relayPeers;
+      {
+        lock_guard<mutex> g(p2p.m_mutexErasureRelayPeers);
+        if (p2p.m_erasureSenders.count(from.m_ipAddress) > 0) {
+          relayPeers = p2p.m_erasureRelayPeers;
+        }
+      }
+
+      if (!relayPeers.empty()) {
+        // Forwarded copies are not forwarded again
+        bytes chunk(frame + HDR_LEN, frame + len);
+        chunk[ErasureCodedTransfer::RELAY_FLAG_OFFSET] = 0;
+        p2p.SendMessage(relayPeers, chunk, START_BYTE_ERASURE_CODED);
+      }
     }
+    evbuffer_drain(input, len);
 
-    ProcessBroadCastMsg(message, messageLength, from);
-  } else if (startByte == START_BYTE_NORMAL) {
-    LOG_PAYLOAD(INFO, "Incoming normal message from " << from, message,
-                Logger::MAX_BYTES_TO_DISPLAY);
+    if (!complete) {
+      delete raw_message;
+      return true;
+    }
 
-    // Move the shared_ptr message to raw pointer type
-    pair<bytes, Peer>* raw_message = new pair<bytes, Peer>(
-        bytes(message.begin() + HDR_LEN, message.end()), from);
-    LOG_GENERAL(INFO, "Size of normal message: " << message.size());
+    LOG_GENERAL(INFO, "Size of erasure-coded message: "
+                          << raw_message->first.size());
 
     // Queue the message
     m_dispatcher(raw_message);
-  } else if (startByte == START_BYTE_GOSSIP) {
-    // Check for the maximum gossiped-message size
-    if (message.size() >= MAX_GOSSIP_MSG_SIZE_IN_BYTES) {
-      LOG_GENERAL(WARNING, "Gossip message received [Size:"
-                               << message.size()
-                               << "] is unexpectedly large [ >"
-                               << MAX_GOSSIP_MSG_SIZE_IN_BYTES
-                               << " ]. Will be blacklisting the sender");
-      Blacklist::GetInstance().Add(
-          from.m_ipAddress);  // so we dont spend cost sending any data to this
-                              // sender as well.
-      return;
+    return true;
+  }
+
+  if (startByte == START_BYTE_CHUNK) {
+    const unsigned char* frame = evbuffer_pullup(input, len);
+    if (frame == NULL) {
+      LOG_GENERAL(WARNING, "evbuffer_pullup failure.");
+      return false;
     }
-    if (messageLength <
-        GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN + GOSSIP_SNDR_LISTNR_PORT_LEN) {
-      LOG_GENERAL(
-          WARNING,
-          "Gossip Msg Type and/or Gossip Round and/or SNDR LISTNR is missing "
-          "(messageLength = "
-              << messageLength << ")");
-      return;
+
+    bytes* whole = new bytes();
+    const bool complete = ChunkedTransfer::GetInstance().AddChunk(
+        frame + HDR_LEN, messageLength, from, *whole);
+    evbuffer_drain(input, len);
+    if (!complete) {
+      delete whole;
+      return true;
     }
 
-    ProcessGossipMsg(message, from);
+    // The reassembled frame is processed as if it had arrived by itself,
+    // except that it cannot be chunked again
+    uint32_t wholeLength = 0;
+    if (whole->size() < HDR_LEN || whole->at(1) == START_BYTE_CHUNK ||
+        !ValidateHeader(whole->data(), from, wholeLength) ||
+        whole->size() != HDR_LEN + wholeLength) {
+      LOG_GENERAL(WARNING, "Invalid reassembled message of " << whole->size()
+                                                              << " bytes");
+      delete whole;
+      return true;
+    }
+    LOG_GENERAL(INFO, "Reassembled " << whole->size() << " byte message from "
+                                     << from);
+
+    struct evbuffer* wholeBuffer = evbuffer_new();
+    if (wholeBuffer == NULL) {
+      LOG_GENERAL(WARNING, "evbuffer_new failure.");
+      delete whole;
+      return true;
+    }
+    evbuffer_add_reference(
+        wholeBuffer, whole->data(), whole->size(),
+        [](const void*, size_t, void* extra) {
+          delete static_cast<bytes*>(extra);
+        },
+        whole);
+    ProcessFrame(wholeBuffer, whole->at(1), wholeLength, from);
+    evbuffer_free(wholeBuffer);
+    return true;
+  }
+
+  // Broadcast and gossip processing work on the whole frame
+  bytes message(len);
+  if (evbuffer_remove(input, message.data(), len) != static_cast<int>(len)) {
+    LOG_GENERAL(WARNING, "evbuffer_remove failure.");
+    return false;
+  }
+
+  // Gossip handling rewrites the sender's port, so give it its own copy
+  Peer sender(from);
+  if (startByte == START_BYTE_BROADCAST ||
+      startByte == START_BYTE_BROADCAST_COMPRESSED) {
+    LOG_PAYLOAD(INFO, "Incoming broadcast message from " << from, message,
+                Logger::MAX_BYTES_TO_DISPLAY);
+    ProcessBroadCastMsg(message, messageLength, sender);
   } else {
-    // Unexpected start byte. Drop this message
-    LOG_GENERAL(WARNING, "Incorrect start byte.");
+    ProcessGossipMsg(message, sender);
+  }
+  return true;
+}
+
+void P2PComm::EventCallback(struct bufferevent* bev, short events,
+                            [[gnu::unused]] void* ctx) {
+  unique_ptr<struct bufferevent, decltype(&bufferevent_free)> socket_closer(
+      bev, bufferevent_free);
+
+  if (events & BEV_EVENT_ERROR) {
+    LOG_GENERAL(WARNING, "Error from bufferevent.");
+    return;
+  }
+
+  // Complete frames are consumed in ReadCallback, so anything left here was
+  // cut short by the sender
+  struct evbuffer* input = bufferevent_get_input(bev);
+  if (input != NULL && evbuffer_get_length(input) > 0) {
+    LOG_GENERAL(WARNING, "Connection closed with an incomplete message of "
+                             << evbuffer_get_length(input) << " bytes.");
   }
 }
 
@@ -685,7 +877,8 @@ void P2PComm::AcceptConnectionCallback([[gnu::unused]] evconnlistener* listener,
     return;
   }
 
-  bufferevent_setcb(bev, NULL, NULL, EventCallback, NULL);
+  bufferevent_setwatermark(bev, EV_READ, HDR_LEN, 0);
+  bufferevent_setcb(bev, ReadCallback, NULL, EventCallback, NULL);
   bufferevent_enable(bev, EV_READ | EV_WRITE);
 }
 
@@ -700,19 +893,75 @@ void P2PComm::StartMessagePump(uint32_t listen_port_host, Dispatcher dispatcher,
 
   // Launch the thread that reads messages from the send queue
   auto funcCheckSendQueue = [this]() mutable -> void {
-    SendJob* job = NULL;
+    vector<SendJob*> jobs;
+    auto lastStatsTime = chrono::steady_clock::now();
     while (true) {
-      while (m_sendQueue.pop(job)) {
+      jobs.clear();
+      m_sendQueue.PopBatch(jobs, MAXPUMPMESSAGE, chrono::milliseconds(1000));
+      for (auto job : jobs) {
         ProcessSendJob(job);
       }
-      std::this_thread::sleep_for(std::chrono::microseconds(1));
+
+      if (chrono::steady_clock::now() - lastStatsTime >=
+          chrono::seconds(MSGQUEUE_STATS_INTERVAL_IN_SECONDS)) {
+        LOG_GENERAL(INFO, "[SendQueue] " << m_sendQueue.GetAndResetStats());
+        LOG_GENERAL(INFO,
+                    "[Compression] "
+                        << P2PCompression::GetInstance().GetAndResetStats());
+        lastStatsTime = chrono::steady_clock::now();
+      }
     }
   };
   DetachedFunction(1, funcCheckSendQueue);
 
+  // Launch the event loop that writes the per-peer send queues
+  DetachedFunction(1, [this]() mutable -> void { m_peerSendQueue.Run(); });
+
   m_dispatcher = dispatcher;
   m_broadcast_list_retriever = broadcast_list_retriever;
 
+  // Every reactor after the first runs on its own thread, and this thread
+  // becomes the first reactor
+  const unsigned int reactorCount = max(1u, P2P_REACTOR_COUNT);
+  for (unsigned int index = 1; index < reactorCount; index++) {
+    DetachedFunction(1, [index, listen_port_host]() mutable -> void {
+      RunReactor(index, listen_port_host);
+    });
+  }
+
+  RunReactor(0, listen_port_host);
+}
+
+void P2PComm::SetTransport(const FrameSender& sender, Dispatcher dispatcher,
+                           BroadcastListFunc broadcast_list_retriever) {
+  m_frameSender = sender;
+  m_dispatcher = dispatcher;
+  m_broadcast_list_retriever = broadcast_list_retriever;
+}
+
+/*static*/ bool P2PComm::ReceiveFrame(const bytes& frame, const Peer& from) {
+  uint32_t messageLength = 0;
+  if (frame.size() < HDR_LEN ||
+      !ValidateHeader(frame.data(), from, messageLength) ||
+      frame.size() != HDR_LEN + messageLength) {
+    LOG_GENERAL(WARNING, "Invalid frame of " << frame.size() << " bytes from "
+                                             << from);
+    return false;
+  }
+
+  struct evbuffer* buffer = evbuffer_new();
+  if (buffer == NULL) {
+    LOG_GENERAL(WARNING, "evbuffer_new failure.");
+    return false;
+  }
+  evbuffer_add(buffer, frame.data(), frame.size());
+  const bool processed = ProcessFrame(buffer, frame.at(1), messageLength, from);
+  evbuffer_free(buffer);
+  return processed;
+}
+
+/*static*/ void P2PComm::RunReactor(const unsigned int index,
+                                    const uint32_t listen_port_host) {
   struct sockaddr_in serv_addr;
   memset(&serv_addr, 0, sizeof(struct sockaddr_in));
   serv_addr.sin_family = AF_INET;
@@ -727,18 +976,25 @@ void P2PComm::StartMessagePump(uint32_t listen_port_host, Dispatcher dispatcher,
     return;
   }
 
+  // Each reactor binds its own socket to the port (SO_REUSEPORT), so the
+  // kernel spreads new connections across reactors and a connection stays
+  // on the reactor that accepted it
   struct evconnlistener* listener = evconnlistener_new_bind(
       base, AcceptConnectionCallback, nullptr,
-      LEV_OPT_REUSEABLE | LEV_OPT_CLOSE_ON_FREE, -1,
+      LEV_OPT_REUSEABLE | LEV_OPT_REUSEABLE_PORT | LEV_OPT_CLOSE_ON_FREE, -1,
       (struct sockaddr*)&serv_addr, sizeof(struct sockaddr_in));
 
   if (listener == NULL) {
-    LOG_GENERAL(WARNING, "evconnlistener_new_bind failure.");
+    LOG_GENERAL(WARNING, "evconnlistener_new_bind failure on reactor " << index
+                                                                       << ".");
     event_base_free(base);
     // fixme: should we exit here?
     return;
   }
 
+  LOG_GENERAL(INFO, "Reactor " << index << " listening on port "
+                               << listen_port_host);
+
   event_base_dispatch(base);
   evconnlistener_free(listener);
   event_base_free(base);
@@ -757,13 +1013,11 @@ void P2PComm::SendMessage(const vector<Peer>& peers, const bytes& message,
   dynamic_cast<SendJobPeers<vector<Peer>>*>(job)->m_peers = peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = startByteType;
-  job->m_message = message;
-  job->m_hash.clear();
+  job->m_frames =
+      ChunkedTransfer::Split(SendJob::MakeFrame(message, startByteType, {}));
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-  }
+  QueueSendJob(job);
 }
 
 void P2PComm::SendMessage(const deque<Peer>& peers, const bytes& message,
@@ -779,13 +1033,11 @@ void P2PComm::SendMessage(const deque<Peer>& peers, const bytes& message,
   dynamic_cast<SendJobPeers<deque<Peer>>*>(job)->m_peers = peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = startByteType;
-  job->m_message = message;
-  job->m_hash.clear();
+  job->m_frames =
+      ChunkedTransfer::Split(SendJob::MakeFrame(message, startByteType, {}));
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-  }
+  QueueSendJob(job);
 }
 
 void P2PComm::SendMessage(const Peer& peer, const bytes& message,
@@ -797,13 +1049,11 @@ void P2PComm::SendMessage(const Peer& peer, const bytes& message,
   dynamic_cast<SendJobPeer*>(job)->m_peer = peer;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = startByteType;
-  job->m_message = message;
-  job->m_hash.clear();
+  job->m_frames =
+      ChunkedTransfer::Split(SendJob::MakeFrame(message, startByteType, {}));
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-  }
+  QueueSendJob(job);
 }
 
 void P2PComm::SendBroadcastMessage(const vector<Peer>& peers,
@@ -822,18 +1072,14 @@ void P2PComm::SendBroadcastMessage(const vector<Peer>& peers,
   dynamic_cast<SendJobPeers<vector<Peer>>*>(job)->m_peers = peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = START_BYTE_BROADCAST;
-  job->m_message = message;
   job->m_hash = sha256.Finalize();
+  job->m_frames = ChunkedTransfer::Split(
+      SendJob::MakeFrame(message, START_BYTE_BROADCAST, job->m_hash));
 
-  bytes hashCopy(job->m_hash);
+  m_broadcastHashes.Insert(job->m_hash.data());
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-  }
-
-  lock_guard<mutex> guard(m_broadcastHashesMutex);
-  m_broadcastHashes.insert(hashCopy);
+  QueueSendJob(job);
 }
 
 void P2PComm::SendBroadcastMessage(const deque<Peer>& peers,
@@ -852,18 +1098,14 @@ void P2PComm::SendBroadcastMessage(const deque<Peer>& peers,
   dynamic_cast<SendJobPeers<deque<Peer>>*>(job)->m_peers = peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = START_BYTE_BROADCAST;
-  job->m_message = message;
   job->m_hash = sha256.Finalize();
+  job->m_frames = ChunkedTransfer::Split(
+      SendJob::MakeFrame(message, START_BYTE_BROADCAST, job->m_hash));
 
-  bytes hashCopy(job->m_hash);
+  m_broadcastHashes.Insert(job->m_hash.data());
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-  }
-
-  lock_guard<mutex> guard(m_broadcastHashesMutex);
-  m_broadcastHashes.insert(hashCopy);
+  QueueSendJob(job);
 }
 
 void P2PComm::RebroadcastMessage(const vector<Peer>& peers,
@@ -875,13 +1117,39 @@ void P2PComm::RebroadcastMessage(const vector<Peer>& peers,
   dynamic_cast<SendJobPeers<vector<Peer>>*>(job)->m_peers = peers;
   job->m_selfPeer = Peer();
   job->m_startbyte = START_BYTE_BROADCAST;
-  copy(message.begin() + HDR_LEN + HASH_LEN, message.end(),
-       back_inserter(job->m_message));
+  // The received message is already a complete broadcast frame
+  job->m_frames = ChunkedTransfer::Split(make_shared<const bytes>(message));
   job->m_hash = msg_hash;
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
+  QueueSendJob(job);
+}
+
+void P2PComm::SendErasureCodedMessage(const vector<Peer>& peers,
+                                      const bytes& message) {
+  LOG_MARKER();
+
+  vector<bytes> chunks;
+  if (!ErasureCodedTransfer::Encode(message, peers.size(), chunks)) {
+    return;
+  }
+
+  for (unsigned int i = 0; i < peers.size(); i++) {
+    SendMessage(peers.at(i), chunks.at(i % chunks.size()),
+                START_BYTE_ERASURE_CODED);
+  }
+}
+
+void P2PComm::SetErasureRelayPeers(const vector<Peer>& peers) {
+  lock_guard<mutex> g(m_mutexErasureRelayPeers);
+  m_erasureRelayPeers = peers;
+}
+
+void P2PComm::SetErasureSenders(const vector<Peer>& senders) {
+  lock_guard<mutex> g(m_mutexErasureRelayPeers);
+  m_erasureSenders.clear();
+  for (const auto& sender : senders) {
+    m_erasureSenders.emplace(sender.m_ipAddress);
   }
 }
 
@@ -896,7 +1164,12 @@ void P2PComm::SendMessageNoQueue(const Peer& peer, const bytes& message,
     return;
   }
 
-  SendJob::SendMessageCore(peer, message, startByteType, {});
+  const MessageFrame frame = SendJob::MakeFrame(message, startByteType, {});
+  if (m_frameSender) {
+    m_frameSender(peer, frame);
+    return;
+  }
+  SendJob::SendMessageCore(peer, frame);
 }
 
 bool P2PComm::SpreadRumor(const bytes& message) {
@@ -19,73 +19,79 @@
 #define __P2PCOMM_H__
 
 #include <event2/util.h>
-#include <boost/lockfree/queue.hpp>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <vector>
 
+#include "BroadcastDedupSet.h"
 #include "Peer.h"
+#include "PeerSendQueue.h"
 #include "RumorManager.h"
 #include "common/BaseType.h"
 #include "common/Constants.h"
+#include "libUtils/BlockingQueue.h"
 #include "libUtils/Logger.h"
-#include "libUtils/ThreadPool.h"
 
+struct evbuffer;
 struct evconnlistener;
 
 extern const unsigned char START_BYTE_NORMAL;
+extern const unsigned char START_BYTE_BROADCAST;
 extern const unsigned char START_BYTE_GOSSIP;
+extern const unsigned char START_BYTE_CHUNK;
+extern const unsigned char START_BYTE_ERASURE_CODED;
+extern const unsigned int HDR_LEN;
 
 class SendJob {
  protected:
   static uint32_t writeMsg(const void* buf, int cli_sock, const Peer& from,
                            const uint32_t message_length);
-  static bool SendMessageSocketCore(const Peer& peer, const bytes& message,
-                                    unsigned char start_byte,
-                                    const bytes& msg_hash);
+  static bool SendMessageSocketCore(const Peer& peer, const bytes& frame);
 
  public:
   Peer m_selfPeer;
   unsigned char m_startbyte;
-  bytes m_message;
+  /// One frame, or the chunks of a large one
+  std::vector<MessageFrame> m_frames;
   bytes m_hash;
 
-  static void SendMessageCore(const Peer& peer, const bytes message,
-                              unsigned char startbyte, const bytes hash);
+  /// Prepends the transmission header (and the hash for broadcasts)
+  static MessageFrame MakeFrame(const bytes& message, unsigned char startbyte,
+                                const bytes& hash);
+
+  static void SendMessageCore(const Peer& peer, const MessageFrame& frame);
+
+  /// Takes the frames of the message for one peer
+  using FrameSink = std::function<void(const Peer& peer,
+                                       const std::vector<MessageFrame>&)>;
 
   virtual ~SendJob() {}
-  virtual void DoSend() = 0;
+  virtual void DoSend(const FrameSink& sink) = 0;
 };
 
 class SendJobPeer : public SendJob {
  public:
   Peer m_peer;
-  void DoSend();
+  void DoSend(const FrameSink& sink);
 };
 
 template <class T>
 class SendJobPeers : public SendJob {
  public:
   T m_peers;
-  void DoSend();
+  void DoSend(const FrameSink& sink);
 };
 
 /// Provides network layer functionality.
 class P2PComm {
-  std::set<bytes> m_broadcastHashes;
-  std::mutex m_broadcastHashesMutex;
-  std::deque<
-      std::pair<bytes, std::chrono::time_point<std::chrono::system_clock>>>
-      m_broadcastToRemove;
-  std::mutex m_broadcastToRemoveMutex;
+  BroadcastDedupSet m_broadcastHashes;
   RumorManager m_rumorManager;
 
   const static uint32_t MAXPUMPMESSAGE = 128;
 
-  void ClearBroadcastHashAsync(const bytes& message_hash);
-
   P2PComm();
   ~P2PComm();
 
@@ -99,16 +105,32 @@ class P2PComm {
   Peer m_selfPeer;
   PairOfKey m_selfKey;
 
-  ThreadPool m_SendPool{MAXMESSAGE, "SendPool"};
+  PeerSendQueue m_peerSendQueue;
 
-  boost::lockfree::queue<SendJob*> m_sendQueue;
+  std::mutex m_mutexErasureRelayPeers;
+  std::vector<Peer> m_erasureRelayPeers;
+  std::set<boost::multiprecision::uint128_t> m_erasureSenders;
+
+  BlockingQueue<SendJob*> m_sendQueue;
   void ProcessSendJob(SendJob* job);
 
+  /// Queues the job for the message pump, or hands its frames to the frame
+  /// sender right away if one is set
+  void QueueSendJob(SendJob* job);
+
   static void ProcessBroadCastMsg(bytes& message, const uint32_t messageLength,
                                   const Peer& from);
   static void ProcessGossipMsg(bytes& message, Peer& from);
 
+  static bool ValidateHeader(const unsigned char* header, const Peer& from,
+                             uint32_t& messageLength);
+  static bool ProcessFrame(struct evbuffer* input,
+                           const unsigned char startByte,
+                           const uint32_t messageLength, const Peer& from);
+  static void ReadCallback(struct bufferevent* bev, void* ctx);
   static void EventCallback(struct bufferevent* bev, short events, void* ctx);
+  static void RunReactor(const unsigned int index,
+                         const uint32_t listen_port_host);
   static void AcceptConnectionCallback(evconnlistener* listener,
                                        evutil_socket_t cli_sock,
                                        struct sockaddr* cli_addr, int socklen,
@@ -123,6 +145,10 @@ class P2PComm {
   using BroadcastListFunc = std::function<std::vector<Peer>(
       unsigned char msg_type, unsigned char ins_type, const Peer&)>;
 
+  /// Carries one wire frame to a peer in place of the sockets
+  using FrameSender =
+      std::function<void(const Peer& peer, const MessageFrame& frame)>;
+
   void InitializeRumorManager(const std::vector<std::pair<PubKey, Peer>>& peers,
                               const std::vector<PubKey>& fullNetworkKeys);
   inline static bool IsHostHavingNetworkIssue();
@@ -131,6 +157,7 @@ class P2PComm {
   using SocketCloser = std::unique_ptr<int, void (*)(int*)>;
   static Dispatcher m_dispatcher;
   static BroadcastListFunc m_broadcast_list_retriever;
+  FrameSender m_frameSender;
 
  public:
   /// Accept TCP connection for libevent usage
@@ -143,6 +170,17 @@ class P2PComm {
   void StartMessagePump(uint32_t listen_port_host, Dispatcher dispatcher,
                         BroadcastListFunc broadcast_list_retriever);
 
+  /// Runs this node over another transport, e.g. an in-process network,
+  /// instead of StartMessagePump. Outgoing frames go to the sender on the
+  /// calling thread, and incoming ones are passed to ReceiveFrame. Must be
+  /// called before the first send.
+  void SetTransport(const FrameSender& sender, Dispatcher dispatcher,
+                    BroadcastListFunc broadcast_list_retriever);
+
+  /// Processes one wire frame received from the peer the way the socket
+  /// reader does. Returns false if the frame is invalid.
+  static bool ReceiveFrame(const bytes& frame, const Peer& from);
+
   /// Multicasts message to specified list of peers.
   void SendMessage(const std::vector<Peer>& peers, const bytes& message,
                    const unsigned char& startByteType = START_BYTE_NORMAL);
@@ -170,6 +208,19 @@ class P2PComm {
       const Peer& peer, const bytes& message,
       const unsigned char& startByteType = START_BYTE_NORMAL);
 
+  /// Sends each peer a distinct erasure-coded chunk of the message, for the
+  /// peers to exchange among themselves.
+  void SendErasureCodedMessage(const std::vector<Peer>& peers,
+                               const bytes& message);
+
+  /// Sets the peers that erasure-coded chunks received from their sender are
+  /// forwarded to (the rest of this node's shard).
+  void SetErasureRelayPeers(const std::vector<Peer>& peers);
+
+  /// Sets the peers whose erasure-coded chunks may be forwarded (the current
+  /// DS committee). Relay flags from anyone else are ignored.
+  void SetErasureSenders(const std::vector<Peer>& senders);
+
   void SetSelfPeer(const Peer& self);
 
   void SetSelfKey(const PairOfKey& self);
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <snappy.h>
+#include <boost/algorithm/string.hpp>
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+#include "P2PCompression.h"
+#include "common/Constants.h"
+#include "common/MessageNames.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+P2PCompression::P2PCompression() {
+  SetCompressedKinds(COMPRESSED_MESSAGE_TYPES);
+}
+
+P2PCompression::~P2PCompression() {}
+
+P2PCompression& P2PCompression::GetInstance() {
+  static P2PCompression compression;
+  return compression;
+}
+
+P2PCompression::MessageKind P2PCompression::GetKind(
+    const unsigned char* message, size_t size) {
+  if (size <= MessageOffset::INST) {
+    return {0xFF, 0xFF};
+  }
+  return {message[MessageOffset::TYPE], message[MessageOffset::INST]};
+}
+
+string P2PCompression::GetKindName(const MessageKind& kind) {
+  if (kind.first >= ARRAY_SIZE(MessageTypeStrings)) {
+    return "UNKNOWN";
+  }
+
+  string name = MessageTypeStrings[kind.first] + ".";
+  if (MessageTypeInstructionStrings[kind.first] != NULL &&
+      kind.second < MessageTypeInstructionSize[kind.first]) {
+    name += MessageTypeInstructionStrings[kind.first][kind.second];
+  } else {
+    name += to_string(kind.second);
+  }
+  return name;
+}
+
+bool P2PCompression::SetCompressedKinds(const string& kinds) {
+  m_compressedKinds.clear();
+
+  vector<string> names;
+  boost::split(names, kinds, boost::is_any_of(","));
+
+  bool result = true;
+  for (auto& name : names) {
+    boost::trim(name);
+    if (name.empty()) {
+      continue;
+    }
+
+    bool found = false;
+    for (unsigned int type = 0; type < ARRAY_SIZE(MessageTypeStrings) && !found;
+         type++) {
+      if (MessageTypeInstructionStrings[type] == NULL) {
+        continue;
+      }
+      for (int ins = 0; ins < MessageTypeInstructionSize[type]; ins++) {
+        if (name == MessageTypeStrings[type] + "." +
+                        MessageTypeInstructionStrings[type][ins]) {
+          m_compressedKinds.emplace(type, ins);
+          found = true;
+          break;
+        }
+      }
+    }
+
+    if (!found) {
+      LOG_GENERAL(WARNING, "Unknown message type " << name
+                                                   << " in compression list");
+      result = false;
+    }
+  }
+
+  return result;
+}
+
+bool P2PCompression::Compress(const bytes& message, bytes& out) {
+  if (message.size() < COMPRESSION_MIN_SIZE_IN_BYTES) {
+    return false;
+  }
+
+  const MessageKind kind = GetKind(message.data(), message.size());
+  if (m_compressedKinds.find(kind) == m_compressedKinds.end()) {
+    return false;
+  }
+
+  const auto start = chrono::steady_clock::now();
+
+  out.resize(snappy::MaxCompressedLength(message.size()));
+  size_t compressedSize = 0;
+  snappy::RawCompress(reinterpret_cast<const char*>(message.data()),
+                      message.size(), reinterpret_cast<char*>(out.data()),
+                      &compressedSize);
+  out.resize(compressedSize);
+
+  const auto elapsed = chrono::duration_cast<chrono::microseconds>(
+                           chrono::steady_clock::now() - start)
+                           .count();
+
+  {
+    lock_guard<mutex> g(m_mutexStats);
+    Stats& stats = m_stats[kind];
+    stats.compressed++;
+    stats.rawBytes += message.size();
+    stats.compressedBytes += compressedSize;
+    stats.compressMicros += elapsed;
+  }
+
+  // Incompressible payloads go out as they are
+  return compressedSize < message.size();
+}
+
+bool P2PCompression::Decompress(const unsigned char* data, size_t size,
+                                bytes& out) {
+  const auto start = chrono::steady_clock::now();
+
+  size_t rawSize = 0;
+  if (!snappy::GetUncompressedLength(reinterpret_cast<const char*>(data), size,
+                                     &rawSize)) {
+    LOG_GENERAL(WARNING, "Corrupt compressed message header");
+    return false;
+  }
+
+  if (rawSize > MAX_MSG_SIZE_IN_BYTES) {
+    LOG_GENERAL(WARNING, "Compressed message expands to "
+                             << rawSize << " bytes, more than "
+                             << MAX_MSG_SIZE_IN_BYTES);
+    return false;
+  }
+
+  out.resize(rawSize);
+  if (!snappy::RawUncompress(reinterpret_cast<const char*>(data), size,
+                             reinterpret_cast<char*>(out.data()))) {
+    LOG_GENERAL(WARNING, "Corrupt compressed message");
+    return false;
+  }
+
+  const auto elapsed = chrono::duration_cast<chrono::microseconds>(
+                           chrono::steady_clock::now() - start)
+                           .count();
+
+  lock_guard<mutex> g(m_mutexStats);
+  Stats& stats = m_stats[GetKind(out.data(), out.size())];
+  stats.decompressed++;
+  stats.decompressMicros += elapsed;
+  return true;
+}
+
+string P2PCompression::GetAndResetStats() {
+  lock_guard<mutex> g(m_mutexStats);
+
+  ostringstream oss;
+  for (const auto& entry : m_stats) {
+    const Stats& stats = entry.second;
+    oss << "[" << GetKindName(entry.first)
+        << " Compressed: " << stats.compressed;
+    if (stats.rawBytes > 0) {
+      oss << " Ratio: "
+          << static_cast<double>(stats.compressedBytes) / stats.rawBytes;
+    }
+    oss << " CompressTime(us): " << stats.compressMicros
+        << " Decompressed: " << stats.decompressed
+        << " DecompressTime(us): " << stats.decompressMicros << "] ";
+  }
+  m_stats.clear();
+  return oss.str();
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __P2PCOMPRESSION_H__
+#define __P2PCOMPRESSION_H__
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "common/BaseType.h"
+
+/// Snappy compression of P2P message payloads. Only the message types listed
+/// in COMPRESSED_MESSAGE_TYPES and at least COMPRESSION_MIN_SIZE_IN_BYTES long
+/// are compressed. Compression ratio and CPU time are tracked per type.
+class P2PCompression {
+  using MessageKind = std::pair<unsigned char, unsigned char>;
+
+  struct Stats {
+    uint64_t compressed = 0;
+    uint64_t rawBytes = 0;
+    uint64_t compressedBytes = 0;
+    uint64_t compressMicros = 0;
+    uint64_t decompressed = 0;
+    uint64_t decompressMicros = 0;
+  };
+
+  std::set<MessageKind> m_compressedKinds;
+  std::mutex m_mutexStats;
+  std::map<MessageKind, Stats> m_stats;
+
+  P2PCompression();
+  ~P2PCompression();
+
+  // Singleton should not implement these
+  P2PCompression(P2PCompression const&) = delete;
+  void operator=(P2PCompression const&) = delete;
+
+  static MessageKind GetKind(const unsigned char* message, size_t size);
+  static std::string GetKindName(const MessageKind& kind);
+
+ public:
+  static P2PCompression& GetInstance();
+
+  /// Parses a comma-separated list of "TYPE.INSTRUCTION" names, e.g.
+  /// "NODE.FINALBLOCK,LOOKUP.SETSTATEFROMSEED"
+  bool SetCompressedKinds(const std::string& kinds);
+
+  /// Compresses the message into out if its type is enabled, it is large
+  /// enough and compression actually shrinks it
+  bool Compress(const bytes& message, bytes& out);
+
+  /// Decompresses the payload into out. Fails on corrupt input or if the
+  /// decompressed size would exceed MAX_MSG_SIZE_IN_BYTES.
+  bool Decompress(const unsigned char* data, size_t size, bytes& out);
+
+  /// Returns the per-type compression metrics and resets them
+  std::string GetAndResetStats();
+};
+
+#endif  // __P2PCOMPRESSION_H__
@@ -0,0 +1,404 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <event2/buffer.h>
+#include <event2/bufferevent.h>
+#include <event2/event.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+
+#include "Blacklist.h"
+#include "PeerSendQueue.h"
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+static bool IsHostUnreachable(int err) {
+  return (err == EHOSTUNREACH || err == EHOSTDOWN || err == ETIMEDOUT ||
+          err == ECONNREFUSED);
+}
+
+static void ReleaseFrame([[gnu::unused]] const void* data,
+                         [[gnu::unused]] size_t datalen, void* extra) {
+  delete static_cast<MessageFrame*>(extra);
+}
+
+PeerSendQueue::PeerSendQueue() {
+  if (pipe(m_wakeFds) != 0) {
+    LOG_GENERAL(WARNING, "Failed to create wake pipe. Code = "
+                             << errno << " Desc: " << std::strerror(errno));
+    return;
+  }
+
+  for (const auto& fd : m_wakeFds) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  }
+}
+
+PeerSendQueue::~PeerSendQueue() {
+  for (const auto& fd : m_wakeFds) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+}
+
+void PeerSendQueue::Run() {
+  // Writes to a closed connection must fail instead of raising SIGPIPE
+  signal(SIGPIPE, SIG_IGN);
+
+  m_base = event_base_new();
+  if (m_base == NULL) {
+    LOG_GENERAL(WARNING, "event_base_new failure.");
+    return;
+  }
+
+  struct event* wakeEvent = event_new(
+      m_base, m_wakeFds[0], EV_READ | EV_PERSIST, WakeCallback, this);
+  struct event* statsEvent =
+      event_new(m_base, -1, EV_PERSIST, StatsCallback, this);
+  if (wakeEvent == NULL || statsEvent == NULL) {
+    LOG_GENERAL(WARNING, "event_new failure.");
+    return;
+  }
+
+  struct timeval statsInterval = {
+      static_cast<time_t>(MSGQUEUE_STATS_INTERVAL_IN_SECONDS), 0};
+  event_add(wakeEvent, NULL);
+  event_add(statsEvent, &statsInterval);
+
+  // Pick up anything queued before the loop started
+  WakeCallback(m_wakeFds[0], EV_READ, this);
+
+  event_base_dispatch(m_base);
+}
+
+bool PeerSendQueue::Push(const Peer& peer,
+                         const vector<MessageFrame>& frames) {
+  if (peer.m_ipAddress == 0 && peer.m_listenPortHost == 0) {
+    LOG_GENERAL(INFO,
+                "I am sending to 0.0.0.0 at port 0. Don't send anything.");
+    return true;
+  } else if (peer.m_listenPortHost == 0) {
+    LOG_GENERAL(INFO, "I am sending to " << peer.GetPrintableIPAddress()
+                                         << " at port 0. Investigate why!");
+    return true;
+  }
+
+  if (frames.empty()) {
+    return true;
+  }
+
+  bool wake = false;
+  {
+    lock_guard<mutex> g(m_mutex);
+
+    PeerState& state = m_peers[peer];
+    if (state.owner == nullptr) {
+      state.owner = this;
+      state.peer = peer;
+    }
+
+    const bool parked = Clock::now() < state.parkedUntil;
+
+    if (parked && state.failures > MAXRETRYCONN) {
+      state.dropped += frames.size();
+      return false;
+    }
+
+    // A chunked message may take the queue past PEER_SENDQUEUE_SIZE, but is
+    // never queued partially
+    if (state.queue.size() >= PEER_SENDQUEUE_SIZE) {
+      state.dropped += frames.size();
+      LOG_GENERAL(WARNING, "Send queue for " << peer << " is full");
+      return false;
+    }
+
+    state.depthHistogram.Add(state.queue.size());
+    const auto now = Clock::now();
+    const bool resendable = frames.size() > 1;
+    for (const auto& frame : frames) {
+      state.queue.push_back({frame, now, resendable});
+    }
+
+    // An open connection picks up new frames when its current frame is
+    // written, and a parked peer is resumed by its retry timer
+    if (!state.scheduled && state.bev == nullptr && !parked) {
+      state.scheduled = true;
+      wake = m_ready.empty();
+      m_ready.push_back(&state);
+    }
+  }
+
+  if (wake) {
+    Wake();
+  }
+  return true;
+}
+
+void PeerSendQueue::Wake() {
+  const char signal = 0;
+  if (write(m_wakeFds[1], &signal, sizeof(signal)) < 0 && errno != EAGAIN) {
+    LOG_GENERAL(WARNING, "Failed to wake send loop. Code = "
+                             << errno << " Desc: " << std::strerror(errno));
+  }
+}
+
+void PeerSendQueue::StartSend(PeerState& state) {
+  if (state.queue.empty()) {
+    return;
+  }
+
+  if (state.bev == nullptr) {
+    struct sockaddr_in serv_addr;
+    memset(&serv_addr, 0, sizeof(serv_addr));
+    serv_addr.sin_family = AF_INET;
+    serv_addr.sin_addr.s_addr =
+        state.peer.m_ipAddress.convert_to<unsigned long>();
+    serv_addr.sin_port = htons(state.peer.m_listenPortHost);
+
+    state.bev = bufferevent_socket_new(
+        m_base, -1, BEV_OPT_CLOSE_ON_FREE | BEV_OPT_DEFER_CALLBACKS);
+    if (state.bev == nullptr) {
+      LOG_GENERAL(WARNING, "bufferevent_socket_new failure.");
+      OnFailure(state, 0);
+      return;
+    }
+
+    // The write timeout also bounds how long connecting can take
+    struct timeval timeout = {static_cast<time_t>(SEND_TIMEOUT_IN_SECONDS),
+                              0};
+    bufferevent_set_timeouts(state.bev, NULL, &timeout);
+    bufferevent_setcb(state.bev, NULL, WriteCallback, EventCallback, &state);
+    bufferevent_enable(state.bev, EV_WRITE);
+    state.connected = false;
+
+    if (bufferevent_socket_connect(state.bev, (struct sockaddr*)&serv_addr,
+                                   sizeof(serv_addr)) < 0) {
+      OnFailure(state, EVUTIL_SOCKET_ERROR());
+      return;
+    }
+  }
+
+  // One frame per connection: older receivers read a single frame and then
+  // close, so anything written after it would be lost
+  const MessageFrame& frame = state.queue.front().frame;
+  evbuffer_add_reference(bufferevent_get_output(state.bev), frame->data(),
+                         frame->size(), ReleaseFrame, new MessageFrame(frame));
+  state.inFlight.emplace_back(move(state.queue.front()));
+  state.queue.pop_front();
+}
+
+void PeerSendQueue::OnFailure(PeerState& state, int err, bool timedOut) {
+  if (state.bev != nullptr) {
+    bufferevent_free(state.bev);
+    state.bev = nullptr;
+  }
+
+  if (state.connected) {
+    // The frame may already have been delivered, so only chunks are resent:
+    // the receiver drops the ones it already has
+    LOG_GENERAL(WARNING, "Socket write to "
+                             << state.peer << " failed. Code = " << err
+                             << " Desc: "
+                             << evutil_socket_error_to_string(err));
+    auto resend = stable_partition(
+        state.inFlight.begin(), state.inFlight.end(),
+        [](const QueuedFrame& queued) { return queued.resendable; });
+    state.dropped += distance(resend, state.inFlight.end());
+    state.queue.insert(state.queue.begin(),
+                       make_move_iterator(state.inFlight.begin()),
+                       make_move_iterator(resend));
+  } else {
+    LOG_GENERAL(WARNING, "Socket connect to "
+                             << state.peer << " failed. Code = " << err
+                             << " Desc: "
+                             << evutil_socket_error_to_string(err));
+    state.queue.insert(state.queue.begin(),
+                       make_move_iterator(state.inFlight.begin()),
+                       make_move_iterator(state.inFlight.end()));
+    state.connectFailures++;
+  }
+  state.inFlight.clear();
+  state.connected = false;
+  state.failures++;
+
+  // A peer that is merely slow to accept or drain is backed off, not
+  // blacklisted
+  if (!timedOut && IsHostUnreachable(err)) {
+    LOG_GENERAL(WARNING, "[blacklist] Encountered "
+                             << err << " ("
+                             << evutil_socket_error_to_string(err)
+                             << "). Adding "
+                             << state.peer.GetPrintableIPAddress()
+                             << " to blacklist");
+    Blacklist::GetInstance().Add(state.peer.m_ipAddress);
+    state.dropped += state.queue.size();
+    state.queue.clear();
+  } else if (state.failures > MAXRETRYCONN) {
+    LOG_GENERAL(WARNING, "Socket connect to " << state.peer << " failed over "
+                                              << MAXRETRYCONN
+                                              << " times. Dropping "
+                                              << state.queue.size()
+                                              << " queued messages.");
+    state.dropped += state.queue.size();
+    state.queue.clear();
+  }
+
+  const unsigned int shift = min(state.failures - 1, 16u);
+  const chrono::milliseconds backoff(
+      min(static_cast<uint64_t>(SEND_BACKOFF_BASE_IN_MILLISECONDS) << shift,
+          static_cast<uint64_t>(SEND_BACKOFF_MAX_IN_MILLISECONDS)));
+  state.parkedUntil = Clock::now() + backoff;
+
+  if (state.retryTimer == nullptr) {
+    state.retryTimer = evtimer_new(m_base, RetryCallback, &state);
+  }
+  struct timeval tv = {
+      static_cast<time_t>(backoff.count() / 1000),
+      static_cast<suseconds_t>((backoff.count() % 1000) * 1000)};
+  evtimer_add(state.retryTimer, &tv);
+}
+
+void PeerSendQueue::LogAndResetStats() {
+  for (auto it = m_peers.begin(); it != m_peers.end();) {
+    PeerState& state = it->second;
+
+    if (state.sentFrames > 0 || state.dropped > 0 ||
+        state.connectFailures > 0) {
+      LOG_GENERAL(INFO, "[PeerSendQueue] "
+                            << state.peer << " Queued: " << state.queue.size()
+                            << " Sent: " << state.sentFrames
+                            << " Bytes: " << state.sentBytes
+                            << " Dropped: " << state.dropped
+                            << " ConnectFailures: " << state.connectFailures
+                            << " Depth: " << state.depthHistogram.ToString()
+                            << "Latency(us): "
+                            << state.latencyHistogram.ToString());
+    }
+    state.sentFrames = 0;
+    state.sentBytes = 0;
+    state.dropped = 0;
+    state.connectFailures = 0;
+    state.depthHistogram.Clear();
+    state.latencyHistogram.Clear();
+
+    // Forget peers that have nothing pending and are not parked
+    const bool idle = state.queue.empty() && state.bev == nullptr &&
+                      !state.scheduled &&
+                      Clock::now() >= state.parkedUntil &&
+                      (state.retryTimer == nullptr ||
+                       !evtimer_pending(state.retryTimer, NULL));
+    if (idle) {
+      if (state.retryTimer != nullptr) {
+        event_free(state.retryTimer);
+      }
+      it = m_peers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void PeerSendQueue::WakeCallback(evutil_socket_t fd,
+                                 [[gnu::unused]] short events, void* ctx) {
+  PeerSendQueue* self = static_cast<PeerSendQueue*>(ctx);
+
+  char buf[64];
+  while (read(fd, buf, sizeof(buf)) > 0) {
+  }
+
+  lock_guard<mutex> g(self->m_mutex);
+  vector<PeerState*> ready;
+  ready.swap(self->m_ready);
+  for (auto state : ready) {
+    state->scheduled = false;
+    if (state->bev == nullptr && Clock::now() >= state->parkedUntil) {
+      self->StartSend(*state);
+    }
+  }
+}
+
+void PeerSendQueue::WriteCallback([[gnu::unused]] struct bufferevent* bev,
+                                  void* ctx) {
+  PeerState& state = *static_cast<PeerState*>(ctx);
+  PeerSendQueue* self = state.owner;
+
+  lock_guard<mutex> g(self->m_mutex);
+
+  // The frame has been handed to the kernel
+  const auto now = Clock::now();
+  for (const auto& queued : state.inFlight) {
+    state.latencyHistogram.Add(
+        chrono::duration_cast<chrono::microseconds>(now - queued.queued)
+            .count());
+    state.sentBytes += queued.frame->size();
+  }
+  state.sentFrames += state.inFlight.size();
+  state.inFlight.clear();
+  state.failures = 0;
+
+  bufferevent_free(state.bev);
+  state.bev = nullptr;
+  state.connected = false;
+
+  if (!state.queue.empty()) {
+    self->StartSend(state);
+  }
+}
+
+void PeerSendQueue::EventCallback([[gnu::unused]] struct bufferevent* bev,
+                                  short events, void* ctx) {
+  PeerState& state = *static_cast<PeerState*>(ctx);
+  PeerSendQueue* self = state.owner;
+
+  lock_guard<mutex> g(self->m_mutex);
+
+  if (events & BEV_EVENT_CONNECTED) {
+    state.connected = true;
+    return;
+  }
+
+  const bool timedOut = (events & BEV_EVENT_TIMEOUT) != 0;
+  self->OnFailure(state, timedOut ? ETIMEDOUT : EVUTIL_SOCKET_ERROR(),
+                  timedOut);
+}
+
+void PeerSendQueue::RetryCallback([[gnu::unused]] evutil_socket_t fd,
+                                  [[gnu::unused]] short events, void* ctx) {
+  PeerState& state = *static_cast<PeerState*>(ctx);
+  PeerSendQueue* self = state.owner;
+
+  lock_guard<mutex> g(self->m_mutex);
+  if (state.bev == nullptr) {
+    self->StartSend(state);
+  }
+}
+
+void PeerSendQueue::StatsCallback([[gnu::unused]] evutil_socket_t fd,
+                                  [[gnu::unused]] short events, void* ctx) {
+  PeerSendQueue* self = static_cast<PeerSendQueue*>(ctx);
+
+  lock_guard<mutex> g(self->m_mutex);
+  self->LogAndResetStats();
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PEERSENDQUEUE_H__
+#define __PEERSENDQUEUE_H__
+
+#include <event2/util.h>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Peer.h"
+#include "common/BaseType.h"
+#include "libUtils/BlockingQueue.h"
+
+struct bufferevent;
+struct event;
+struct event_base;
+
+/// Immutable wire frame (header, broadcast hash and payload), built once and
+/// shared by every peer a message is sent to
+using MessageFrame = std::shared_ptr<const bytes>;
+
+/// Bounded outbound queue per peer, written asynchronously by a dedicated
+/// libevent loop. Each frame goes over its own connection, as receivers
+/// before this queue read one frame per connection. A peer that cannot be
+/// reached or that times out is parked with exponential backoff and, once it
+/// has failed MAXRETRYCONN times in a row, its frames are dropped until the
+/// backoff expires, so a slow or dead peer never holds up sends to the
+/// others.
+class PeerSendQueue {
+  using Clock = std::chrono::steady_clock;
+
+  struct QueuedFrame {
+    MessageFrame frame;
+    Clock::time_point queued;
+    bool resendable;
+  };
+
+  struct PeerState {
+    PeerSendQueue* owner = nullptr;
+    Peer peer;
+    std::deque<QueuedFrame> queue;
+    std::vector<QueuedFrame> inFlight;
+    struct bufferevent* bev = nullptr;
+    struct event* retryTimer = nullptr;
+    bool connected = false;
+    bool scheduled = false;
+    unsigned int failures = 0;
+    Clock::time_point parkedUntil;
+
+    // Metrics, reset every MSGQUEUE_STATS_INTERVAL_IN_SECONDS
+    uint64_t sentFrames = 0;
+    uint64_t sentBytes = 0;
+    uint64_t dropped = 0;
+    uint64_t connectFailures = 0;
+    Log2Histogram depthHistogram;
+    Log2Histogram latencyHistogram;
+  };
+
+  std::mutex m_mutex;
+  std::map<Peer, PeerState> m_peers;
+  std::vector<PeerState*> m_ready;
+  struct event_base* m_base = nullptr;
+  int m_wakeFds[2] = {-1, -1};
+
+  void Wake();
+  void StartSend(PeerState& state);
+  /// timedOut: the connect or write ran past SEND_TIMEOUT_IN_SECONDS
+  void OnFailure(PeerState& state, int err, bool timedOut = false);
+  void LogAndResetStats();
+
+  static void WakeCallback(evutil_socket_t fd, short events, void* ctx);
+  static void WriteCallback(struct bufferevent* bev, void* ctx);
+  static void EventCallback(struct bufferevent* bev, short events, void* ctx);
+  static void RetryCallback(evutil_socket_t fd, short events, void* ctx);
+  static void StatsCallback(evutil_socket_t fd, short events, void* ctx);
+
+ public:
+  PeerSendQueue();
+  ~PeerSendQueue();
+
+  PeerSendQueue(PeerSendQueue const&) = delete;
+  void operator=(PeerSendQueue const&) = delete;
+
+  /// Runs the send event loop. Does not return.
+  void Run();
+
+  /// Queues the frames of one message for the peer. Returns false if they were
+  /// dropped because the peer's queue is full or the peer is unreachable.
+  /// A message carried by several frames (chunks) is queued whole, and chunks
+  /// interrupted by a broken connection are resent on the next one.
+  bool Push(const Peer& peer, const std::vector<MessageFrame>& frames);
+};
+
+#endif  // __PEERSENDQUEUE_H__
@@ -61,29 +61,32 @@ void ReputationManager::AddNodeIfNotKnown(
 
 void ReputationManager::AddNodeIfNotKnownInternal(
     const boost::multiprecision::uint128_t& IPAddress) {
-  if (m_Reputations.find(IPAddress) == m_Reputations.end()) {
-    m_Reputations.emplace(IPAddress, ScoreType::GOOD);
-  }
+  m_Reputations.Insert(IPAddress, ScoreType::GOOD);
 }
 
 int32_t ReputationManager::GetReputation(
     const boost::multiprecision::uint128_t& IPAddress) {
+  int32_t reputation;
+  if (m_Reputations.Find(IPAddress, reputation)) {
+    return reputation;
+  }
+
   std::lock_guard<std::mutex> lock(m_mutexReputations);
   AddNodeIfNotKnownInternal(IPAddress);
-  return m_Reputations[IPAddress];
+  m_Reputations.Find(IPAddress, reputation);
+  return reputation;
 }
 
 void ReputationManager::Clear() {
   LOG_MARKER();
   std::lock_guard<std::mutex> lock(m_mutexReputations);
-  m_Reputations.clear();
+  m_Reputations.Clear();
 }
 
 void ReputationManager::SetReputation(
     const boost::multiprecision::uint128_t& IPAddress,
     const int32_t ReputationScore) {
   std::lock_guard<std::mutex> lock(m_mutexReputations);
-  AddNodeIfNotKnownInternal(IPAddress);
 
   if (ReputationScore > ScoreType::UPPERREPTHRESHOLD) {
     LOG_GENERAL(
@@ -91,11 +94,11 @@ void ReputationManager::SetReputation(
         "Reputation score too high. Exceed upper bound. ReputationScore: "
             << ReputationScore << ". Setting reputation to "
             << ScoreType::UPPERREPTHRESHOLD);
-    m_Reputations[IPAddress] = ScoreType::UPPERREPTHRESHOLD;
+    m_Reputations.Set(IPAddress, ScoreType::UPPERREPTHRESHOLD);
     return;
   }
 
-  m_Reputations[IPAddress] = ReputationScore;
+  m_Reputations.Set(IPAddress, ReputationScore);
 }
 
 void ReputationManager::UpdateReputation(
@@ -122,12 +125,7 @@ void ReputationManager::UpdateReputation(
 std::vector<boost::multiprecision::uint128_t>
 ReputationManager::GetAllKnownIP() {
   std::lock_guard<std::mutex> lock(m_mutexReputations);
-
-  std::vector<boost::multiprecision::uint128_t> AllKnownIPs;
-  for (const auto& node : m_Reputations) {
-    AllKnownIPs.emplace_back(node.first);
-  }
-  return AllKnownIPs;
+  return m_Reputations.Keys();
 }
 
 void ReputationManager::AwardNode(
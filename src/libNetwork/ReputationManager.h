@@ -18,29 +18,14 @@
 #ifndef __REPUTATION_MANAGER_H__
 #define __REPUTATION_MANAGER_H__
 
+#include "IPTable.h"
 #include "Peer.h"
 #include "common/Constants.h"
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#include <boost/multiprecision/cpp_int.hpp>
-#pragma GCC diagnostic pop
-#include <functional>
 #include <mutex>
-#include <unordered_map>
 #include <vector>
 
 class ReputationManager {
-  // Custom hasher
-  // Ref:
-  // https://stackoverflow.com/questions/32082786/why-i-cannot-use-neither-stdunordered-map-nor-boostunordered-map-with-boost
-  template <typename T>
-  struct hash_str {
-    size_t operator()(const T& t) const {
-      return std::hash<std::string>()(t.str());
-    }
-  };
-
   ReputationManager();
   ~ReputationManager();
 
@@ -76,9 +61,8 @@ class ReputationManager {
   std::mutex m_mutexReputations;
 
  private:
-  std::unordered_map<boost::multiprecision::uint128_t, int32_t,
-                     hash_str<boost::multiprecision::uint128_t>>
-      m_Reputations;
+  // Reads are lock-free, m_mutexReputations orders the updates
+  IPTable<int32_t> m_Reputations;
 
   void AddNodeIfNotKnownInternal(
       const boost::multiprecision::uint128_t& IPAddress);
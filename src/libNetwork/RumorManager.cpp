@@ -36,27 +36,97 @@ RRS::Message::Type convertType(uint8_t type) {
   }
 }
 
+const unsigned int HASH_LEN = COMMON_HASH_SIZE;
+
 }  // anonymous namespace
 
+const unsigned int RumorManager::MAX_BATCH_ENTRIES;
+const unsigned int RumorManager::MAX_SUBSCRIPTIONS_PER_PEER;
+
 // CONSTRUCTORS
 RumorManager::RumorManager()
     : m_peerIdPeerBimap(),
       m_peerIdSet(),
-      m_rumorIdHashBimap(),
-      m_rumorHashRawMsgBimap(),
       m_selfPeer(),
       m_selfKey(),
-      m_rumorRawMsgTimestamp(),
-      m_rumorIdGenerator(0),
-      m_mutex(),
       m_continueRoundMutex(),
       m_continueRound(false),
-      m_condStopRound() {}
+      m_condRoundThread() {}
 
 RumorManager::~RumorManager() {}
 
 // PRIVATE METHODS
 
+bool RumorManager::SubscribeLocked(RumorStripe& stripe, const RawBytes& hash,
+                                   const Peer& peer) {
+  auto it = stripe.hashesSubscriberMap.find(hash);
+  if (it != stripe.hashesSubscriberMap.end() && it->second.count(peer) > 0) {
+    return true;
+  }
+
+  std::lock_guard<std::mutex> guard(m_subscriptionsMutex);
+  unsigned int& count = m_subscriptionsPerPeer[peer];
+  if (count >= MAX_SUBSCRIPTIONS_PER_PEER) {
+    return false;
+  }
+  stripe.hashesSubscriberMap[hash].insert(peer);
+  count++;
+  return true;
+}
+
+void RumorManager::Unsubscribe(const std::set<Peer>& peers) {
+  std::lock_guard<std::mutex> guard(m_subscriptionsMutex);
+  for (const auto& peer : peers) {
+    auto it = m_subscriptionsPerPeer.find(peer);
+    if (it != m_subscriptionsPerPeer.end() && --it->second == 0) {
+      m_subscriptionsPerPeer.erase(it);
+    }
+  }
+}
+
+unsigned int RumorManager::StripeIndex(const RawBytes& hash) {
+  return hash.empty() ? 0 : hash.front() & (NUM_STRIPES - 1);
+}
+
+RumorManager::RumorStripe& RumorManager::StripeOfHash(const RawBytes& hash) {
+  return m_stripes[StripeIndex(hash)];
+}
+
+RumorManager::RumorStripe& RumorManager::StripeOfId(int rumorId) {
+  return m_stripes[rumorId & (NUM_STRIPES - 1)];
+}
+
+int RumorManager::GetOrAddRumorIdLocked(RumorStripe& stripe,
+                                        const RawBytes& hash) {
+  auto it = stripe.rumorIdHashBimap.right.find(hash);
+  if (it != stripe.rumorIdHashBimap.right.end()) {
+    return it->second;
+  }
+
+  const int rumorId =
+      (++stripe.rumorIdGenerator << STRIPE_BITS) | StripeIndex(hash);
+  stripe.rumorIdHashBimap.insert(RumorIdRumorBimap::value_type(rumorId, hash));
+  return rumorId;
+}
+
+bool RumorManager::GetRumorHash(int rumorId, RawBytes& hash) {
+  RumorStripe& stripe = StripeOfId(rumorId);
+  std::lock_guard<std::mutex> guard(stripe.mutex);
+  auto it = stripe.rumorIdHashBimap.left.find(rumorId);
+  if (it == stripe.rumorIdHashBimap.left.end()) {
+    return false;
+  }
+  hash = it->second;
+  return true;
+}
+
+void RumorManager::WakeRoundThread() {
+  // Taking the mutex orders this with the round thread checking the inbox
+  // before it sleeps, so the wake-up cannot be lost
+  std::lock_guard<std::mutex> guard(m_continueRoundMutex);
+  m_condRoundThread.notify_one();
+}
+
 void RumorManager::StartRounds() {
   LOG_MARKER();
 
@@ -68,33 +138,30 @@ void RumorManager::StartRounds() {
 
   std::thread([&]() {
     unsigned int rounds = 0;
+    auto nextRound = std::chrono::steady_clock::now();
     while (true) {
-      std::unique_lock<std::mutex> guard(m_continueRoundMutex);
-      m_continueRound = true;
-      {  // critical section
-        std::lock_guard<std::mutex> guard(m_mutex);
-        std::pair<std::vector<int>, std::vector<RRS::Message>> result =
-            m_rumorHolder->advanceRound();
-
-        LOG_GENERAL(DEBUG, "Sending " << result.second.size()
-                                      << " push messages to "
-                                      << result.first.size() << " peers");
-
-        // Get the corresponding Peer to which to send Push Messages if any.
-        for (const auto& i : result.first) {
-          auto l = m_peerIdPeerBimap.left.find(i);
-          if (l != m_peerIdPeerBimap.left.end()) {
-            SendMessages(l->second, result.second);
+      {
+        std::shared_lock<std::shared_timed_mutex> guard(m_peersMutex);
+        ProcessInbox();
+
+        if (std::chrono::steady_clock::now() >= nextRound) {
+          AdvanceRound();
+          if (++rounds % KEEP_RAWMSG_FROM_LAST_N_ROUNDS == 0) {
+            CleanUp();
+            rounds = 0;
           }
+          nextRound =
+              std::chrono::steady_clock::now() +
+              std::chrono::milliseconds(m_rumorHolder->roundTimeInMs());
         }
-        if (++rounds % KEEP_RAWMSG_FROM_LAST_N_ROUNDS == 0) {
-          CleanUp();
-          rounds = 0;
-        }
-      }  // end critical section
-      if (m_condStopRound.wait_for(guard,
-                                   std::chrono::milliseconds(ROUND_TIME_IN_MS),
-                                   [&] { return !m_continueRound; })) {
+      }
+
+      // Sleep until the next round, or until messages arrive for RumorHolder
+      std::unique_lock<std::mutex> guard(m_continueRoundMutex);
+      m_condRoundThread.wait_until(guard, nextRound, [&] {
+        return !m_continueRound || !m_inbox.empty();
+      });
+      if (!m_continueRound) {
         LOG_GENERAL(INFO, "Stopping round now..");
         return;
       }
@@ -109,7 +176,57 @@ void RumorManager::StopRounds() {
     std::lock_guard<std::mutex> guard(m_continueRoundMutex);
     m_continueRound = false;
   }
-  m_condStopRound.notify_all();
+  m_condRoundThread.notify_all();
+}
+
+void RumorManager::AdvanceRound() {
+  std::pair<std::vector<int>, std::vector<RRS::Message>> result =
+      m_rumorHolder->advanceRound();
+
+  LOG_GENERAL(DEBUG, "Sending " << result.second.size()
+                                << " push messages to " << result.first.size()
+                                << " peers");
+
+  // Get the corresponding Peer to which to send Push Messages if any.
+  for (const auto& i : result.first) {
+    auto l = m_peerIdPeerBimap.left.find(i);
+    if (l != m_peerIdPeerBimap.left.end()) {
+      if (GOSSIP_DIGEST_MODE) {
+        SendDigests(l->second, result.second);
+      } else {
+        SendMessages(l->second, result.second);
+      }
+    }
+  }
+
+  if (GOSSIP_DIGEST_MODE) {
+    LogAndResetDigestStats();
+    for (auto& stripe : m_stripes) {
+      std::lock_guard<std::mutex> guard(stripe.mutex);
+      stripe.wantedInRound.clear();
+    }
+  }
+}
+
+void RumorManager::ProcessInbox() {
+  std::vector<InboxEntry> entries;
+  m_inbox.TakeAll(entries);
+
+  for (const auto& entry : entries) {
+    std::pair<int, std::vector<RRS::Message>> pullMsgs =
+        m_rumorHolder->receivedMessage(entry.message, entry.peerId);
+
+    LOG_GENERAL(DEBUG, "Sending " << pullMsgs.second.size()
+                                  << " EMPTY_PULL or LAZY_PULL Messages");
+
+    if (GOSSIP_DIGEST_MODE) {
+      SendDigests(entry.from, pullMsgs.second);
+    } else {
+      SendMessages(entry.from, pullMsgs.second);
+    }
+  }
+
+  m_inboxProcessed += entries.size();
 }
 
 // PUBLIC METHODS
@@ -128,20 +245,35 @@ bool RumorManager::Initialize(const std::vector<std::pair<PubKey, Peer>>& peers,
     }
   }
 
-  std::lock_guard<std::mutex> guard(m_mutex);  // critical section
+  std::lock_guard<std::shared_timed_mutex> guard(
+      m_peersMutex);  // critical section
 
-  if (m_rumorIdGenerator) {
+  if (m_rumorHolder && !m_rumorHolder->rumorsMap().empty()) {
     PrintStatistics();
   }
 
-  m_rumorIdGenerator = 0;
+  for (auto& stripe : m_stripes) {
+    std::lock_guard<std::mutex> stripeGuard(stripe.mutex);
+    stripe.rumorIdGenerator = 0;
+    stripe.rumorIdHashBimap.clear();
+    stripe.rumorHashRawMsgBimap.clear();
+    stripe.hashesSubscriberMap.clear();
+    stripe.rumorRawMsgTimestamp.clear();
+    stripe.wantedInRound.clear();
+  }
+  {
+    std::lock_guard<std::mutex> subscriptionsGuard(m_subscriptionsMutex);
+    m_subscriptionsPerPeer.clear();
+  }
+
+  // Drop whatever was received for the previous peer set
+  std::vector<InboxEntry> stale;
+  m_inbox.TakeAll(stale);
+
   m_peerIdPeerBimap.clear();
-  m_rumorIdHashBimap.clear();
   m_peerIdSet.clear();
   m_selfPeer = myself;
   m_selfKey = myKeys;
-  m_rumorHashRawMsgBimap.clear();
-  m_rumorRawMsgTimestamp.clear();
   m_fullNetworkKeys.clear();
   m_pubKeyPeerBiMap.clear();
 
@@ -166,6 +298,14 @@ bool RumorManager::Initialize(const std::vector<std::pair<PubKey, Peer>>& peers,
     m_rumorHolder.reset(new RRS::RumorHolder(m_peerIdSet, 0));
   }
 
+  if (GOSSIP_ADAPTIVE_MODE) {
+    // Round time only ever shrinks from ROUND_TIME_IN_MS and the round
+    // limits stay within the ones above, so the expiry below still holds
+    m_rumorHolder->enableAdaptiveMode(
+        GOSSIP_TARGET_CONVERGENCE_IN_MS, GOSSIP_MIN_ROUND_TIME_IN_MS,
+        ROUND_TIME_IN_MS, GOSSIP_ADAPTIVE_MAX_NEIGHBORS);
+  }
+
   // RawMessage older than below expiry will be cleared.
   // Its calculated as (last KEEP_RAWMSG_FROM_LAST_N_ROUNDS rounds X each ROUND
   // time)
@@ -179,11 +319,17 @@ bool RumorManager::Initialize(const std::vector<std::pair<PubKey, Peer>>& peers,
 
 void RumorManager::SpreadBufferedRumors() {
   LOG_MARKER();
-  if (m_continueRound) {
-    for (const auto& i : m_bufferRawMsg) {
-      AddRumor(i);
+  std::vector<RawBytes> buffered;
+  {
+    std::lock_guard<std::mutex> guard(m_continueRoundMutex);
+    if (!m_continueRound) {
+      return;
     }
-    m_bufferRawMsg.clear();
+    buffered.swap(m_bufferRawMsg);
+  }
+
+  for (const auto& i : buffered) {
+    AddRumor(i);
   }
 }
 
@@ -192,11 +338,15 @@ bool RumorManager::AddForeignRumor(const RumorManager::RawBytes& message) {
   PubKey senderPubKey;
   senderPubKey.Deserialize(message, 0);
 
-  if (find(m_fullNetworkKeys.begin(), m_fullNetworkKeys.end(), senderPubKey) ==
-      m_fullNetworkKeys.end()) {
-    LOG_GENERAL(WARNING,
-                "Sender not from known network peer list. so ignoring message");
-    return false;
+  {
+    std::shared_lock<std::shared_timed_mutex> guard(m_peersMutex);
+    if (find(m_fullNetworkKeys.begin(), m_fullNetworkKeys.end(),
+             senderPubKey) == m_fullNetworkKeys.end()) {
+      LOG_GENERAL(
+          WARNING,
+          "Sender not from known network peer list. so ignoring message");
+      return false;
+    }
   }
 
   // verify if signature matches the one in message.
@@ -240,41 +390,43 @@ bool RumorManager::AddRumor(const RumorManager::RawBytes& message) {
       }
     }
 
-    std::lock_guard<std::mutex> guard(m_mutex);  // critical section
+    std::shared_lock<std::shared_timed_mutex> guard(m_peersMutex);
 
     if (m_peerIdSet.empty()) {
       return true;
     }
 
-    auto it = m_rumorIdHashBimap.right.find(hash);
-    if (it == m_rumorIdHashBimap.right.end()) {
-      m_rumorIdHashBimap.insert(
-          RumorIdRumorBimap::value_type(++m_rumorIdGenerator, hash));
+    int rumorId = -1;
+    {
+      RumorStripe& stripe = StripeOfHash(hash);
+      std::lock_guard<std::mutex> stripeGuard(stripe.mutex);
 
-      auto result = m_rumorHashRawMsgBimap.insert(
+      if (stripe.rumorIdHashBimap.right.find(hash) !=
+          stripe.rumorIdHashBimap.right.end()) {
+        LOG_GENERAL(DEBUG, "This Rumor was already received. No problem.");
+        return false;
+      }
+      rumorId = GetOrAddRumorIdLocked(stripe, hash);
+
+      auto result = stripe.rumorHashRawMsgBimap.insert(
           RumorHashRumorBiMap::value_type(hash, message));
+      if (!result.second) {
+        return false;
+      }
 
-      if (result.second) {
-        // add the timestamp for this raw rumor message
-        m_rumorRawMsgTimestamp.push_back(std::make_pair(
-            result.first, std::chrono::high_resolution_clock::now()));
+      // add the timestamp for this raw rumor message
+      stripe.rumorRawMsgTimestamp.push_back(std::make_pair(
+          result.first, std::chrono::high_resolution_clock::now()));
+    }
 
-        std::string output;
-        if (!DataConversion::Uint8VecToHexStr(hash, output)) {
-          return false;
-        }
-        LOG_PAYLOAD(INFO,
-                    "New Gossip message initiated by me ("
-                        << m_selfPeer << "): [ RumorId: " << m_rumorIdGenerator
-                        << ", Current Round: 0, Gossip_Message_Hash: "
-                        << output.substr(0, 6) << " ]",
-                    message, Logger::MAX_BYTES_TO_DISPLAY);
+    LOG_PAYLOAD(INFO,
+                "New Gossip message initiated by me ("
+                    << m_selfPeer << "): [ RumorId: " << rumorId
+                    << ", Current Round: 0, Gossip_Message_Hash: "
+                    << output.substr(0, 6) << " ]",
+                message, Logger::MAX_BYTES_TO_DISPLAY);
 
-        return m_rumorHolder->addRumor(m_rumorIdGenerator);
-      }
-    } else {
-      LOG_GENERAL(DEBUG, "This Rumor was already received. No problem.");
-    }
+    return m_rumorHolder->addRumor(rumorId);
   }
 
   return false;
@@ -282,6 +434,8 @@ bool RumorManager::AddRumor(const RumorManager::RawBytes& message) {
 
 RumorManager::RawBytes RumorManager::GenerateGossipForwardMessage(
     const RawBytes& message) {
+  std::shared_lock<std::shared_timed_mutex> guard(m_peersMutex);
+
   // Add round and type to outgoing message
   RawBytes cmd = {(unsigned char)RRS::Message::Type::FORWARD};
   unsigned int cur_offset = RRSMessageOffset::R_ROUNDS;
@@ -354,6 +508,7 @@ void RumorManager::SendRumorToForeignPeer(const Peer& toForeignPeer,
   P2PComm::GetInstance().SendMessage(toForeignPeer, cmd, START_BYTE_GOSSIP);
 }
 
+
 std::pair<bool, RumorManager::RawBytes> RumorManager::VerifyMessage(
     const RawBytes& message, const RRS::Message::Type& t, const Peer& from) {
   bytes message_wo_keysig;
@@ -363,7 +518,8 @@ std::pair<bool, RumorManager::RawBytes> RumorManager::VerifyMessage(
        SIGN_VERIFY_EMPTY_MSGTYP) ||
       ((RRS::Message::Type::LAZY_PUSH == t ||
         RRS::Message::Type::LAZY_PULL == t || RRS::Message::Type::PUSH == t ||
-        RRS::Message::Type::PULL == t) &&
+        RRS::Message::Type::PULL == t || RRS::Message::Type::IHAVE == t ||
+        RRS::Message::Type::IWANT == t) &&
        SIGN_VERIFY_NONEMPTY_MSGTYP)) {
     // verify if the pubkey is from with-in our network
     PubKey senderPubKey;
@@ -409,15 +565,12 @@ std::pair<bool, RumorManager::RawBytes> RumorManager::VerifyMessage(
 
 std::pair<bool, RumorManager::RawBytes> RumorManager::RumorReceived(
     uint8_t type, int32_t round, const RawBytes& message, const Peer& from) {
-  {
-    std::lock_guard<std::mutex> guard(m_continueRoundMutex);
-    if (!m_continueRound) {
-      // LOG_GENERAL(WARNING, "Round is not running. Ignoring message!!")
-      return {false, {}};
-    }
+  if (!m_continueRound) {
+    // LOG_GENERAL(WARNING, "Round is not running. Ignoring message!!")
+    return {false, {}};
   }
 
-  std::lock_guard<std::mutex> guard(m_mutex);
+  std::shared_lock<std::shared_timed_mutex> guard(m_peersMutex);
 
   auto p = m_peerIdPeerBimap.right.find(from);
   if (p == m_peerIdPeerBimap.right.end()) {
@@ -427,9 +580,10 @@ std::pair<bool, RumorManager::RawBytes> RumorManager::RumorReceived(
     return {false, {}};
   }
 
-  int64_t recvdRumorId = -1;
+  int recvdRumorId = -1;
   RRS::Message::Type t = convertType(type);
   bool toBeDispatched = false;
+  Replies replies;
 
   auto result = VerifyMessage(message, t, from);
   if (!result.first) {
@@ -439,89 +593,121 @@ std::pair<bool, RumorManager::RawBytes> RumorManager::RumorReceived(
 
   // All checks passed. Good to accept this rumor
 
-  if (RRS::Message::Type::EMPTY_PUSH == t ||
-      RRS::Message::Type::EMPTY_PULL == t) {
+  if (RRS::Message::Type::IHAVE == t) {
+    ProcessDigests(message_wo_keysig, from, p->second);
+    return {false, {}};
+  } else if (RRS::Message::Type::IWANT == t) {
+    ProcessWants(message_wo_keysig, from);
+    return {false, {}};
+  } else if (RRS::Message::Type::EMPTY_PUSH == t ||
+             RRS::Message::Type::EMPTY_PULL == t) {
     /* Don't add it to local RumorMap because it's not the rumor itself */
     LOG_GENERAL(DEBUG, "Received empty message of type: "
                            << RRS::Message::s_enumKeyToString[t]);
   } else if (RRS::Message::Type::LAZY_PUSH == t ||
              RRS::Message::Type::LAZY_PULL == t) {
-    auto it = m_rumorIdHashBimap.right.find(message_wo_keysig);
-    if (it == m_rumorIdHashBimap.right.end()) {
-      recvdRumorId = ++m_rumorIdGenerator;
+    RumorStripe& stripe = StripeOfHash(message_wo_keysig);
+    std::lock_guard<std::mutex> stripeGuard(stripe.mutex);
 
-      m_rumorIdHashBimap.insert(
-          RumorIdRumorBimap::value_type(recvdRumorId, message_wo_keysig));
+    auto it = stripe.rumorIdHashBimap.right.find(message_wo_keysig);
+    if (it == stripe.rumorIdHashBimap.right.end()) {
+      recvdRumorId = GetOrAddRumorIdLocked(stripe, message_wo_keysig);
 
       // Now that's the new hash message. So we dont have the real message.
       // So lets ask the sender for it.
-      RRS::Message pullMsg(RRS::Message::Type::PULL, recvdRumorId, -1);
-      SendMessage(from, pullMsg);
+      replies.emplace_back(
+          from, RRS::Message(RRS::Message::Type::PULL, recvdRumorId, -1));
     } else {
       recvdRumorId = it->second;
       LOG_GENERAL(DEBUG, "Old Gossip hash message received from "
                              << from << ". [ RumorId: " << recvdRumorId
                              << ", Current Round: " << round);
       // check if we have received the real message for this old rumor.
-      auto it = m_rumorHashRawMsgBimap.left.find(message_wo_keysig);
-      if (it == m_rumorHashRawMsgBimap.left.end()) {
+      if (stripe.rumorHashRawMsgBimap.left.find(message_wo_keysig) ==
+          stripe.rumorHashRawMsgBimap.left.end()) {
         // didn't receive real message (PUSH) yet :( Lets ask this peer.
-        RRS::Message pullMsg(RRS::Message::Type::PULL, recvdRumorId, -1);
-        SendMessage(from, pullMsg);
+        replies.emplace_back(
+            from, RRS::Message(RRS::Message::Type::PULL, recvdRumorId, -1));
       }
     }
   } else if (RRS::Message::Type::PULL == t) {
-    // Now that sender wants the real message, lets send it to him.
-    auto it1 = m_rumorHashRawMsgBimap.left.find(message_wo_keysig);
-    if (it1 != m_rumorHashRawMsgBimap.left.end()) {
-      auto it2 = m_rumorIdHashBimap.right.find(message_wo_keysig);
-      if (it2 != m_rumorIdHashBimap.right.end()) {
-        recvdRumorId = it2->second;
-        RRS::Message pushMsg(RRS::Message::Type::PUSH, recvdRumorId, -1);
-        SendMessage(from, pushMsg);
-      }
-    } else  // I dont have it as of now. Add this peer to subscriber list for
-            // this hash message.
     {
-      auto it2 = m_hashesSubscriberMap.find(message_wo_keysig);
-      if (it2 == m_hashesSubscriberMap.end()) {
-        m_hashesSubscriberMap.insert(RumorHashesPeersMap::value_type(
-            message_wo_keysig, std::set<Peer>()));
+      RumorStripe& stripe = StripeOfHash(message_wo_keysig);
+      std::lock_guard<std::mutex> stripeGuard(stripe.mutex);
+
+      // Now that sender wants the real message, lets send it to him.
+      auto it1 = stripe.rumorHashRawMsgBimap.left.find(message_wo_keysig);
+      if (it1 != stripe.rumorHashRawMsgBimap.left.end()) {
+        auto it2 = stripe.rumorIdHashBimap.right.find(message_wo_keysig);
+        if (it2 != stripe.rumorIdHashBimap.right.end()) {
+          replies.emplace_back(
+              from, RRS::Message(RRS::Message::Type::PUSH, it2->second, -1));
+        }
+      } else {
+        // I dont have it as of now. Add this peer to subscriber list for this
+        // hash message.
+        if (!SubscribeLocked(stripe, message_wo_keysig, from)) {
+          LOG_GENERAL(WARNING, "Too many pending PULLs from " << from);
+        }
       }
-      m_hashesSubscriberMap[message_wo_keysig].insert(from);
     }
+    SendReplies(replies);
     return {false, {}};
   } else if (RRS::Message::Type::PUSH == t) {
     // I got it from my peer for what i asked him
-    RawBytes hash;
     if (message_wo_keysig.size() >
         0)  // if someone malaciously sends empty message, sha2 will assert fail
     {
-      hash = HashUtils::BytesToHash(message_wo_keysig);
+      RawBytes hash = HashUtils::BytesToHash(message_wo_keysig);
       std::string hashStr;
       DataConversion::Uint8VecToHexStr(hash, hashStr);
 
-      auto it1 = m_rumorIdHashBimap.right.find(hash);
-      if (it1 != m_rumorIdHashBimap.right.end()) {
-        recvdRumorId = it1->second;
-      } else {
-        // I have not asked for this raw message.. so ignoring
-        return {false, {}};
+      bool hasSubscribers = false;
+      {
+        RumorStripe& stripe = StripeOfHash(hash);
+        std::lock_guard<std::mutex> stripeGuard(stripe.mutex);
+
+        auto it1 = stripe.rumorIdHashBimap.right.find(hash);
+        if (it1 != stripe.rumorIdHashBimap.right.end()) {
+          recvdRumorId = it1->second;
+        } else {
+          // I have not asked for this raw message.. so ignoring
+          return {false, {}};
+        }
+
+        // toBeDispatched
+        auto result = stripe.rumorHashRawMsgBimap.insert(
+            RumorHashRumorBiMap::value_type(hash, message_wo_keysig));
+        if (result.second) {
+          toBeDispatched = true;
+          // add the timestamp for this raw rumor message
+          stripe.rumorRawMsgTimestamp.push_back(std::make_pair(
+              result.first, std::chrono::high_resolution_clock::now()));
+        }
+
+        // Do i have any peers subscribed with me for this hash.
+        auto it2 = stripe.hashesSubscriberMap.find(hash);
+        if (it2 != stripe.hashesSubscriberMap.end()) {
+          hasSubscribers = true;
+          for (auto& p : it2->second) {
+            // avoid un-neccessarily sending again back to sender itself
+            if (p == from) {
+              continue;
+            }
+            replies.emplace_back(
+                p, RRS::Message(RRS::Message::Type::PUSH, recvdRumorId, -1));
+          }
+          Unsubscribe(it2->second);
+          stripe.hashesSubscriberMap.erase(it2);
+        }
       }
 
-      // toBeDispatched
-      auto result = m_rumorHashRawMsgBimap.insert(
-          RumorHashRumorBiMap::value_type(hash, message_wo_keysig));
-      if (result.second) {
+      if (toBeDispatched) {
         LOG_PAYLOAD(INFO,
                     "New Gossip Raw message received from Peer: "
                         << from << ", Gossip_Message_Hash: "
                         << hashStr.substr(0, 6) << " ]",
                     message_wo_keysig, Logger::MAX_BYTES_TO_DISPLAY);
-        toBeDispatched = true;
-        // add the timestamp for this raw rumor message
-        m_rumorRawMsgTimestamp.push_back(std::make_pair(
-            result.first, std::chrono::high_resolution_clock::now()));
       } else {
         LOG_PAYLOAD(DEBUG,
                     "Old Gossip Raw message received from Peer: "
@@ -530,23 +716,13 @@ std::pair<bool, RumorManager::RawBytes> RumorManager::RumorReceived(
                     message_wo_keysig, Logger::MAX_BYTES_TO_DISPLAY);
       }
 
-      // Do i have any peers subscribed with me for this hash.
-      auto it2 = m_hashesSubscriberMap.find(hash);
-      if (it2 != m_hashesSubscriberMap.end()) {
+      if (hasSubscribers) {
         // Send PUSH
         LOG_GENERAL(
             DEBUG,
             "Sending Gossip Raw Message to subscribers of Gossip_Message_Hash: "
                 << hashStr.substr(0, 6));
-        for (auto& p : it2->second) {
-          // avoid un-neccessarily sending again back to sender itself
-          if (p == from) {
-            continue;
-          }
-          RRS::Message pushMsg(RRS::Message::Type::PUSH, recvdRumorId, -1);
-          SendMessage(p, pushMsg);
-        }
-        m_hashesSubscriberMap.erase(hash);
+        SendReplies(replies);
       }
     }
     return {toBeDispatched, message_wo_keysig};
@@ -555,15 +731,13 @@ std::pair<bool, RumorManager::RawBytes> RumorManager::RumorReceived(
     return {false, {}};
   }
 
-  RRS::Message recvMsg(t, recvdRumorId, round);
+  SendReplies(replies);
 
-  std::pair<int, std::vector<RRS::Message>> pullMsgs =
-      m_rumorHolder->receivedMessage(recvMsg, p->second);
-
-  LOG_GENERAL(DEBUG, "Sending " << pullMsgs.second.size()
-                                << " EMPTY_PULL or LAZY_PULL Messages");
-
-  SendMessages(from, pullMsgs.second);
+  // RumorHolder sees the message on the round thread
+  if (m_inbox.Push(InboxEntry{RRS::Message(t, recvdRumorId, round), p->second,
+                              from})) {
+    WakeRoundThread();
+  }
 
   return {toBeDispatched, message_wo_keysig};
 }
@@ -597,47 +771,57 @@ void RumorManager::SendMessage(const Peer& toPeer,
 
   if (!(RRS::Message::Type::EMPTY_PUSH == t ||
         RRS::Message::Type::EMPTY_PULL == t)) {
-    // Get the hash messages based on rumor id.
-    auto it1 = m_rumorIdHashBimap.left.find(message.rumorId());
-    if (it1 != m_rumorIdHashBimap.left.end()) {
-      if (RRS::Message::Type::PUSH == t) {
-        // Get the raw message based on hash
-        auto it2 = m_rumorHashRawMsgBimap.left.find(it1->second);
-        if (it2 != m_rumorHashRawMsgBimap.left.end()) {
-          if (SIGN_VERIFY_NONEMPTY_MSGTYP) {
-            // Add pubkey and signature before message body
-            AppendKeyAndSignature(cmd, it2->second);
-          }
-
-          // Add raw message to outgoing message
-          cmd.insert(cmd.end(), it2->second.begin(), it2->second.end());
-          std::string gossipHashStr;
-          if (!DataConversion::Uint8VecToHexStr(it1->second, gossipHashStr)) {
+    // Copy what is needed under the stripe lock, sign and send without it
+    bool found = false;
+    RawBytes hash;
+    RawBytes body;
+    {
+      RumorStripe& stripe = StripeOfId(message.rumorId());
+      std::lock_guard<std::mutex> guard(stripe.mutex);
+
+      // Get the hash messages based on rumor id.
+      auto it1 = stripe.rumorIdHashBimap.left.find(message.rumorId());
+      if (it1 != stripe.rumorIdHashBimap.left.end()) {
+        found = true;
+        hash = it1->second;
+        if (RRS::Message::Type::PUSH == t) {
+          // Get the raw message based on hash
+          auto it2 = stripe.rumorHashRawMsgBimap.left.find(hash);
+          if (it2 == stripe.rumorHashRawMsgBimap.left.end()) {
+            // Nothing to send.
             return;
           }
-          LOG_GENERAL(INFO,
-                      "Sending Gossip Raw Message of Gossip_Message_Hash : ["
-                          << gossipHashStr.substr(0, 6)
-                          << "] To Peer : " << toPeer);
+          body = it2->second;
+        } else if (RRS::Message::Type::LAZY_PUSH == t ||
+                   RRS::Message::Type::LAZY_PULL == t ||
+                   RRS::Message::Type::PULL == t) {
+          // Hash message for types LAZY_PULL/LAZY_PUSH/PULL
+          body = hash;
         } else {
-          // Nothing to send.
           return;
         }
-      } else if (RRS::Message::Type::LAZY_PUSH == t ||
-                 RRS::Message::Type::LAZY_PULL == t ||
-                 RRS::Message::Type::PULL == t) {
-        if (SIGN_VERIFY_NONEMPTY_MSGTYP) {
-          // Add pubkey and signature before message body
-          AppendKeyAndSignature(cmd, it1->second);
-        }
+      }
+    }
+
+    if (found) {
+      if (SIGN_VERIFY_NONEMPTY_MSGTYP) {
+        // Add pubkey and signature before message body
+        AppendKeyAndSignature(cmd, body);
+      }
+      cmd.insert(cmd.end(), body.begin(), body.end());
 
-        // Add hash message to outgoing message for types
-        // LAZY_PULL/LAZY_PUSH/PULL
-        cmd.insert(cmd.end(), it1->second.begin(), it1->second.end());
+      if (RRS::Message::Type::PUSH == t) {
+        std::string gossipHashStr;
+        if (!DataConversion::Uint8VecToHexStr(hash, gossipHashStr)) {
+          return;
+        }
+        LOG_GENERAL(INFO,
+                    "Sending Gossip Raw Message of Gossip_Message_Hash : ["
+                        << gossipHashStr.substr(0, 6)
+                        << "] To Peer : " << toPeer);
+      } else {
         LOG_GENERAL(DEBUG, "Sending Gossip Hash Message: "
                                << message << " To Peer : " << toPeer);
-      } else {
-        return;
       }
     }
   } else {  // EMPTY_PULL/ EMPTY_PUSH
@@ -665,9 +849,218 @@ void RumorManager::SendMessages(const Peer& toPeer,
   }
 }
 
-// PUBLIC CONST METHODS
-const RumorManager::RumorIdRumorBimap& RumorManager::rumors() const {
-  return m_rumorIdHashBimap;
+void RumorManager::SendReplies(const Replies& replies) {
+  for (const auto& reply : replies) {
+    SendMessage(reply.first, reply.second);
+  }
+}
+
+void RumorManager::SendDigests(const Peer& toPeer,
+                               const std::vector<RRS::Message>& messages) {
+  RawBytes entries;
+  unsigned int count = 0;
+  for (const auto& message : messages) {
+    const RRS::Message::Type t = message.type();
+    if (RRS::Message::Type::LAZY_PUSH != t &&
+        RRS::Message::Type::LAZY_PULL != t) {
+      SendMessage(toPeer, message);
+      continue;
+    }
+
+    RawBytes hash;
+    if (!GetRumorHash(message.rumorId(), hash)) {
+      continue;
+    }
+    AppendDigest(entries, Digest{t, (uint32_t)message.rounds(), hash});
+    count++;
+
+    if (count % MAX_BATCH_ENTRIES == 0) {
+      SendBatch(toPeer, RRS::Message::Type::IHAVE, entries);
+      entries.clear();
+    }
+  }
+
+  if (!entries.empty()) {
+    SendBatch(toPeer, RRS::Message::Type::IHAVE, entries);
+  }
+  m_digestStats.digestsSent += count;
+}
+
+void RumorManager::SendBatch(const Peer& toPeer, RRS::Message::Type type,
+                             const RawBytes& body) {
+  RawBytes cmd = {(unsigned char)type};
+  unsigned int cur_offset = RRSMessageOffset::R_ROUNDS;
+
+  Serializable::SetNumber<uint32_t>(cmd, cur_offset, 0, sizeof(uint32_t));
+
+  cur_offset += sizeof(uint32_t);
+
+  Serializable::SetNumber<uint32_t>(
+      cmd, cur_offset, m_selfPeer.m_listenPortHost, sizeof(uint32_t));
+
+  if (SIGN_VERIFY_NONEMPTY_MSGTYP) {
+    // One signature covers the whole batch
+    AppendKeyAndSignature(cmd, body);
+  }
+  cmd.insert(cmd.end(), body.begin(), body.end());
+
+  if (SIMULATED_NETWORK_DELAY_IN_MS > 0) {
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(SIMULATED_NETWORK_DELAY_IN_MS));
+  }
+  P2PComm::GetInstance().SendMessage(toPeer, cmd, START_BYTE_GOSSIP);
+}
+
+void RumorManager::ProcessDigests(const RawBytes& body, const Peer& from,
+                                  int peerId) {
+  std::vector<Digest> digests;
+  if (!ParseDigests(body, digests)) {
+    LOG_GENERAL(WARNING, "Malformed IHAVE of " << body.size() << " bytes from "
+                                               << from);
+    return;
+  }
+
+  RawBytes wants;
+  bool wake = false;
+  for (const auto& digest : digests) {
+    const RRS::Message::Type t = digest.type;
+    if (RRS::Message::Type::LAZY_PUSH != t &&
+        RRS::Message::Type::LAZY_PULL != t) {
+      continue;
+    }
+    const RawBytes& hash = digest.hash;
+    m_digestStats.digestsReceived++;
+
+    int rumorId;
+    {
+      RumorStripe& stripe = StripeOfHash(hash);
+      std::lock_guard<std::mutex> guard(stripe.mutex);
+      rumorId = GetOrAddRumorIdLocked(stripe, hash);
+
+      auto raw = stripe.rumorHashRawMsgBimap.left.find(hash);
+      if (raw != stripe.rumorHashRawMsgBimap.left.end()) {
+        // A plain push would have sent this payload again
+        m_digestStats.payloadsAvoided++;
+        m_digestStats.bytesAvoided += raw->second.size();
+      } else if (stripe.wantedInRound.insert(hash).second) {
+        // Asked for once per round, whichever peer advertises it first
+        wants.insert(wants.end(), hash.begin(), hash.end());
+      }
+    }
+
+    wake |= m_inbox.Push(
+        InboxEntry{RRS::Message(t, rumorId, digest.rounds), peerId, from});
+  }
+
+  if (!wants.empty()) {
+    SendBatch(from, RRS::Message::Type::IWANT, wants);
+    m_digestStats.wantsSent += wants.size() / HASH_LEN;
+  }
+  if (wake) {
+    WakeRoundThread();
+  }
+}
+
+void RumorManager::ProcessWants(const RawBytes& body, const Peer& from) {
+  std::vector<RawBytes> hashes;
+  if (!ParseWants(body, hashes)) {
+    LOG_GENERAL(WARNING, "Malformed IWANT of " << body.size() << " bytes from "
+                                               << from);
+    return;
+  }
+
+  std::vector<int> available;
+  unsigned int dropped = 0;
+  for (const auto& hash : hashes) {
+    RumorStripe& stripe = StripeOfHash(hash);
+    std::lock_guard<std::mutex> guard(stripe.mutex);
+    auto it = stripe.rumorIdHashBimap.right.find(hash);
+    if (it != stripe.rumorIdHashBimap.right.end() &&
+        stripe.rumorHashRawMsgBimap.left.find(hash) !=
+            stripe.rumorHashRawMsgBimap.left.end()) {
+      available.push_back(it->second);
+    } else {
+      // Not here yet, send it on arrival like for a PULL
+      if (!SubscribeLocked(stripe, hash, from)) {
+        dropped++;
+      }
+    }
+  }
+
+  if (dropped > 0) {
+    LOG_GENERAL(WARNING, "Dropped " << dropped << " IWANT hashes from " << from
+                                    << " waiting on too many");
+  }
+
+  for (const auto& rumorId : available) {
+    SendMessage(from, RRS::Message(RRS::Message::Type::PUSH, rumorId, -1));
+    m_digestStats.payloadsSent++;
+  }
+}
+
+void RumorManager::AppendDigest(RawBytes& body, const Digest& digest) {
+  body.push_back((unsigned char)digest.type);
+  Serializable::SetNumber<uint32_t>(body, body.size(), digest.rounds,
+                                    sizeof(uint32_t));
+  body.insert(body.end(), digest.hash.begin(), digest.hash.end());
+}
+
+bool RumorManager::ParseDigests(const RawBytes& body,
+                                std::vector<Digest>& digests) {
+  const unsigned int entryLen = 1 + sizeof(uint32_t) + HASH_LEN;
+  if (body.empty() || body.size() % entryLen != 0 ||
+      body.size() / entryLen > MAX_BATCH_ENTRIES) {
+    return false;
+  }
+
+  digests.clear();
+  for (unsigned int offset = 0; offset < body.size(); offset += entryLen) {
+    digests.emplace_back(Digest{
+        convertType(body[offset]),
+        Serializable::GetNumber<uint32_t>(body, offset + 1, sizeof(uint32_t)),
+        RawBytes(body.begin() + offset + 1 + sizeof(uint32_t),
+                 body.begin() + offset + entryLen)});
+  }
+  return true;
+}
+
+bool RumorManager::ParseWants(const RawBytes& body,
+                              std::vector<RawBytes>& hashes) {
+  if (body.empty() || body.size() % HASH_LEN != 0 ||
+      body.size() / HASH_LEN > MAX_BATCH_ENTRIES) {
+    return false;
+  }
+
+  hashes.clear();
+  for (unsigned int offset = 0; offset < body.size(); offset += HASH_LEN) {
+    hashes.emplace_back(body.begin() + offset,
+                        body.begin() + offset + HASH_LEN);
+  }
+  return true;
+}
+
+unsigned int RumorManager::GetSubscriptionCount(const Peer& peer) {
+  std::lock_guard<std::mutex> guard(m_subscriptionsMutex);
+  auto it = m_subscriptionsPerPeer.find(peer);
+  return it == m_subscriptionsPerPeer.end() ? 0 : it->second;
+}
+
+void RumorManager::LogAndResetDigestStats() {
+  const uint64_t digestsSent = m_digestStats.digestsSent.exchange(0);
+  const uint64_t digestsReceived = m_digestStats.digestsReceived.exchange(0);
+  const uint64_t wantsSent = m_digestStats.wantsSent.exchange(0);
+  const uint64_t payloadsSent = m_digestStats.payloadsSent.exchange(0);
+  const uint64_t payloadsAvoided = m_digestStats.payloadsAvoided.exchange(0);
+  const uint64_t bytesAvoided = m_digestStats.bytesAvoided.exchange(0);
+
+  if (digestsSent > 0 || digestsReceived > 0) {
+    LOG_GENERAL(INFO, "[Gossip] Digests sent: "
+                          << digestsSent << " received: " << digestsReceived
+                          << " Wants sent: " << wantsSent
+                          << " Payloads sent: " << payloadsSent
+                          << " Duplicate payloads avoided: " << payloadsAvoided
+                          << " (" << bytesAvoided << " bytes)");
+  }
 }
 
 void RumorManager::PrintStatistics() {
@@ -676,9 +1069,9 @@ void RumorManager::PrintStatistics() {
   // in network.
   for (const auto& i : m_rumorHolder->rumorsMap()) {
     uint32_t rumorId = i.first;
-    auto it = m_rumorIdHashBimap.left.find(rumorId);
-    if (it != m_rumorIdHashBimap.left.end()) {
-      bytes this_msg_hash = HashUtils::BytesToHash(it->second);
+    RawBytes hash;
+    if (GetRumorHash(rumorId, hash)) {
+      bytes this_msg_hash = HashUtils::BytesToHash(hash);
       const RRS::RumorStateMachine& state = i.second;
       std::string gossipHashStr;
       if (!DataConversion::Uint8VecToHexStr(this_msg_hash, gossipHashStr)) {
@@ -694,23 +1087,24 @@ void RumorManager::PrintStatistics() {
 void RumorManager::CleanUp() {
   int count = 0;
   auto now = std::chrono::high_resolution_clock::now();
-  while (!m_rumorRawMsgTimestamp.empty()) {
-    auto elapsed_milliseconds =
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - m_rumorRawMsgTimestamp.front().second)
-            .count();
-    LOG_GENERAL(DEBUG, "elapsed_milliseconds:" << elapsed_milliseconds
-                                               << " , m_rawMessageExpiryInMs:"
-                                               << m_rawMessageExpiryInMs);
-    if (elapsed_milliseconds > m_rawMessageExpiryInMs) {  // older
-      auto hash = m_rumorRawMsgTimestamp.front().first->left;
-      m_rumorHashRawMsgBimap.erase(m_rumorRawMsgTimestamp.front().first);
-
-      m_rumorIdHashBimap.right.erase(hash);
-      m_rumorRawMsgTimestamp.pop_front();
-      count++;
-    } else {
-      break;  // other in deque are definately not older. so quit loop
+  for (auto& stripe : m_stripes) {
+    std::lock_guard<std::mutex> guard(stripe.mutex);
+    while (!stripe.rumorRawMsgTimestamp.empty()) {
+      auto elapsed_milliseconds =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              now - stripe.rumorRawMsgTimestamp.front().second)
+              .count();
+      if (elapsed_milliseconds > m_rawMessageExpiryInMs) {  // older
+        auto hash = stripe.rumorRawMsgTimestamp.front().first->left;
+        stripe.rumorHashRawMsgBimap.erase(
+            stripe.rumorRawMsgTimestamp.front().first);
+
+        stripe.rumorIdHashBimap.right.erase(hash);
+        stripe.rumorRawMsgTimestamp.pop_front();
+        count++;
+      } else {
+        break;  // other in deque are definately not older. so quit loop
+      }
     }
   }
   if (count != 0) {
@@ -19,15 +19,20 @@
 #define __RUMORMANAGER_H__
 
 #include <boost/bimap.hpp>
+#include <array>
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <map>
 #include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <unordered_map>
 
 #include "Peer.h"
 #include "libCrypto/Schnorr.h"
 #include "libRumorSpreading/RumorHolder.h"
+#include "libUtils/LockFreeInbox.h"
 
 enum RRSMessageOffset : unsigned int {
   R_TYPE = 0,
@@ -36,6 +41,12 @@ enum RRSMessageOffset : unsigned int {
 
 const unsigned int RETRY_COUNT = 3;
 
+/// Gossip state of one node. Rumor state is split into lock stripes by
+/// rumor hash, and rumor ids carry their stripe index in the low bits, so a
+/// lookup by id or by hash takes a single stripe lock. Receiving threads
+/// never touch RumorHolder directly: what it must see is pushed to a
+/// lock-free inbox that the round thread drains between rounds. No lock is
+/// held while signing or sending.
 class RumorManager {
  public:
   // TYPES
@@ -51,37 +62,151 @@ class RumorManager {
                                std::chrono::high_resolution_clock::time_point>>
       RumorRawMsgTimestampDeque;
   typedef boost::bimap<PubKey, Peer> PubKeyPeerBiMap;
+  typedef std::vector<std::pair<Peer, RRS::Message>> Replies;
+
+  static const unsigned int STRIPE_BITS = 4;
+  static const unsigned int NUM_STRIPES = 1 << STRIPE_BITS;
+
+  struct RumorStripe {
+    std::mutex mutex;
+    int rumorIdGenerator = 0;
+    RumorIdRumorBimap rumorIdHashBimap;
+    RumorHashRumorBiMap rumorHashRawMsgBimap;
+    RumorHashesPeersMap hashesSubscriberMap;
+    RumorRawMsgTimestampDeque rumorRawMsgTimestamp;
+    // Digest mode (GOSSIP_DIGEST_MODE) wants, reset every round
+    std::set<RawBytes> wantedInRound;
+  };
+
+  /// Received message for RumorHolder, fed to it by the round thread
+  struct InboxEntry {
+    RRS::Message message;
+    int peerId;
+    Peer from;
+  };
 
   // MEMBERS
+  // Peers, keys and the RumorHolder only change in Initialize, which takes
+  // m_peersMutex exclusively. Every other entry point holds it shared.
+  std::shared_timed_mutex m_peersMutex;
   std::shared_ptr<RRS::RumorHolder> m_rumorHolder;
   PeerIdPeerBiMap m_peerIdPeerBimap;
   PubKeyPeerBiMap m_pubKeyPeerBiMap;
   std::unordered_set<int> m_peerIdSet;
-  RumorIdRumorBimap m_rumorIdHashBimap;
-  RumorHashRumorBiMap m_rumorHashRawMsgBimap;
-  RumorHashesPeersMap m_hashesSubscriberMap;
   Peer m_selfPeer;
   PairOfKey m_selfKey;
-  std::vector<RawBytes> m_bufferRawMsg;
-  RumorRawMsgTimestampDeque m_rumorRawMsgTimestamp;
   std::vector<PubKey> m_fullNetworkKeys;
 
-  int64_t m_rumorIdGenerator;
-  std::mutex m_mutex;
+  std::array<RumorStripe, NUM_STRIPES> m_stripes;
+  LockFreeInbox<InboxEntry> m_inbox;
+  std::atomic<uint64_t> m_inboxProcessed{0};
+
+  // Hashes each peer waits on through PULL or IWANT
+  std::mutex m_subscriptionsMutex;
+  std::map<Peer, unsigned int> m_subscriptionsPerPeer;
+
+  std::vector<RawBytes> m_bufferRawMsg;
   std::mutex m_continueRoundMutex;
   std::atomic<bool> m_continueRound;
-  std::condition_variable m_condStopRound;
+  std::condition_variable m_condRoundThread;
 
   int32_t m_rawMessageExpiryInMs;
 
+  struct DigestStats {
+    std::atomic<uint64_t> digestsSent{0};
+    std::atomic<uint64_t> digestsReceived{0};
+    std::atomic<uint64_t> wantsSent{0};
+    std::atomic<uint64_t> payloadsSent{0};
+    std::atomic<uint64_t> payloadsAvoided{0};
+    std::atomic<uint64_t> bytesAvoided{0};
+  } m_digestStats;
+
+  static unsigned int StripeIndex(const RawBytes& hash);
+
+  RumorStripe& StripeOfHash(const RawBytes& hash);
+
+  RumorStripe& StripeOfId(int rumorId);
+
+  /// Returns the id of the hash, assigning a new one if it is unknown.
+  /// Caller holds the stripe lock.
+  int GetOrAddRumorIdLocked(RumorStripe& stripe, const RawBytes& hash);
+
+  /// Subscribes the peer to the hash unless it already waits on
+  /// MAX_SUBSCRIPTIONS_PER_PEER hashes. Caller holds the stripe lock.
+  bool SubscribeLocked(RumorStripe& stripe, const RawBytes& hash,
+                       const Peer& peer);
+
+  /// Releases the subscriptions of the peers once their hash has arrived
+  void Unsubscribe(const std::set<Peer>& peers);
+
+  /// Returns the hash of the rumor id if known
+  bool GetRumorHash(int rumorId, RawBytes& hash);
+
+  void WakeRoundThread();
+
+  void AdvanceRound();
+
+  /// Feeds everything received since the last call to RumorHolder and sends
+  /// its responses
+  void ProcessInbox();
+
+  void SendReplies(const Replies& replies);
+
   void SendMessages(const Peer& toPeer,
                     const std::vector<RRS::Message>& messages);
 
+  /// Sends the LAZY_PUSH / LAZY_PULL messages as one IHAVE and the rest one
+  /// by one
+  void SendDigests(const Peer& toPeer,
+                   const std::vector<RRS::Message>& messages);
+
+  void SendBatch(const Peer& toPeer, RRS::Message::Type type,
+                 const RawBytes& body);
+
+  void ProcessDigests(const RawBytes& body, const Peer& from, int peerId);
+
+  void ProcessWants(const RawBytes& body, const Peer& from);
+
+  void LogAndResetDigestStats();
+
   void SendMessage(const Peer& toPeer, const RRS::Message& message);
 
   RawBytes GenerateGossipForwardMessage(const RawBytes& message);
 
+  void PrintStatistics();
+
+  void CleanUp();
+
+  std::pair<bool, RumorManager::RawBytes> VerifyMessage(
+      const RawBytes& message, const RRS::Message::Type& t, const Peer& from);
+
+  void AppendKeyAndSignature(RawBytes& result, const RawBytes& messageToSig);
+
  public:
+  /// One LAZY_PUSH / LAZY_PULL entry of an IHAVE batch
+  struct Digest {
+    RRS::Message::Type type;
+    uint32_t rounds;
+    RawBytes hash;
+  };
+
+  /// Most entries one IHAVE or IWANT batch may carry
+  static const unsigned int MAX_BATCH_ENTRIES = 1024;
+
+  /// Most hashes one peer may wait on until they arrive
+  static const unsigned int MAX_SUBSCRIPTIONS_PER_PEER = 1024;
+
+  /// Appends the digest to an IHAVE body as <1-byte type> <4-byte rounds>
+  /// <hash>
+  static void AppendDigest(RawBytes& body, const Digest& digest);
+
+  /// Parses an IHAVE body. Fails if it is empty, ends inside an entry or has
+  /// more than MAX_BATCH_ENTRIES entries.
+  static bool ParseDigests(const RawBytes& body, std::vector<Digest>& digests);
+
+  /// Parses an IWANT body, a list of hashes, with the same checks
+  static bool ParseWants(const RawBytes& body, std::vector<RawBytes>& hashes);
+
   // CREATORS
   RumorManager();
   ~RumorManager();
@@ -104,6 +229,12 @@ class RumorManager {
   void StartRounds();
   void StopRounds();
 
+  /// Number of received messages the round thread has fed to RumorHolder
+  uint64_t GetInboxProcessedCount() const { return m_inboxProcessed; }
+
+  /// Number of hashes the peer waits on
+  unsigned int GetSubscriptionCount(const Peer& peer);
+
   void SendRumorToForeignPeer(const Peer& toForeignPeer,
                               const RawBytes& message);
 
@@ -112,17 +243,6 @@ class RumorManager {
 
   void SendRumorToForeignPeers(const std::vector<Peer>& toForeignPeers,
                                const RawBytes& message);
-
-  void PrintStatistics();
-
-  void CleanUp();
-
-  std::pair<bool, RumorManager::RawBytes> VerifyMessage(
-      const RawBytes& message, const RRS::Message::Type& t, const Peer& from);
-
-  void AppendKeyAndSignature(RawBytes& result, const RawBytes& messageToSig);
-  // CONST METHODS
-  const RumorIdRumorBimap& rumors() const;
 };
 
 #endif  //__RUMORMANAGER_H__
@@ -236,6 +236,28 @@ bool Node::LoadShardingStructure(bool callByRetrieve) {
 
       index++;
     }
+
+    if (ERASURE_CODED_DISSEMINATION) {
+      vector<Peer> relayPeers;
+      for (const auto& member : *m_myShardMembers) {
+        if (member.second != Peer()) {
+          relayPeers.emplace_back(member.second);
+        }
+      }
+      P2PComm::GetInstance().SetErasureRelayPeers(relayPeers);
+    }
+  }
+
+  if (ERASURE_CODED_DISSEMINATION) {
+    // Only chunks sent by the DS committee are forwarded to the shard
+    vector<Peer> senders;
+    {
+      lock_guard<mutex> g(m_mediator.m_mutexDSCommittee);
+      for (const auto& member : *m_mediator.m_DSCommittee) {
+        senders.emplace_back(member.second);
+      }
+    }
+    P2PComm::GetInstance().SetErasureSenders(senders);
   }
 
   if (!foundMe && !callByRetrieve) {
@@ -349,18 +371,12 @@ bool Node::ProcessVCDSBlocksMessage(const bytes& message,
 
   DequeOfShard t_shards;
 
-  if (!Messenger::GetNodeVCDSBlocksMessage(message, cur_offset, shardId,
-                                           dsblock, vcBlocks, t_shards)) {
-    LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
-              "Messenger::GetNodeVCDSBlocksMessage failed.");
-    return false;
-  }
-
-  // Verify the DSBlockHashSet member of the DSBlockHeader
-  ShardingHash shardingHash;
-  if (!Messenger::GetShardingStructureHash(t_shards, shardingHash)) {
+  // Check the DS block before decoding the VC blocks and sharding structure,
+  // so that stale or forged blocks are dropped cheaply
+  if (!Messenger::GetNodeVCDSBlocksMessageHeader(message, cur_offset, shardId,
+                                                 dsblock)) {
     LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
-              "Messenger::GetShardingStructureHash failed.");
+              "Messenger::GetNodeVCDSBlocksMessageHeader failed.");
     return false;
   }
 
@@ -385,15 +401,6 @@ bool Node::ProcessVCDSBlocksMessage(const bytes& message,
     return false;
   }
 
-  if (shardingHash != dsblock.GetHeader().GetShardingHash()) {
-    LOG_GENERAL(WARNING,
-                "Sharding structure hash in newly received DS Block doesn't "
-                "match. Calculated: "
-                    << shardingHash
-                    << " Received: " << dsblock.GetHeader().GetShardingHash());
-    return false;
-  }
-
   BlockHash temp_blockHash = dsblock.GetHeader().GetMyHash();
   if (temp_blockHash != dsblock.GetBlockHash()) {
     LOG_GENERAL(WARNING,
@@ -413,6 +420,30 @@ bool Node::ProcessVCDSBlocksMessage(const bytes& message,
     return false;
   }
 
+  if (!Messenger::GetNodeVCDSBlocksMessage(message, cur_offset, shardId,
+                                           dsblock, vcBlocks, t_shards)) {
+    LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
+              "Messenger::GetNodeVCDSBlocksMessage failed.");
+    return false;
+  }
+
+  // Verify the DSBlockHashSet member of the DSBlockHeader
+  ShardingHash shardingHash;
+  if (!Messenger::GetShardingStructureHash(t_shards, shardingHash)) {
+    LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
+              "Messenger::GetShardingStructureHash failed.");
+    return false;
+  }
+
+  if (shardingHash != dsblock.GetHeader().GetShardingHash()) {
+    LOG_GENERAL(WARNING,
+                "Sharding structure hash in newly received DS Block doesn't "
+                "match. Calculated: "
+                    << shardingHash
+                    << " Received: " << dsblock.GetHeader().GetShardingHash());
+    return false;
+  }
+
   uint32_t expectedViewChangeCounter = 1;
   for (const auto& vcBlock : vcBlocks) {
     if (!ProcessVCBlockCore(vcBlock)) {
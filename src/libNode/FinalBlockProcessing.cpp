@@ -607,10 +607,12 @@ bool Node::ProcessFinalBlock(const bytes& message, unsigned int offset,
   TxBlock txBlock;
   bytes stateDelta;
 
-  if (!Messenger::GetNodeFinalBlock(message, offset, dsBlockNumber, consensusID,
-                                    txBlock, stateDelta)) {
+  // Check the block itself before decoding the microblock infos and state
+  // delta, so that stale or forged blocks are dropped cheaply
+  if (!Messenger::GetNodeFinalBlockHeader(message, offset, dsBlockNumber,
+                                          consensusID, txBlock)) {
     LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
-              "Messenger::GetNodeFinalBlock failed.");
+              "Messenger::GetNodeFinalBlockHeader failed.");
     return false;
   }
 
@@ -659,8 +661,6 @@ bool Node::ProcessFinalBlock(const bytes& message, unsigned int offset,
     return false;
   }
 
-  LogReceivedFinalBlockDetails(txBlock);
-
   LOG_STATE("[TXBOD][" << std::setw(15) << std::left
                        << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["
                        << txBlock.GetHeader().GetBlockNum() << "] FRST");
@@ -687,6 +687,15 @@ bool Node::ProcessFinalBlock(const bytes& message, unsigned int offset,
     return false;
   }
 
+  if (!Messenger::GetNodeFinalBlock(message, offset, dsBlockNumber, consensusID,
+                                    txBlock, stateDelta)) {
+    LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
+              "Messenger::GetNodeFinalBlock failed.");
+    return false;
+  }
+
+  LogReceivedFinalBlockDetails(txBlock);
+
   // Compute the MBInfoHash of the extra MicroBlock information
   MBInfoHash mbInfoHash;
   if (!Messenger::GetMbInfoHash(txBlock.GetMicroBlockInfos(), mbInfoHash)) {
@@ -916,6 +925,12 @@ void Node::CommitForwardedTransactions(const MBnForwardedTxnEntry& entry) {
     BlockStorage::GetBlockStorage().PutTxBody(twr.GetTransaction().GetTranID(),
                                               serializedTxBody);
   }
+
+  if (LOOKUP_NODE_MODE) {
+    BlockStorage::GetBlockStorage().PutEventLogs(
+        entry.m_microBlock.GetHeader().GetEpochNum(), entry.m_transactions);
+  }
+
   LOG_EPOCH(INFO, to_string(m_mediator.m_currentEpochNum).c_str(),
             "Proceessed " << entry.m_transactions.size() << " of txns.");
 }
@@ -25,6 +25,7 @@
 #include <string>
 
 #include <leveldb/db.h>
+#include <leveldb/write_batch.h>
 #include <boost/filesystem.hpp>
 
 #include "BlockStorage.h"
@@ -35,6 +36,22 @@
 
 using namespace std;
 
+namespace {
+/// Index keys are the contract address, the event name and the big-endian
+/// block number, followed by the txn hash. This keeps the entries of one
+/// (contract, event) pair in one block adjacent for a prefix scan.
+string GetLogIndexPrefix(const Address& address, const string& eventName,
+                         const uint64_t& blockNum) {
+  bytes key = address.asBytes();
+  key.insert(key.end(), eventName.begin(), eventName.end());
+  key.push_back(0);
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    key.push_back(static_cast<unsigned char>(blockNum >> shift));
+  }
+  return string(key.begin(), key.end());
+}
+}  // namespace
+
 BlockStorage& BlockStorage::GetBlockStorage() {
   static BlockStorage bs;
   return bs;
@@ -635,6 +652,127 @@ bool BlockStorage::GetStateDelta(const uint64_t& finalBlockNum,
   return true;
 }
 
+bool BlockStorage::PutEventLogs(const uint64_t& blockNum,
+                                const vector<TransactionWithReceipt>& txns) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING, "Non lookup node should not trigger this.");
+    return false;
+  }
+
+  LogBloom newBloom;
+  leveldb::WriteBatch batch;
+  unsigned int numLogs = 0;
+
+  for (const auto& twr : txns) {
+    const Json::Value& logs =
+        twr.GetTransactionReceipt().GetJsonValue()["event_logs"];
+    if (!logs.isArray()) {
+      continue;
+    }
+
+    const TxnHash& tranHash = twr.GetTransaction().GetTranID();
+    const string hashStr(reinterpret_cast<const char*>(tranHash.data()),
+                         tranHash.size);
+    for (const auto& log : logs) {
+      if (!log.isMember("address") || !log.isMember("_eventname")) {
+        continue;
+      }
+
+      string addrStr = log["address"].asString();
+      if (addrStr.compare(0, 2, "0x") == 0) {
+        addrStr.erase(0, 2);
+      }
+      bytes addrBytes;
+      if (addrStr.size() != ACC_ADDR_SIZE * 2 ||
+          !DataConversion::HexStrToUint8Vec(addrStr, addrBytes)) {
+        LOG_GENERAL(WARNING, "Invalid event log address " << addrStr);
+        continue;
+      }
+      const Address address(addrBytes);
+      const string eventName = log["_eventname"].asString();
+
+      LogEntry::AddToBloom(newBloom, address, eventName);
+      batch.Put(GetLogIndexPrefix(address, eventName, blockNum) + hashStr, "");
+      batch.Put(GetLogIndexPrefix(address, "", blockNum) + hashStr, "");
+      numLogs++;
+    }
+  }
+
+  if (numLogs == 0) {
+    return true;
+  }
+
+  lock_guard<mutex> g(m_mutexLogIndex);
+
+  // Microblocks of the same Tx block arrive separately, so merge the blooms
+  LogBloom bloom;
+  if (!GetLogBloom(blockNum, bloom)) {
+    return false;
+  }
+  bloom |= newBloom;
+
+  if (!m_logIndexDB->GetDB()->Write(leveldb::WriteOptions(), &batch).ok() ||
+      0 != m_logBloomDB->Insert(blockNum, bloom.asBytes())) {
+    LOG_GENERAL(WARNING, "Failed to store event logs of Tx block " << blockNum);
+    return false;
+  }
+
+  LOG_GENERAL(INFO,
+              "Indexed " << numLogs << " event logs of Tx block " << blockNum);
+  return true;
+}
+
+bool BlockStorage::GetLogBloom(const uint64_t& blockNum, LogBloom& bloom) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING, "Non lookup node should not trigger this.");
+    return false;
+  }
+
+  string bloomStr = m_logBloomDB->Lookup(blockNum);
+  if (bloomStr.empty()) {
+    bloom = LogBloom();
+    return true;
+  }
+
+  if (bloomStr.size() != LogBloom::size) {
+    LOG_GENERAL(WARNING, "Corrupted log bloom of Tx block " << blockNum);
+    return false;
+  }
+
+  bloom = LogBloom(bytes(bloomStr.begin(), bloomStr.end()));
+  return true;
+}
+
+bool BlockStorage::GetEventLogTxnHashes(const Address& address,
+                                        const string& eventName,
+                                        const uint64_t& blockNum,
+                                        vector<TxnHash>& txnHashes) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING, "Non lookup node should not trigger this.");
+    return false;
+  }
+
+  const string prefix = GetLogIndexPrefix(address, eventName, blockNum);
+
+  txnHashes.clear();
+  leveldb::Iterator* it =
+      m_logIndexDB->GetDB()->NewIterator(leveldb::ReadOptions());
+  for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix);
+       it->Next()) {
+    if (it->key().size() != prefix.size() + TRAN_HASH_SIZE) {
+      LOG_GENERAL(WARNING, "Corrupted event log index entry");
+      continue;
+    }
+    const unsigned char* hashBegin =
+        reinterpret_cast<const unsigned char*>(it->key().data()) +
+        prefix.size();
+    txnHashes.emplace_back(bytes(hashBegin, hashBegin + TRAN_HASH_SIZE));
+  }
+
+  delete it;
+  return true;
+}
+
 bool BlockStorage::PutDiagnosticData(const uint64_t& dsBlockNum,
                                      const DequeOfShard& shards,
                                      const DequeOfDSNode& dsCommittee) {
@@ -820,6 +958,16 @@ bool BlockStorage::ResetDB(DBTYPE type) {
       }
       break;
     }
+    case LOG_BLOOM: {
+      lock_guard<mutex> g(m_mutexLogIndex);
+      ret = m_logBloomDB->ResetDB();
+      break;
+    }
+    case LOG_INDEX: {
+      lock_guard<mutex> g(m_mutexLogIndex);
+      ret = m_logIndexDB->ResetDB();
+      break;
+    }
   }
   if (!ret) {
     LOG_GENERAL(INFO, "FAIL: Reset DB " << type << " failed");
@@ -895,6 +1043,16 @@ std::vector<std::string> BlockStorage::GetDBName(DBTYPE type) {
       ret.push_back(m_diagnosticDB->GetDBName());
       break;
     }
+    case LOG_BLOOM: {
+      lock_guard<mutex> g(m_mutexLogIndex);
+      ret.push_back(m_logBloomDB->GetDBName());
+      break;
+    }
+    case LOG_INDEX: {
+      lock_guard<mutex> g(m_mutexLogIndex);
+      ret.push_back(m_logIndexDB->GetDBName());
+      break;
+    }
   }
 
   return ret;
@@ -914,6 +1072,7 @@ bool BlockStorage::ResetAll() {
            ResetDB(TX_BODY) & ResetDB(TX_BODY_TMP) & ResetDB(MICROBLOCK) &
            ResetDB(DS_COMMITTEE) & ResetDB(VC_BLOCK) & ResetDB(FB_BLOCK) &
            ResetDB(BLOCKLINK) & ResetDB(SHARD_STRUCTURE) &
-           ResetDB(STATE_DELTA) & ResetDB(DIAGNOSTIC);
+           ResetDB(STATE_DELTA) & ResetDB(DIAGNOSTIC) & ResetDB(LOG_BLOOM) &
+           ResetDB(LOG_INDEX);
   }
 }
@@ -25,6 +25,8 @@
 
 #include "common/Singleton.h"
 #include "depends/libDatabase/LevelDB.h"
+#include "libData/AccountData/LogEntry.h"
+#include "libData/AccountData/TransactionReceipt.h"
 #include "libData/BlockData/Block.h"
 #include "libData/BlockData/Block/FallbackBlockWShardingStructure.h"
 
@@ -63,6 +65,9 @@ class BlockStorage : public Singleton<BlockStorage> {
   std::shared_ptr<LevelDB> m_diagnosticDB;
   /// used for historical data
   std::shared_ptr<LevelDB> m_historicalDB;
+  /// event log blooms per Tx block and (contract, event) index, lookup only
+  std::shared_ptr<LevelDB> m_logBloomDB;
+  std::shared_ptr<LevelDB> m_logIndexDB;
 
   BlockStorage()
       : m_metadataDB(std::make_shared<LevelDB>("metadata")),
@@ -80,6 +85,8 @@ class BlockStorage : public Singleton<BlockStorage> {
     if (LOOKUP_NODE_MODE) {
       m_txBodyDB = std::make_shared<LevelDB>("txBodies");
       m_txBodyTmpDB = std::make_shared<LevelDB>("txBodiesTmp");
+      m_logBloomDB = std::make_shared<LevelDB>("logBlooms");
+      m_logIndexDB = std::make_shared<LevelDB>("logIndex");
     }
   };
   ~BlockStorage() = default;
@@ -100,7 +107,9 @@ class BlockStorage : public Singleton<BlockStorage> {
     BLOCKLINK,
     SHARD_STRUCTURE,
     STATE_DELTA,
-    DIAGNOSTIC
+    DIAGNOSTIC,
+    LOG_BLOOM,
+    LOG_INDEX
   };
 
   /// Returns the singleton BlockStorage instance.
@@ -216,6 +225,21 @@ class BlockStorage : public Singleton<BlockStorage> {
   /// Retrieve state delta
   bool GetStateDelta(const uint64_t& finalBlockNum, bytes& stateDelta);
 
+  /// Adds the events in the receipts of a Tx block to its log bloom and to
+  /// the (contract, event) index. May be called once per microblock.
+  bool PutEventLogs(const uint64_t& blockNum,
+                    const std::vector<TransactionWithReceipt>& txns);
+
+  /// Retrieves the log bloom of a Tx block, empty if it has no events
+  bool GetLogBloom(const uint64_t& blockNum, LogBloom& bloom);
+
+  /// Retrieves the txns of a Tx block that emitted the given event, or any
+  /// event of the contract if eventName is empty
+  bool GetEventLogTxnHashes(const Address& address,
+                            const std::string& eventName,
+                            const uint64_t& blockNum,
+                            std::vector<TxnHash>& txnHashes);
+
   /// Save data for diagnostic / monitoring purposes
   bool PutDiagnosticData(const uint64_t& dsBlockNum, const DequeOfShard& shards,
                          const DequeOfDSNode& dsCommittee);
@@ -255,6 +279,7 @@ class BlockStorage : public Singleton<BlockStorage> {
   std::mutex m_mutexTxBody;
   std::mutex m_mutexTxBodyTmp;
   std::mutex m_mutexDiagnostic;
+  std::mutex m_mutexLogIndex;
 
   unsigned int m_diagnosticDBCounter;
 };
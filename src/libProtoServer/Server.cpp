@@ -188,8 +188,7 @@ CreateTransactionResponse Server::CreateTransaction(
 
     unsigned int num_shards = m_mediator.m_lookup->GetShardPeers().size();
 
-    const PubKey& senderPubKey = tx.GetSenderPubKey();
-    const Address fromAddr = Account::GetAddressFromPublicKey(senderPubKey);
+    const Address& fromAddr = tx.GetSenderAddr();
     const Account* sender = AccountStore::GetInstance().GetAccount(fromAddr);
 
     if (sender == nullptr) {
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "GossipTuner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace RRS {
+
+namespace {
+// Share of a round's contacts that must already have a rumor for it to count
+// as having covered the network
+const double SATURATION = 0.9;
+
+// Rounds a rumor stays in B and C state, 'ln(ln(n))' as in the paper
+int coolingRounds(size_t networkSize) {
+  if (networkSize < 3) {
+    return 1;
+  }
+  return std::max(
+      1, static_cast<int>(std::ceil(std::log(std::log(networkSize)))));
+}
+}  // namespace
+
+// PRIVATE METHODS
+void GossipTuner::plan() {
+  const int cooling = coolingRounds(m_networkSize);
+
+  // Smallest fan-out that meets the target at the longest round interval
+  m_fanout = m_maxFanout;
+  m_roundTimeInMs = m_maxRoundTimeInMs;
+  for (int f = 1; f <= m_maxFanout; f++) {
+    const int rounds = modelRounds(m_networkSize, f);
+    if (rounds * m_maxRoundTimeInMs <= m_targetLatencyInMs &&
+        rounds + cooling <= m_limits.maxRoundsTotal()) {
+      m_fanout = f;
+      break;
+    }
+  }
+
+  // Not even the largest fan-out does, shorten the rounds
+  const int rounds = modelRounds(m_networkSize, m_fanout);
+  if (rounds * m_roundTimeInMs > m_targetLatencyInMs) {
+    m_roundTimeInMs =
+        std::max(m_minRoundTimeInMs, m_targetLatencyInMs / rounds);
+  }
+
+  updateConfig();
+}
+
+void GossipTuner::updateConfig() {
+  const int cooling = coolingRounds(m_networkSize);
+  const int rounds =
+      std::max(modelRounds(m_networkSize, m_fanout), m_observedRounds);
+
+  // Rounds to reach everyone, plus time in B and C state for the rumor to
+  // die down, within the configured limit
+  m_config = NetworkConfig(
+      m_networkSize, std::min(m_limits.maxRoundsInB(), cooling),
+      std::min(m_limits.maxRoundsInC(), cooling),
+      std::min(m_limits.maxRoundsTotal(), rounds + 2 * cooling));
+}
+
+void GossipTuner::addSample(int rounds) {
+  m_observedRounds = std::max(m_observedRounds, rounds);
+}
+
+// CONSTRUCTORS
+GossipTuner::GossipTuner(size_t networkSize, const NetworkConfig& limits,
+                         int maxFanout, int targetLatencyInMs,
+                         int minRoundTimeInMs, int maxRoundTimeInMs)
+    : m_networkSize(networkSize),
+      m_limits(limits),
+      m_config(limits),
+      m_maxFanout(std::max(
+          1, std::min(maxFanout, static_cast<int>(networkSize) - 1))),
+      m_targetLatencyInMs(targetLatencyInMs),
+      m_minRoundTimeInMs(std::min(minRoundTimeInMs, maxRoundTimeInMs)),
+      m_maxRoundTimeInMs(maxRoundTimeInMs),
+      m_fanout(1),
+      m_roundTimeInMs(maxRoundTimeInMs),
+      m_progress(),
+      m_windowRounds(0),
+      m_observedRounds(0),
+      m_unsaturated(false) {
+  plan();
+}
+
+// PUBLIC METHODS
+void GossipTuner::peerHasRumor(int rumorId, int peer) {
+  m_progress[rumorId].informedInRound.insert(peer);
+}
+
+bool GossipTuner::endRound(
+    size_t contacts, const std::unordered_map<int, RumorStateMachine>& rumors) {
+  for (const auto& r : rumors) {
+    if (!r.second.isOld()) {
+      m_progress[r.first];
+    }
+  }
+
+  for (auto it = m_progress.begin(); it != m_progress.end();) {
+    Progress& progress = it->second;
+    auto r = rumors.find(it->first);
+    const bool old = r == rumors.end() || r->second.isOld();
+
+    if (!progress.done) {
+      ++progress.age;
+      if (contacts > 0 &&
+          progress.informedInRound.size() >= SATURATION * contacts) {
+        addSample(progress.age);
+        progress.done = true;
+      } else if (old) {
+        // Stopped spreading before it got around
+        m_unsaturated = true;
+        addSample(progress.age);
+        progress.done = true;
+      }
+    }
+    progress.informedInRound.clear();
+
+    if (old) {
+      it = m_progress.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (++m_windowRounds < WINDOW_ROUNDS) {
+    return false;
+  }
+  m_windowRounds = 0;
+  if (m_observedRounds == 0) {
+    return false;
+  }
+
+  const int oldFanout = m_fanout;
+  const int oldRoundTime = m_roundTimeInMs;
+  const int oldTotal = m_config.maxRoundsTotal();
+  const int latency = m_observedRounds * m_roundTimeInMs;
+  const int cooling = coolingRounds(m_networkSize);
+
+  if (m_unsaturated) {
+    m_fanout = std::min(m_maxFanout, m_fanout + 1);
+  } else if (latency > m_targetLatencyInMs) {
+    if (m_roundTimeInMs > m_minRoundTimeInMs) {
+      m_roundTimeInMs = std::max(m_minRoundTimeInMs,
+                                 m_targetLatencyInMs / m_observedRounds);
+    } else {
+      m_fanout = std::min(m_maxFanout, m_fanout + 1);
+    }
+  } else if (2 * latency < m_targetLatencyInMs) {
+    // Well within the target, spend less. A smaller fan-out is only taken if
+    // its rounds still fit in the limits.
+    if (m_fanout > 1 && modelRounds(m_networkSize, m_fanout - 1) + cooling <=
+                            m_limits.maxRoundsTotal()) {
+      m_fanout--;
+    } else {
+      m_roundTimeInMs =
+          std::min(m_maxRoundTimeInMs, m_roundTimeInMs * 3 / 2);
+    }
+  }
+
+  updateConfig();
+  m_observedRounds = 0;
+  m_unsaturated = false;
+
+  return m_fanout != oldFanout || m_roundTimeInMs != oldRoundTime ||
+         m_config.maxRoundsTotal() != oldTotal;
+}
+
+// PUBLIC CONST METHODS
+int GossipTuner::fanout() const { return m_fanout; }
+
+int GossipTuner::roundTimeInMs() const { return m_roundTimeInMs; }
+
+const NetworkConfig& GossipTuner::networkConfig() const { return m_config; }
+
+int GossipTuner::modelRounds(size_t networkSize, int fanout) {
+  if (networkSize < 2 || fanout < 1) {
+    return 1;
+  }
+  return std::max(1, static_cast<int>(std::ceil(std::log(networkSize) /
+                                                std::log(1 + fanout))));
+}
+
+}  // namespace RRS
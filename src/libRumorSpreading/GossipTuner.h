@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __GOSSIPTUNER_H__
+#define __GOSSIPTUNER_H__
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "NetworkConfig.h"
+#include "RumorStateMachine.h"
+
+namespace RRS {
+
+// Picks the fan-out, round limits and round interval of a 'RumorHolder' so
+// that a rumor reaches the whole network within a target latency.
+//
+// The starting point comes from the push-pull model: with fan-out 'f' a
+// rumor reaches 'n' peers in about 'log(n) / log(1 + f)' rounds. The
+// cheapest setting that meets the target is used, i.e. the smallest
+// fan-out at the longest round interval.
+//
+// It is then corrected from what is observed. A rumor is taken to have
+// covered the network once most of the peers that contacted us in a round
+// already had it. The rounds that takes are compared with the target every
+// few rounds. A rumor that went OLD before that point means the settings
+// are too tight.
+class GossipTuner {
+ private:
+  // TYPES
+  struct Progress {
+    int age = 0;
+    bool done = false;
+    std::unordered_set<int> informedInRound;
+  };
+
+  // MEMBERS
+  size_t m_networkSize;
+  NetworkConfig m_limits;
+  NetworkConfig m_config;
+  int m_maxFanout;
+  int m_targetLatencyInMs;
+  int m_minRoundTimeInMs;
+  int m_maxRoundTimeInMs;
+  int m_fanout;
+  int m_roundTimeInMs;
+
+  std::unordered_map<int, Progress> m_progress;
+  int m_windowRounds;
+  int m_observedRounds;
+  bool m_unsaturated;
+
+  static const int WINDOW_ROUNDS = 8;
+
+  // METHODS
+  void plan();
+
+  void updateConfig();
+
+  void addSample(int rounds);
+
+ public:
+  // CONSTRUCTORS
+  /// The round limits in 'limits' and 'maxFanout' are upper bounds that the
+  /// tuning never exceeds.
+  GossipTuner(size_t networkSize, const NetworkConfig& limits, int maxFanout,
+              int targetLatencyInMs, int minRoundTimeInMs,
+              int maxRoundTimeInMs);
+
+  // METHODS
+  /// Records that 'peer' sent us a message about the live rumor 'rumorId'
+  void peerHasRumor(int rumorId, int peer);
+
+  /// Ends a round in which 'contacts' peers contacted us. Returns true if the
+  /// fan-out, round limits or round interval changed.
+  bool endRound(size_t contacts,
+                const std::unordered_map<int, RumorStateMachine>& rumors);
+
+  // CONST METHODS
+  int fanout() const;
+
+  int roundTimeInMs() const;
+
+  const NetworkConfig& networkConfig() const;
+
+  /// Rounds for push-pull gossip with 'fanout' to reach 'networkSize' peers
+  static int modelRounds(size_t networkSize, int fanout);
+};
+
+}  // namespace RRS
+
+#endif  //__GOSSIPTUNER_H__
@@ -30,7 +30,9 @@ std::map<Message::Type, std::string> Message::s_enumKeyToString = {
     {Type::PULL, LITERAL(PULL)},
     {Type::EMPTY_PUSH, LITERAL(EMPTY_PUSH)},
     {Type::EMPTY_PULL, LITERAL(EMPTY_PULL)},
-    {Type::FORWARD, LITERAL(FORWARD)}};
+    {Type::FORWARD, LITERAL(FORWARD)},
+    {Type::IHAVE, LITERAL(IHAVE)},
+    {Type::IWANT, LITERAL(IWANT)}};
 
 // CONSTRUCTORS
 Message::Message() {}
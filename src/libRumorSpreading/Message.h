@@ -37,6 +37,8 @@ class Message {
     FORWARD = 0x05,
     LAZY_PUSH = 0x06,
     LAZY_PULL = 0x07,
+    IHAVE = 0x08,  // batch of LAZY_PUSH / LAZY_PULL digests
+    IWANT = 0x09,  // batch of digests whose payload is missing
     NUM_TYPES
   };
 
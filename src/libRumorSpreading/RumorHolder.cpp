@@ -63,6 +63,16 @@ void RumorHolder::increaseStatValue(StatisticKey key, double value) {
   }
 }
 
+void RumorHolder::applyTuning() {
+  m_networkConfig = m_tuner->networkConfig();
+  m_maxNeighborsPerRound = m_tuner->fanout();
+  LOG_GENERAL(DEBUG, "[Gossip] Fan-out: "
+                         << m_maxNeighborsPerRound
+                         << " Round time: " << m_tuner->roundTimeInMs()
+                         << " ms Max rounds: "
+                         << m_networkConfig.maxRoundsTotal());
+}
+
 // CONSTRUCTORS
 RumorHolder::RumorHolder(const std::unordered_set<int>& peers, int id)
     : m_id(id),
@@ -154,7 +164,8 @@ RumorHolder::RumorHolder(const RumorHolder& other)
       m_nextMemberCb(other.m_nextMemberCb),
       m_nonPriorityPeers(other.m_nonPriorityPeers),
       m_statistics(other.m_statistics),
-      m_maxNeighborsPerRound(other.m_maxNeighborsPerRound) {}
+      m_maxNeighborsPerRound(other.m_maxNeighborsPerRound),
+      m_tuner(other.m_tuner ? new GossipTuner(*other.m_tuner) : nullptr) {}
 
 // MOVE CONSTRUCTOR
 RumorHolder::RumorHolder(RumorHolder&& other) noexcept
@@ -167,7 +178,8 @@ RumorHolder::RumorHolder(RumorHolder&& other) noexcept
       m_nextMemberCb(std::move(other.m_nextMemberCb)),
       m_nonPriorityPeers(std::move(other.m_nonPriorityPeers)),
       m_statistics(std::move(other.m_statistics)),
-      m_maxNeighborsPerRound(other.m_maxNeighborsPerRound) {}
+      m_maxNeighborsPerRound(other.m_maxNeighborsPerRound),
+      m_tuner(std::move(other.m_tuner)) {}
 
 // PUBLIC METHODS
 bool RumorHolder::addRumor(int rumorId) {
@@ -211,12 +223,21 @@ std::pair<int, std::vector<Message>> RumorHolder::receivedMessage(
   const int receivedRumorId = message.rumorId();
   const int theirRound = message.rounds();
   if (receivedRumorId >= 0) {
-    if (m_rumors.count(receivedRumorId) > 0) {
-      m_rumors.at(receivedRumorId).rumorReceived(fromPeer, message.rounds());
+    auto it = m_rumors.find(receivedRumorId);
+    if (it != m_rumors.end()) {
+      it->second.rumorReceived(fromPeer, message.rounds());
     } else {
-      m_rumors.insert(std::make_pair(
-          receivedRumorId,
-          RumorStateMachine(&m_networkConfig, fromPeer, theirRound)));
+      it = m_rumors
+               .insert(std::make_pair(
+                   receivedRumorId,
+                   RumorStateMachine(&m_networkConfig, fromPeer, theirRound)))
+               .first;
+    }
+
+    if (m_tuner && !it->second.isOld() &&
+        (message.type() == Message::Type::LAZY_PUSH ||
+         message.type() == Message::Type::LAZY_PULL)) {
+      m_tuner->peerHasRumor(receivedRumorId, fromPeer);
     }
   }
 
@@ -319,12 +340,27 @@ std::pair<std::vector<int>, std::vector<Message>> RumorHolder::advanceRound() {
     increaseStatValue(StatisticKey::NumEmptyPushMessages, 1);
   }
 
+  if (m_tuner && m_tuner->endRound(m_peersInCurrentRound.size(), m_rumors)) {
+    applyTuning();
+  }
+
   // Clear round state
   m_peersInCurrentRound.clear();
 
   return std::make_pair(toMembers, pushMessages);
 }
 
+void RumorHolder::enableAdaptiveMode(int targetLatencyInMs,
+                                     int minRoundTimeInMs,
+                                     int maxRoundTimeInMs,
+                                     int maxNeighborsPerRound) {
+  std::lock_guard<std::mutex> guard(m_mutex);  // critical section
+  m_tuner.reset(new GossipTuner(m_peers.size() + 1, m_networkConfig,
+                                maxNeighborsPerRound, targetLatencyInMs,
+                                minRoundTimeInMs, maxRoundTimeInMs));
+  applyTuning();
+}
+
 // PUBLIC CONST METHODS
 int RumorHolder::id() const { return m_id; }
 
@@ -332,6 +368,16 @@ const NetworkConfig& RumorHolder::networkConfig() const {
   return m_networkConfig;
 }
 
+int RumorHolder::maxNeighborsPerRound() const {
+  std::lock_guard<std::mutex> guard(m_mutex);  // critical section
+  return m_maxNeighborsPerRound;
+}
+
+int RumorHolder::roundTimeInMs() const {
+  std::lock_guard<std::mutex> guard(m_mutex);  // critical section
+  return m_tuner ? m_tuner->roundTimeInMs() : ROUND_TIME_IN_MS;
+}
+
 const std::unordered_map<int, RumorStateMachine>& RumorHolder::rumorsMap()
     const {
   return m_rumors;
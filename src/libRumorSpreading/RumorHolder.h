@@ -20,9 +20,11 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <unordered_set>
 
+#include "GossipTuner.h"
 #include "MemberID.h"
 #include "NetworkConfig.h"
 #include "RumorSpreadingInterface.h"
@@ -62,6 +64,7 @@ class RumorHolder : public RumorSpreadingInterface {
   std::unordered_set<int> m_nonPriorityPeers;
   std::map<StatisticKey, double> m_statistics;
   int m_maxNeighborsPerRound;
+  std::unique_ptr<GossipTuner> m_tuner;
 
   static const int MAX_RETRY = 3;
 
@@ -75,6 +78,9 @@ class RumorHolder : public RumorSpreadingInterface {
   // Add the specified 'value' to the previous statistic value
   void increaseStatValue(StatisticKey key, double value);
 
+  // Take the fan-out and round limits from the tuner
+  void applyTuning();
+
  public:
   // CONSTRUCTORS
   /// Create an instance which automatically figures out the network parameters.
@@ -104,11 +110,23 @@ class RumorHolder : public RumorSpreadingInterface {
 
   std::pair<std::vector<int>, std::vector<Message>> advanceRound() override;
 
+  /// Let a 'GossipTuner' pick the fan-out, round limits and round interval
+  /// so that rumors converge within 'targetLatencyInMs'. The current round
+  /// limits and 'maxNeighborsPerRound' are never exceeded.
+  void enableAdaptiveMode(int targetLatencyInMs, int minRoundTimeInMs,
+                          int maxRoundTimeInMs, int maxNeighborsPerRound);
+
   // CONST METHODS
   int id() const;
 
   const NetworkConfig& networkConfig() const;
 
+  int maxNeighborsPerRound() const;
+
+  /// Interval until the next 'advanceRound', 'ROUND_TIME_IN_MS' unless
+  /// adaptive mode is on
+  int roundTimeInMs() const;
+
   const std::unordered_map<int, RumorStateMachine>& rumorsMap() const;
 
   bool rumorExists(int rumorId) const;
@@ -174,8 +174,7 @@ Json::Value Server::CreateTransaction(const Json::Value& _json) {
 
     unsigned int num_shards = m_mediator.m_lookup->GetShardPeers().size();
 
-    const PubKey& senderPubKey = tx.GetSenderPubKey();
-    const Address fromAddr = Account::GetAddressFromPublicKey(senderPubKey);
+    const Address& fromAddr = tx.GetSenderAddr();
     const Account* sender = AccountStore::GetInstance().GetAccount(fromAddr);
 
     if (fromAddr == Address()) {
@@ -513,6 +512,105 @@ Json::Value Server::GetSmartContractCode(const string& address) {
   }
 }
 
+Json::Value Server::GetEventLogs(const Json::Value& _json) {
+  LOG_MARKER();
+
+  if (!LOOKUP_NODE_MODE) {
+    throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
+  }
+
+  try {
+    if (!_json.isMember("address") || !_json.isMember("fromBlock") ||
+        !_json.isMember("toBlock")) {
+      throw JsonRpcException(RPC_INVALID_PARAMS,
+                             "address, fromBlock and toBlock are required");
+    }
+
+    string address = _json["address"].asString();
+    if (address.size() != ACC_ADDR_SIZE * 2) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER,
+                             "Address size not appropriate");
+    }
+    bytes tmpaddr;
+    if (!DataConversion::HexStrToUint8Vec(address, tmpaddr)) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY, "invalid address");
+    }
+    const Address addr(tmpaddr);
+    const string eventName =
+        _json.isMember("eventName") ? _json["eventName"].asString() : "";
+
+    const uint64_t fromBlock = stoull(_json["fromBlock"].asString());
+    const uint64_t toBlock = stoull(_json["toBlock"].asString());
+    if (fromBlock > toBlock) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER,
+                             "fromBlock is after toBlock");
+    }
+    if (toBlock - fromBlock >= MAX_EVENT_LOG_BLOCK_RANGE) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER,
+                             "Block range exceeds " +
+                                 to_string(MAX_EVENT_LOG_BLOCK_RANGE));
+    }
+
+    Json::Value _jsonLogs = Json::arrayValue;
+    for (uint64_t blockNum = fromBlock; blockNum <= toBlock; blockNum++) {
+      // The bloom lets most blocks be skipped without touching the index
+      LogBloom bloom;
+      if (!BlockStorage::GetBlockStorage().GetLogBloom(blockNum, bloom)) {
+        throw JsonRpcException(RPC_DATABASE_ERROR, "Failed to read log bloom");
+      }
+      if (!LogEntry::BloomMayContain(bloom, addr, eventName)) {
+        continue;
+      }
+
+      vector<TxnHash> txnHashes;
+      if (!BlockStorage::GetBlockStorage().GetEventLogTxnHashes(
+              addr, eventName, blockNum, txnHashes)) {
+        throw JsonRpcException(RPC_DATABASE_ERROR,
+                               "Failed to read event log index");
+      }
+
+      for (const auto& txnHash : txnHashes) {
+        TxBodySharedPtr tptr;
+        if (!BlockStorage::GetBlockStorage().GetTxBody(txnHash, tptr)) {
+          LOG_GENERAL(WARNING, "Indexed txn " << txnHash << " not found");
+          continue;
+        }
+
+        const Json::Value& logs =
+            tptr->GetTransactionReceipt().GetJsonValue()["event_logs"];
+        for (const auto& log : logs) {
+          if (log["address"].asString() != "0x" + addr.hex() ||
+              (!eventName.empty() &&
+               log["_eventname"].asString() != eventName)) {
+            continue;
+          }
+          Json::Value _jsonLog;
+          _jsonLog["blockNum"] = to_string(blockNum);
+          _jsonLog["ID"] = txnHash.hex();
+          _jsonLog["event"] = log;
+          _jsonLogs.append(_jsonLog);
+        }
+      }
+    }
+
+    return _jsonLogs;
+  } catch (const JsonRpcException& je) {
+    throw je;
+  } catch (invalid_argument& e) {
+    LOG_GENERAL(INFO,
+                "[Error]" << e.what() << " Input: " << _json.toStyledString());
+    throw JsonRpcException(RPC_INVALID_PARAMS, "Invalid arugment");
+  } catch (out_of_range& e) {
+    LOG_GENERAL(INFO,
+                "[Error]" << e.what() << " Input: " << _json.toStyledString());
+    throw JsonRpcException(RPC_INVALID_PARAMS, "Out of range");
+  } catch (exception& e) {
+    LOG_GENERAL(INFO,
+                "[Error]" << e.what() << " Input: " << _json.toStyledString());
+    throw JsonRpcException(RPC_MISC_ERROR, "Unable To Process");
+  }
+}
+
 Json::Value Server::GetSmartContracts(const string& address) {
   LOG_MARKER();
   try {
@@ -598,8 +696,67 @@ string Server::CreateMessage([[gnu::unused]] const Json::Value& _json) {
   return "Hello";
 }
 
-string Server::GetGasEstimate([[gnu::unused]] const Json::Value& _json) {
-  return "Hello";
+Json::Value Server::GetGasEstimate(const Json::Value& _json) {
+  LOG_MARKER();
+
+  // Keep RPC bursts from hogging the node with simulations
+  if (++m_numGasEstimates > MAX_CONCURRENT_GAS_ESTIMATES) {
+    --m_numGasEstimates;
+    throw JsonRpcException(RPC_MISC_ERROR,
+                           "Too many gas estimations in progress");
+  }
+
+  try {
+    if (!JSONConversion::checkJsonTx(_json)) {
+      throw JsonRpcException(RPC_PARSE_ERROR, "Invalid Transaction JSON");
+    }
+
+    Transaction tx = JSONConversion::convertJsontoTx(_json);
+
+    if (DataConversion::UnpackA(tx.GetVersion()) != CHAIN_ID) {
+      throw JsonRpcException(RPC_VERIFY_REJECTED, "CHAIN_ID incorrect");
+    }
+
+    const Address fromAddr = tx.GetSenderAddr();
+    if (fromAddr == Address()) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
+                             "Invalid address for issuing transactions");
+    }
+
+    // Mirror the shard routing done in CreateTransaction, as contract calls
+    // across shards are executed by the DS committee
+    unsigned int num_shards = m_mediator.m_lookup->GetShardPeers().size();
+    bool isDS = false;
+    if (num_shards > 0 && !tx.GetData().empty() &&
+        tx.GetToAddr() != NullAddress) {
+      isDS = Transaction::GetShardIndex(fromAddr, num_shards) !=
+             Transaction::GetShardIndex(tx.GetToAddr(), num_shards);
+    }
+
+    uint64_t blockNum =
+        m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+
+    TransactionReceipt receipt;
+    if (!AccountStore::GetInstance().UpdateAccountsDryRun(
+            blockNum, num_shards, isDS, tx, receipt)) {
+      throw JsonRpcException(RPC_VERIFY_REJECTED,
+                             "Transaction would be rejected");
+    }
+
+    Json::Value ret;
+    ret["GasUsed"] = to_string(receipt.GetCumGas());
+    ret["receipt"] = receipt.GetJsonValue();
+    --m_numGasEstimates;
+    return ret;
+  } catch (const JsonRpcException& je) {
+    --m_numGasEstimates;
+    throw je;
+  } catch (exception& e) {
+    --m_numGasEstimates;
+    LOG_GENERAL(INFO,
+                "[Error]" << e.what() << " Input: " << _json.toStyledString());
+    throw JsonRpcException(RPC_MISC_ERROR, "Unable to Process");
+  }
 }
 
 unsigned int Server::GetNumPeers() {
@@ -21,6 +21,7 @@
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #include <boost/multiprecision/cpp_int.hpp>
 #pragma GCC diagnostic pop
+#include <atomic>
 #include <mutex>
 #include "libData/BlockData/BlockHeader/BlockHeaderBase.h"
 #include "libData/DataStructures/CircularArray.h"
@@ -128,7 +129,7 @@ class AbstractZServer : public jsonrpc::AbstractServer<AbstractZServer> {
         &AbstractZServer::CreateMessageI);
     this->bindAndAddMethod(
         jsonrpc::Procedure("GetGasEstimate", jsonrpc::PARAMS_BY_POSITION,
-                           jsonrpc::JSON_STRING, "param01",
+                           jsonrpc::JSON_OBJECT, "param01",
                            jsonrpc::JSON_OBJECT, NULL),
         &AbstractZServer::GetGasEstimateI);
     this->bindAndAddMethod(
@@ -212,6 +213,11 @@ class AbstractZServer : public jsonrpc::AbstractServer<AbstractZServer> {
                            jsonrpc::JSON_OBJECT, "param01",
                            jsonrpc::JSON_STRING, NULL),
         &AbstractZServer::GetSmartContractInitI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("GetEventLogs", jsonrpc::PARAMS_BY_POSITION,
+                           jsonrpc::JSON_ARRAY, "param01",
+                           jsonrpc::JSON_OBJECT, NULL),
+        &AbstractZServer::GetEventLogsI);
   }
 
   inline virtual void GetNetworkIdI(const Json::Value& request,
@@ -373,6 +379,10 @@ class AbstractZServer : public jsonrpc::AbstractServer<AbstractZServer> {
                                             Json::Value& response) {
     response = this->GetSmartContractInit(request[0u].asString());
   }
+  inline virtual void GetEventLogsI(const Json::Value& request,
+                                    Json::Value& response) {
+    response = this->GetEventLogs(request[0u]);
+  }
   virtual std::string GetNetworkId() = 0;
   virtual Json::Value CreateTransaction(const Json::Value& param01) = 0;
   virtual Json::Value GetTransaction(const std::string& param01) = 0;
@@ -386,7 +396,7 @@ class AbstractZServer : public jsonrpc::AbstractServer<AbstractZServer> {
   virtual std::string GetContractAddressFromTransactionID(
       const std::string& param01) = 0;
   virtual std::string CreateMessage(const Json::Value& param01) = 0;
-  virtual std::string GetGasEstimate(const Json::Value& param01) = 0;
+  virtual Json::Value GetGasEstimate(const Json::Value& param01) = 0;
   virtual unsigned int GetNumPeers() = 0;
   virtual std::string GetNumTxBlocks() = 0;
   virtual std::string GetNumDSBlocks() = 0;
@@ -408,6 +418,7 @@ class AbstractZServer : public jsonrpc::AbstractServer<AbstractZServer> {
   virtual Json::Value GetSmartContractState(const std::string& param01) = 0;
   virtual Json::Value GetSmartContractInit(const std::string& param01) = 0;
   virtual Json::Value GetSmartContractCode(const std::string& param01) = 0;
+  virtual Json::Value GetEventLogs(const Json::Value& param01) = 0;
 };
 
 class Server : public AbstractZServer {
@@ -420,6 +431,7 @@ class Server : public AbstractZServer {
   std::pair<uint64_t, CircularArray<std::string>> m_TxBlockCache;
   static CircularArray<std::string> m_RecentTransactions;
   static std::mutex m_mutexRecentTxns;
+  std::atomic<unsigned int> m_numGasEstimates{0};
 
  public:
   Server(Mediator& mediator, jsonrpc::HttpServer& httpserver);
@@ -438,7 +450,7 @@ class Server : public AbstractZServer {
   virtual std::string GetContractAddressFromTransactionID(
       const std::string& tranID);
   virtual std::string CreateMessage(const Json::Value& _json);
-  virtual std::string GetGasEstimate(const Json::Value& _json);
+  virtual Json::Value GetGasEstimate(const Json::Value& _json);
   virtual unsigned int GetNumPeers();
   virtual std::string GetNumTxBlocks();
   virtual std::string GetNumDSBlocks();
@@ -468,4 +480,5 @@ class Server : public AbstractZServer {
   Json::Value GetSmartContractState(const std::string& address);
   Json::Value GetSmartContractInit(const std::string& address);
   Json::Value GetSmartContractCode(const std::string& address);
+  Json::Value GetEventLogs(const Json::Value& _json);
 };
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __BLOCKINGQUEUE_H__
+#define __BLOCKINGQUEUE_H__
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Power-of-two bucketed histogram, bucket i counts values in [2^(i-1), 2^i)
+class Log2Histogram {
+  static const unsigned int NUM_BUCKETS = 32;
+  std::array<uint64_t, NUM_BUCKETS> m_buckets{};
+
+ public:
+  void Add(uint64_t value) {
+    unsigned int bucket = 0;
+    while (value > 0 && bucket < NUM_BUCKETS - 1) {
+      value >>= 1;
+      bucket++;
+    }
+    m_buckets[bucket]++;
+  }
+
+  uint64_t GetCount() const {
+    uint64_t count = 0;
+    for (const auto& b : m_buckets) {
+      count += b;
+    }
+    return count;
+  }
+
+  /// Prints the non-empty buckets as "<upper bound>:<count>"
+  std::string ToString() const {
+    std::ostringstream oss;
+    for (unsigned int i = 0; i < NUM_BUCKETS; i++) {
+      if (m_buckets[i] > 0) {
+        oss << "<" << (1ULL << i) << ":" << m_buckets[i] << " ";
+      }
+    }
+    return oss.str();
+  }
+
+  void Clear() { m_buckets.fill(0); }
+};
+
+/// Bounded multi-producer multi-consumer queue. Consumers sleep on a
+/// condition variable until items arrive instead of polling. Queue depth at
+/// push time and the wait time of each item (in microseconds) are tracked for
+/// monitoring.
+template <class T>
+class BlockingQueue {
+  using Clock = std::chrono::steady_clock;
+
+  std::mutex m_mutex;
+  std::condition_variable m_notEmpty;
+  std::deque<std::pair<T, Clock::time_point>> m_queue;
+  const size_t m_capacity;
+
+  Log2Histogram m_depthHistogram;
+  Log2Histogram m_waitHistogram;
+
+ public:
+  explicit BlockingQueue(size_t capacity) : m_capacity(capacity) {}
+
+  /// Returns false without queuing the item if the queue is full.
+  bool Push(const T& item) {
+    {
+      std::lock_guard<std::mutex> g(m_mutex);
+      if (m_queue.size() >= m_capacity) {
+        return false;
+      }
+      m_depthHistogram.Add(m_queue.size());
+      m_queue.emplace_back(item, Clock::now());
+    }
+    m_notEmpty.notify_one();
+    return true;
+  }
+
+  /// Returns false if the queue is empty.
+  bool TryPop(T& item) {
+    std::lock_guard<std::mutex> g(m_mutex);
+    if (m_queue.empty()) {
+      return false;
+    }
+    item = PopFrontLocked();
+    return true;
+  }
+
+  /// Blocks until at least one item is available or the timeout passes, then
+  /// moves up to maxItems items into items. Returns the number moved.
+  size_t PopBatch(std::vector<T>& items, size_t maxItems,
+                  const std::chrono::milliseconds& timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_notEmpty.wait_for(lock, timeout,
+                             [this] { return !m_queue.empty(); })) {
+      return 0;
+    }
+
+    size_t count = 0;
+    while (!m_queue.empty() && count < maxItems) {
+      items.emplace_back(PopFrontLocked());
+      count++;
+    }
+    return count;
+  }
+
+  size_t size() {
+    std::lock_guard<std::mutex> g(m_mutex);
+    return m_queue.size();
+  }
+
+  /// Returns the depth and wait time histograms and resets them.
+  std::string GetAndResetStats() {
+    std::lock_guard<std::mutex> g(m_mutex);
+    std::ostringstream oss;
+    oss << "Pushed: " << m_depthHistogram.GetCount()
+        << " Depth: " << m_depthHistogram.ToString()
+        << "Wait(us): " << m_waitHistogram.ToString();
+    m_depthHistogram.Clear();
+    m_waitHistogram.Clear();
+    return oss.str();
+  }
+
+ private:
+  T PopFrontLocked() {
+    auto& front = m_queue.front();
+    m_waitHistogram.Add(std::chrono::duration_cast<std::chrono::microseconds>(
+                            Clock::now() - front.second)
+                            .count());
+    T item = std::move(front.first);
+    m_queue.pop_front();
+    return item;
+  }
+};
+
+#endif  // __BLOCKINGQUEUE_H__
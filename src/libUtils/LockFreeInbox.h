@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LOCKFREEINBOX_H__
+#define __LOCKFREEINBOX_H__
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+/// Unbounded multi-producer inbox. Producers push with a single
+/// compare-and-swap and never block. The consumer takes everything queued so
+/// far in one atomic exchange and gets it back oldest first.
+template <class T>
+class LockFreeInbox {
+  struct Node {
+    T item;
+    Node* next;
+  };
+
+  std::atomic<Node*> m_head{nullptr};
+
+ public:
+  LockFreeInbox() = default;
+  LockFreeInbox(LockFreeInbox const&) = delete;
+  void operator=(LockFreeInbox const&) = delete;
+
+  ~LockFreeInbox() {
+    std::vector<T> items;
+    TakeAll(items);
+  }
+
+  /// Returns true if the inbox was empty before this item, i.e. when a
+  /// sleeping consumer may need waking up.
+  bool Push(T item) {
+    // The node may be taken and freed as soon as it is published, so the
+    // previous head is kept in a local rather than read back from it
+    Node* node = new Node{std::move(item), nullptr};
+    Node* expected = m_head.load(std::memory_order_relaxed);
+    do {
+      node->next = expected;
+    } while (!m_head.compare_exchange_weak(expected, node,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed));
+    return expected == nullptr;
+  }
+
+  /// Moves every queued item into items, oldest first. Returns the number
+  /// moved.
+  size_t TakeAll(std::vector<T>& items) {
+    Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+    // The list is newest first, reverse it
+    Node* oldest = nullptr;
+    while (node != nullptr) {
+      Node* next = node->next;
+      node->next = oldest;
+      oldest = node;
+      node = next;
+    }
+
+    size_t count = 0;
+    while (oldest != nullptr) {
+      Node* next = oldest->next;
+      items.emplace_back(std::move(oldest->item));
+      delete oldest;
+      oldest = next;
+      count++;
+    }
+    return count;
+  }
+
+  bool empty() const {
+    return m_head.load(std::memory_order_acquire) == nullptr;
+  }
+};
+
+#endif  // __LOCKFREEINBOX_H__
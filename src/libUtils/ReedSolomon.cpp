@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+
+#include "ReedSolomon.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+
+/// Log and exponent tables of GF(2^8) with polynomial x^8+x^4+x^3+x^2+1
+class GaloisField {
+  array<unsigned char, 512> m_exp{};
+  array<unsigned int, 256> m_log{};
+
+ public:
+  GaloisField() {
+    unsigned int x = 1;
+    for (unsigned int i = 0; i < 255; i++) {
+      m_exp[i] = x;
+      m_log[x] = i;
+      x <<= 1;
+      if (x & 0x100) {
+        x ^= 0x11D;
+      }
+    }
+    for (unsigned int i = 255; i < m_exp.size(); i++) {
+      m_exp[i] = m_exp[i - 255];
+    }
+  }
+
+  unsigned char Mul(unsigned char a, unsigned char b) const {
+    return (a == 0 || b == 0) ? 0 : m_exp[m_log[a] + m_log[b]];
+  }
+
+  unsigned char Inv(unsigned char a) const { return m_exp[255 - m_log[a]]; }
+
+  /// dst ^= coefficient * src, byte by byte
+  void MulAdd(unsigned char coefficient, const unsigned char* src,
+              unsigned char* dst, size_t size) const {
+    if (coefficient == 0) {
+      return;
+    }
+    array<unsigned char, 256> row;
+    for (unsigned int i = 0; i < row.size(); i++) {
+      row[i] = Mul(coefficient, i);
+    }
+    for (size_t i = 0; i < size; i++) {
+      dst[i] ^= row[src[i]];
+    }
+  }
+};
+
+const GaloisField& GF() {
+  static const GaloisField gf;
+  return gf;
+}
+
+}  // namespace
+
+ReedSolomon::ReedSolomon(unsigned int dataShards, unsigned int parityShards)
+    : m_dataShards(dataShards), m_parityShards(parityShards) {}
+
+unsigned char ReedSolomon::ParityCoefficient(unsigned int row,
+                                             unsigned int col) const {
+  // Cauchy matrix 1 / (x_row + y_col) with x_row = dataShards + row and
+  // y_col = col, so every square submatrix of [I; C] is invertible
+  return GF().Inv((m_dataShards + row) ^ col);
+}
+
+bool ReedSolomon::Encode(const bytes& data, vector<bytes>& shards) const {
+  if (m_dataShards == 0 || GetTotalShards() > MAX_SHARDS) {
+    LOG_GENERAL(WARNING, "Unsupported shard counts " << m_dataShards << "+"
+                                                     << m_parityShards);
+    return false;
+  }
+
+  const size_t shardSize =
+      max<size_t>(1, (data.size() + m_dataShards - 1) / m_dataShards);
+
+  shards.assign(GetTotalShards(), bytes(shardSize, 0));
+  for (unsigned int i = 0; i < m_dataShards; i++) {
+    const size_t offset = i * shardSize;
+    if (offset < data.size()) {
+      const size_t size = min(shardSize, data.size() - offset);
+      copy(data.begin() + offset, data.begin() + offset + size,
+           shards[i].begin());
+    }
+  }
+
+  for (unsigned int row = 0; row < m_parityShards; row++) {
+    bytes& parity = shards[m_dataShards + row];
+    for (unsigned int col = 0; col < m_dataShards; col++) {
+      GF().MulAdd(ParityCoefficient(row, col), shards[col].data(),
+                  parity.data(), shardSize);
+    }
+  }
+
+  return true;
+}
+
+bool ReedSolomon::Decode(const map<unsigned int, bytes>& shards,
+                         size_t dataSize, bytes& data) const {
+  if (m_dataShards == 0 || GetTotalShards() > MAX_SHARDS) {
+    LOG_GENERAL(WARNING, "Unsupported shard counts " << m_dataShards << "+"
+                                                     << m_parityShards);
+    return false;
+  }
+
+  if (shards.size() < m_dataShards) {
+    LOG_GENERAL(WARNING, "Only " << shards.size() << " of " << m_dataShards
+                                 << " shards needed");
+    return false;
+  }
+
+  const size_t shardSize = shards.begin()->second.size();
+  if (dataSize > shardSize * m_dataShards) {
+    LOG_GENERAL(WARNING, "Shards too small for " << dataSize << " bytes");
+    return false;
+  }
+
+  // Take the first dataShards shards; data shards sort first, so as many of
+  // them as possible are copied instead of decoded
+  vector<unsigned int> indexes;
+  vector<const bytes*> inputs;
+  for (const auto& entry : shards) {
+    if (indexes.size() == m_dataShards) {
+      break;
+    }
+    if (entry.first >= GetTotalShards() || entry.second.size() != shardSize) {
+      LOG_GENERAL(WARNING, "Invalid shard " << entry.first);
+      return false;
+    }
+    indexes.push_back(entry.first);
+    inputs.push_back(&entry.second);
+  }
+
+  // Rows of the encoding matrix for the shards we have, inverted in place
+  // by Gauss-Jordan elimination
+  const unsigned int k = m_dataShards;
+  vector<vector<unsigned char>> matrix(k, vector<unsigned char>(k, 0));
+  vector<vector<unsigned char>> inverse(k, vector<unsigned char>(k, 0));
+  for (unsigned int r = 0; r < k; r++) {
+    for (unsigned int c = 0; c < k; c++) {
+      matrix[r][c] = indexes[r] < k ? (indexes[r] == c ? 1 : 0)
+                                    : ParityCoefficient(indexes[r] - k, c);
+    }
+    inverse[r][r] = 1;
+  }
+
+  for (unsigned int c = 0; c < k; c++) {
+    unsigned int pivot = c;
+    while (pivot < k && matrix[pivot][c] == 0) {
+      pivot++;
+    }
+    if (pivot == k) {
+      LOG_GENERAL(WARNING, "Singular decoding matrix");
+      return false;
+    }
+    swap(matrix[c], matrix[pivot]);
+    swap(inverse[c], inverse[pivot]);
+
+    const unsigned char scale = GF().Inv(matrix[c][c]);
+    for (unsigned int i = 0; i < k; i++) {
+      matrix[c][i] = GF().Mul(matrix[c][i], scale);
+      inverse[c][i] = GF().Mul(inverse[c][i], scale);
+    }
+
+    for (unsigned int r = 0; r < k; r++) {
+      const unsigned char factor = matrix[r][c];
+      if (r == c || factor == 0) {
+        continue;
+      }
+      for (unsigned int i = 0; i < k; i++) {
+        matrix[r][i] ^= GF().Mul(factor, matrix[c][i]);
+        inverse[r][i] ^= GF().Mul(factor, inverse[c][i]);
+      }
+    }
+  }
+
+  data.assign(shardSize * k, 0);
+  for (unsigned int r = 0; r < k; r++) {
+    unsigned char* out = data.data() + r * shardSize;
+    if (indexes[r] == r) {
+      copy(inputs[r]->begin(), inputs[r]->end(), out);
+      continue;
+    }
+    for (unsigned int c = 0; c < k; c++) {
+      GF().MulAdd(inverse[r][c], inputs[c]->data(), out, shardSize);
+    }
+  }
+  data.resize(dataSize);
+
+  return true;
+}
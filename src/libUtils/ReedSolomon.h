@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __REEDSOLOMON_H__
+#define __REEDSOLOMON_H__
+
+#include <map>
+#include <vector>
+
+#include "common/BaseType.h"
+
+/// Systematic Reed-Solomon erasure code over GF(2^8).
+///
+/// Data is cut into dataShards equal shards (the last one zero padded) and
+/// parityShards parity shards are computed from a Cauchy matrix, so any
+/// dataShards of the dataShards + parityShards shards rebuild the data.
+class ReedSolomon {
+  const unsigned int m_dataShards;
+  const unsigned int m_parityShards;
+
+  /// Coefficient of data shard col in parity shard row
+  unsigned char ParityCoefficient(unsigned int row, unsigned int col) const;
+
+ public:
+  /// At most 256 shards in total are supported
+  static const unsigned int MAX_SHARDS = 256;
+
+  ReedSolomon(unsigned int dataShards, unsigned int parityShards);
+
+  unsigned int GetDataShards() const { return m_dataShards; }
+  unsigned int GetTotalShards() const { return m_dataShards + m_parityShards; }
+
+  /// Returns the data shards followed by the parity shards
+  bool Encode(const bytes& data, std::vector<bytes>& shards) const;
+
+  /// Rebuilds dataSize bytes of data from at least dataShards shards, keyed
+  /// by shard index
+  bool Decode(const std::map<unsigned int, bytes>& shards, size_t dataSize,
+              bytes& data) const;
+};
+
+#endif  // __REEDSOLOMON_H__
@@ -56,7 +56,7 @@ TxnHash ConcatTranAndHash(const Container&... conts) {
         hasValue = true;
 
         for (auto& item : list) {
-          sha2.Update(GetHash(item).asBytes());
+          sha2.Update(GetHash(item).data(), TxnHash::size);
         }
       }(conts, sha2, hasValue),
       0)...};
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WEIGHTEDFAIRSCHEDULER_H__
+#define __WEIGHTEDFAIRSCHEDULER_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libUtils/BlockingQueue.h"
+
+/// Thread pool with one job queue per class. Idle threads pick the next class
+/// by smooth weighted round-robin among the classes that have queued jobs and
+/// are below their concurrency limit, so a flood in one class cannot starve
+/// the others. Queueing delay (in microseconds) is tracked per class.
+class WeightedFairScheduler {
+ public:
+  typedef std::function<void()> Job;
+
+  struct ClassConfig {
+    std::string name;
+    unsigned int weight;
+    unsigned int maxConcurrent;
+  };
+
+  WeightedFairScheduler(const unsigned int threadCount,
+                        const std::string& poolName,
+                        const std::vector<ClassConfig>& classes)
+      : m_poolName(poolName) {
+    for (const auto& config : classes) {
+      m_classes.emplace_back(config);
+    }
+
+    m_threads.reserve(threadCount);
+    for (unsigned int index = 0; index < threadCount; ++index) {
+      m_threads.emplace_back([this] { this->Task(); });
+    }
+  }
+
+  ~WeightedFairScheduler() {
+    {
+      std::lock_guard<std::mutex> g(m_mutex);
+      m_bailout = true;
+    }
+    m_jobAvailable.notify_all();
+
+    for (auto& thread : m_threads) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+
+    // Jobs still queued never run, release what they hold now
+    for (auto& jc : m_classes) {
+      jc.jobs.clear();
+    }
+  }
+
+  /// Queues a job in the given class. Out of range classes go to the last
+  /// (lowest priority) class. Jobs still queued at destruction are dropped
+  /// without running, so a job must own whatever it needs to free.
+  void AddJob(unsigned int jobClass, const Job& job) {
+    {
+      std::lock_guard<std::mutex> g(m_mutex);
+      if (jobClass >= m_classes.size()) {
+        jobClass = m_classes.size() - 1;
+      }
+      m_classes[jobClass].jobs.emplace_back(job, Clock::now());
+    }
+    m_jobAvailable.notify_one();
+  }
+
+  /// Returns the queue length and queueing delay histogram of every class and
+  /// resets the histograms.
+  std::string GetAndResetStats() {
+    std::lock_guard<std::mutex> g(m_mutex);
+    std::ostringstream oss;
+    oss << m_poolName;
+    for (auto& jc : m_classes) {
+      oss << " [" << jc.config.name << " Queued: " << jc.jobs.size()
+          << " Running: " << jc.running
+          << " Delay(us): " << jc.delayHistogram.ToString() << "]";
+      jc.delayHistogram.Clear();
+    }
+    return oss.str();
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct JobClass {
+    ClassConfig config;
+    std::deque<std::pair<Job, Clock::time_point>> jobs;
+    unsigned int running = 0;
+    int64_t credit = 0;
+    Log2Histogram delayHistogram;
+
+    explicit JobClass(const ClassConfig& c) : config(c) {}
+  };
+
+  std::string m_poolName;
+  std::vector<JobClass> m_classes;
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_jobAvailable;
+  bool m_bailout = false;
+
+  bool PickClassLocked(unsigned int& picked) {
+    int64_t totalWeight = 0;
+    bool found = false;
+
+    for (unsigned int i = 0; i < m_classes.size(); i++) {
+      JobClass& jc = m_classes[i];
+      if (jc.jobs.empty() || jc.running >= jc.config.maxConcurrent) {
+        continue;
+      }
+      jc.credit += jc.config.weight;
+      totalWeight += jc.config.weight;
+      if (!found || jc.credit > m_classes[picked].credit) {
+        picked = i;
+        found = true;
+      }
+    }
+
+    if (found) {
+      m_classes[picked].credit -= totalWeight;
+    }
+    return found;
+  }
+
+  void Task() {
+    while (true) {
+      Job job;
+      unsigned int picked = 0;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_jobAvailable.wait(lock, [this, &picked] {
+          return m_bailout || PickClassLocked(picked);
+        });
+        if (m_bailout) {
+          return;
+        }
+
+        JobClass& jc = m_classes[picked];
+        jc.delayHistogram.Add(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - jc.jobs.front().second)
+                .count());
+        job = std::move(jc.jobs.front().first);
+        jc.jobs.pop_front();
+        jc.running++;
+      }
+
+      job();
+
+      // No wake-up needed: this thread re-checks all classes, including one
+      // that was capped by this job, before it waits again
+      std::lock_guard<std::mutex> g(m_mutex);
+      m_classes[picked].running--;
+    }
+  }
+};
+
+#endif  // __WEIGHTEDFAIRSCHEDULER_H__
@@ -57,8 +57,7 @@ bool Validator::CheckCreatedTransaction(const Transaction& tx,
   }
 
   // Check if from account is sharded here
-  const PubKey& senderPubKey = tx.GetSenderPubKey();
-  Address fromAddr = Account::GetAddressFromPublicKey(senderPubKey);
+  const Address& fromAddr = tx.GetSenderAddr();
 
   if (fromAddr == Address()) {
     LOG_GENERAL(WARNING, "Invalid address for issuing transactions");
@@ -106,8 +105,7 @@ bool Validator::CheckCreatedTransactionFromLookup(const Transaction& tx) {
   }
 
   // Check if from account is sharded here
-  const PubKey& senderPubKey = tx.GetSenderPubKey();
-  Address fromAddr = Account::GetAddressFromPublicKey(senderPubKey);
+  const Address& fromAddr = tx.GetSenderAddr();
   unsigned int shardId = m_mediator.m_node->GetShardId();
   unsigned int numShards = m_mediator.m_node->getNumShards();
 
@@ -117,8 +115,7 @@ bool Validator::CheckCreatedTransactionFromLookup(const Transaction& tx) {
   }
 
   if (m_mediator.m_ds->m_mode == DirectoryService::Mode::IDLE) {
-    unsigned int correct_shard_from =
-        Transaction::GetShardIndex(fromAddr, numShards);
+    unsigned int correct_shard_from = tx.GetShardIndex(numShards);
     if (correct_shard_from != shardId) {
       LOG_EPOCH(WARNING, to_string(m_mediator.m_currentEpochNum).c_str(),
                 "This tx is not sharded to me!"
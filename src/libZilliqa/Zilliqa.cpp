@@ -22,6 +22,7 @@
 #include "Zilliqa.h"
 #include "common/Constants.h"
 #include "common/MessageNames.h"
+#include "common/Messages.h"
 #include "common/Serializable.h"
 #include "libArchival/Archival.h"
 #include "libCrypto/Schnorr.h"
@@ -77,7 +78,62 @@ void Zilliqa::LogSelfNodeInfo(const PairOfKey& key, const Peer& peer) {
          MessageTypeInstructionStrings[msgType][instruction];
 }
 
-void Zilliqa::ProcessMessage(pair<bytes, Peer>* message) {
+/*static*/ vector<WeightedFairScheduler::ClassConfig>
+Zilliqa::GetMessageClasses() {
+  // Bulk classes are capped to a share of the pool so that a flood of them
+  // always leaves threads free for consensus and block messages
+  const unsigned int quarter = max(1u, MAXMESSAGE / 4);
+  return {{"Consensus", 16, MAXMESSAGE},
+          {"Block", 8, MAXMESSAGE},
+          {"PoW", 4, max(1u, MAXMESSAGE / 2)},
+          {"Txn", 2, quarter},
+          {"Lookup", 1, quarter}};
+}
+
+/*static*/ unsigned int Zilliqa::GetMessageClass(const bytes& message) {
+  if (message.size() < MessageOffset::BODY) {
+    return MSG_CLASS_LOOKUP;
+  }
+
+  const unsigned char ins_byte = message.at(MessageOffset::INST);
+
+  switch (message.at(MessageOffset::TYPE)) {
+    case MessageType::DIRECTORY:
+      switch (ins_byte) {
+        case DSInstructionType::SETPRIMARY:
+        case DSInstructionType::DSBLOCKCONSENSUS:
+        case DSInstructionType::FINALBLOCKCONSENSUS:
+        case DSInstructionType::VIEWCHANGECONSENSUS:
+          return MSG_CLASS_CONSENSUS;
+        case DSInstructionType::POWSUBMISSION:
+        case DSInstructionType::POWPACKETSUBMISSION:
+          return MSG_CLASS_POW;
+        default:
+          return MSG_CLASS_BLOCK;
+      }
+    case MessageType::NODE:
+      switch (ins_byte) {
+        case NodeInstructionType::MICROBLOCKCONSENSUS:
+        case NodeInstructionType::FALLBACKCONSENSUS:
+          return MSG_CLASS_CONSENSUS;
+        case NodeInstructionType::PROPOSEGASPRICE:
+          return MSG_CLASS_POW;
+        case NodeInstructionType::SUBMITTRANSACTION:
+        case NodeInstructionType::FORWARDTXNPACKET:
+          return MSG_CLASS_TXN;
+        default:
+          return MSG_CLASS_BLOCK;
+      }
+    case MessageType::LOOKUP:
+      return (ins_byte == LookupInstructionType::FORWARDTXN)
+                 ? MSG_CLASS_TXN
+                 : MSG_CLASS_LOOKUP;
+    default:
+      return MSG_CLASS_LOOKUP;
+  }
+}
+
+void Zilliqa::ProcessMessage(const pair<bytes, Peer>* message) {
   if (message->first.size() >= MessageOffset::BODY) {
     const unsigned char msg_type = message->first.at(MessageOffset::TYPE);
 
@@ -124,8 +180,6 @@ void Zilliqa::ProcessMessage(pair<bytes, Peer>* message) {
                                                    << (unsigned int)msg_type);
     }
   }
-
-  delete message;
 }
 
 Zilliqa::Zilliqa(const PairOfKey& key, const Peer& peer, bool loadConfig,
@@ -148,15 +202,29 @@ Zilliqa::Zilliqa(const PairOfKey& key, const Peer& peer, bool loadConfig,
 
   // Launch the thread that reads messages from the queue
   auto funcCheckMsgQueue = [this]() mutable -> void {
-    pair<bytes, Peer>* message = NULL;
+    vector<pair<bytes, Peer>*> messages;
+    auto lastStatsTime = chrono::steady_clock::now();
     while (true) {
-      while (m_msgQueue.pop(message)) {
-        // For now, we use a thread pool to handle this message
-        // Eventually processing will be single-threaded
-        m_queuePool.AddJob(
-            [this, message]() mutable -> void { ProcessMessage(message); });
+      messages.clear();
+      m_msgQueue.PopBatch(messages, MSGQUEUE_SIZE, chrono::milliseconds(1000));
+      for (auto message : messages) {
+        // The job owns the message, so it is freed even if the pool shuts
+        // down before the job runs
+        const shared_ptr<const pair<bytes, Peer>> owned(message);
+
+        // Consensus messages are served ahead of bulk txn and lookup traffic
+        m_queuePool.AddJob(GetMessageClass(owned->first),
+                           [this, owned]() -> void {
+                             ProcessMessage(owned.get());
+                           });
+      }
+
+      if (chrono::steady_clock::now() - lastStatsTime >=
+          chrono::seconds(MSGQUEUE_STATS_INTERVAL_IN_SECONDS)) {
+        LOG_GENERAL(INFO, "[MsgQueue] " << m_msgQueue.GetAndResetStats());
+        LOG_GENERAL(INFO, "[MsgQueue] " << m_queuePool.GetAndResetStats());
+        lastStatsTime = chrono::steady_clock::now();
       }
-      std::this_thread::sleep_for(std::chrono::microseconds(1));
     }
   };
   DetachedFunction(1, funcCheckMsgQueue);
@@ -306,7 +374,7 @@ Zilliqa::Zilliqa(const PairOfKey& key, const Peer& peer, bool loadConfig,
 
 Zilliqa::~Zilliqa() {
   pair<bytes, Peer>* message = NULL;
-  while (m_msgQueue.pop(message)) {
+  while (m_msgQueue.TryPop(message)) {
     delete message;
   }
 }
@@ -315,8 +383,9 @@ void Zilliqa::Dispatch(pair<bytes, Peer>* message) {
   // LOG_MARKER();
 
   // Queue message
-  if (!m_msgQueue.bounded_push(message)) {
+  if (!m_msgQueue.Push(message)) {
     LOG_GENERAL(WARNING, "Input MsgQueue is full");
+    delete message;
   }
 }
 
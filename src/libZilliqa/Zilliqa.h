@@ -32,7 +32,8 @@
 #include "libNetwork/PeerStore.h"
 #include "libNode/Node.h"
 #include "libServer/Server.h"
-#include "libUtils/ThreadPool.h"
+#include "libUtils/BlockingQueue.h"
+#include "libUtils/WeightedFairScheduler.h"
 
 /// Main Zilliqa class.
 class Zilliqa {
@@ -46,14 +47,27 @@ class Zilliqa {
   Archival m_arch;
   // ConsensusUser m_cu; // Note: This is just a test class to demo Consensus
   // usage
-  boost::lockfree::queue<std::pair<bytes, Peer>*> m_msgQueue;
+  BlockingQueue<std::pair<bytes, Peer>*> m_msgQueue;
 
   jsonrpc::HttpServer m_httpserver;
   Server m_server;
 
-  ThreadPool m_queuePool{MAXMESSAGE, "QueuePool"};
+  /// Inbound scheduling classes, highest priority first
+  enum MessageClass : unsigned int {
+    MSG_CLASS_CONSENSUS = 0,
+    MSG_CLASS_BLOCK,
+    MSG_CLASS_POW,
+    MSG_CLASS_TXN,
+    MSG_CLASS_LOOKUP,
+  };
 
-  void ProcessMessage(std::pair<bytes, Peer>* message);
+  static std::vector<WeightedFairScheduler::ClassConfig> GetMessageClasses();
+  static unsigned int GetMessageClass(const bytes& message);
+
+  WeightedFairScheduler m_queuePool{MAXMESSAGE, "QueuePool",
+                                    GetMessageClasses()};
+
+  void ProcessMessage(const std::pair<bytes, Peer>* message);
 
  public:
   /// Constructor.
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <random>
+#include "libCrypto/Sha256Batch.h"
+#include "libCrypto/Sha2.h"
+#include "libUtils/DataConversion.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE sha256batchtest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+static const unsigned int MAX_MESSAGE_SIZE = 300;
+static const unsigned int NUM_TXNS = 20000;
+static const unsigned int TXN_SIZE = 180;
+
+static vector<bytes> RandomMessages(unsigned int count, unsigned int minSize,
+                                    unsigned int maxSize) {
+  mt19937 gen(count);
+  uniform_int_distribution<unsigned int> size(minSize, maxSize);
+  vector<bytes> messages(count);
+  for (auto& message : messages) {
+    message.resize(size(gen));
+    for (auto& b : message) {
+      b = static_cast<unsigned char>(gen());
+    }
+  }
+  return messages;
+}
+
+static bytes Expected(const bytes& message) {
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
+  sha2.Update(message.data(), message.size());
+  return sha2.Finalize();
+}
+
+BOOST_AUTO_TEST_SUITE(sha256batchtest)
+
+BOOST_AUTO_TEST_CASE(test_known_vector) {
+  INIT_STDOUT_LOGGER();
+
+  const string abc = "abc";
+  const vector<bytes> messages(9, bytes(abc.begin(), abc.end()));
+  vector<SHA256Batch::Digest> digests;
+  SHA256Batch::Hash(messages, digests);
+
+  bytes expected;
+  DataConversion::HexStrToUint8Vec(
+      "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD",
+      expected);
+  BOOST_REQUIRE_EQUAL(digests.size(), messages.size());
+  for (const auto& digest : digests) {
+    BOOST_CHECK(equal(expected.begin(), expected.end(), digest.begin(),
+                      digest.end()));
+  }
+}
+
+/// Every length up to a few blocks, including those whose padding spills
+/// into an extra block, in an order that mixes block counts
+BOOST_AUTO_TEST_CASE(test_batch_matches_sha2) {
+  INIT_STDOUT_LOGGER();
+
+  vector<bytes> messages = RandomMessages(1000, 0, MAX_MESSAGE_SIZE);
+  for (unsigned int size = 0; size <= MAX_MESSAGE_SIZE; size++) {
+    messages.emplace_back(size, static_cast<unsigned char>(size));
+  }
+
+  vector<SHA256Batch::Digest> serial, batch, vectorized;
+  SHA256Batch::HashSerial(messages, serial);
+  SHA256Batch::Hash(messages, batch);
+  const bool hasVectorized = SHA256Batch::HashVectorized(messages, vectorized);
+
+  BOOST_REQUIRE_EQUAL(serial.size(), messages.size());
+  BOOST_REQUIRE_EQUAL(batch.size(), messages.size());
+  for (unsigned int i = 0; i < messages.size(); i++) {
+    const bytes expected = Expected(messages[i]);
+    BOOST_CHECK(equal(expected.begin(), expected.end(), serial[i].begin()));
+    BOOST_CHECK(batch[i] == serial[i]);
+    if (hasVectorized) {
+      BOOST_CHECK(vectorized[i] == serial[i]);
+    }
+  }
+
+  // Digests of a previous call are replaced, not appended to
+  SHA256Batch::Hash({}, batch);
+  BOOST_CHECK(batch.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_transaction_sized_throughput) {
+  INIT_STDOUT_LOGGER();
+
+  const vector<bytes> messages = RandomMessages(NUM_TXNS, TXN_SIZE, TXN_SIZE);
+  vector<SHA256Batch::Digest> digests;
+
+  auto start = chrono::steady_clock::now();
+  SHA256Batch::HashSerial(messages, digests);
+  const double serialSeconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  start = chrono::steady_clock::now();
+  SHA256Batch::Hash(messages, digests);
+  const double batchSeconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  LOG_GENERAL(INFO, NUM_TXNS << " messages of " << TXN_SIZE
+                             << " bytes: serial " << NUM_TXNS / serialSeconds
+                             << " msg/s, batch " << NUM_TXNS / batchSeconds
+                             << " msg/s");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -126,6 +126,88 @@ BOOST_AUTO_TEST_CASE(testStorage) {
   acc1.InitStorage();  // Improve coverage
 }
 
+BOOST_AUTO_TEST_CASE(testBufferedStorage) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  bytes code = dev::h256::random().asBytes();
+
+  Account acc1(0, 0), acc2(0, 0);
+  acc1.SetCode(code);
+  acc2.SetCode(code);
+
+  const unsigned int NUM_FIELDS = 50;
+  for (unsigned int i = 0; i < NUM_FIELDS; i++) {
+    std::string vname = "field" + std::to_string(i);
+    std::string value = std::to_string(TestUtils::DistUint64());
+    acc1.SetStorage(vname, "Uint128", value);
+    acc2.BufferStorage(vname, "Uint128", value);
+  }
+
+  // Staged writes are visible before the flush
+  BOOST_CHECK_EQUAL(3, acc2.GetStorage("field0").size());
+  BOOST_CHECK_EQUAL(acc1.GetStorage("field1")[2],
+                    acc2.GetStorage("field1")[2]);
+
+  acc2.FlushStorageBuffer();
+  BOOST_CHECK_EQUAL(acc1.GetStorageRoot(), acc2.GetStorageRoot());
+
+  // Rewriting an unchanged value leaves the root untouched
+  dev::h256 root = acc2.GetStorageRoot();
+  acc2.BufferStorage("field0", "Uint128", acc2.GetStorage("field0")[2]);
+  acc2.FlushStorageBuffer();
+  BOOST_CHECK_EQUAL(root, acc2.GetStorageRoot());
+
+  // Staged writes are discarded on rollback
+  acc2.Commit();
+  acc2.BufferStorage("field0", "Uint128", "0");
+  acc2.RollBack();
+  BOOST_CHECK_EQUAL(root, acc2.GetStorageRoot());
+  BOOST_CHECK_EQUAL(acc1.GetStorage("field0")[2],
+                    acc2.GetStorage("field0")[2]);
+}
+
+BOOST_AUTO_TEST_CASE(testCopySharesContractData) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  bytes code(TestUtils::DistUint16() + 1, 'c');
+  std::string init =
+      "[{\"vname\":\"name\",\"type\":\"sometype\",\"value\":\"v\"}]";
+
+  Account acc1(TestUtils::DistUint64(), 0);
+  acc1.SetCode(code);
+  acc1.InitContract(bytes(init.begin(), init.end()));
+
+  const unsigned int NUM_COPIES = 10000;
+  std::vector<Account> copies;
+  copies.reserve(NUM_COPIES);
+  auto t_start = std::chrono::high_resolution_clock::now();
+  for (unsigned int i = 0; i < NUM_COPIES; i++) {
+    copies.emplace_back(acc1);
+  }
+  auto t_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> elapsed = t_end - t_start;
+  LOG_GENERAL(INFO, "Copied a contract account with "
+                        << code.size() << " bytes of code " << NUM_COPIES
+                        << " times in " << elapsed.count() << " ms");
+
+  // Copies share the code and init data of the original
+  Account& acc2 = copies.back();
+  BOOST_CHECK_EQUAL(acc1.GetCode().data(), acc2.GetCode().data());
+  BOOST_CHECK_EQUAL(&acc1.GetInitJson(), &acc2.GetInitJson());
+
+  // Scalar updates stay local to the copy
+  acc2.IncreaseNonce();
+  BOOST_CHECK_EQUAL(0, acc1.GetNonce());
+
+  // Replacing the code materializes a new copy for that account only
+  bytes code2(code.size(), 'd');
+  acc2.SetCode(code2);
+  BOOST_CHECK_EQUAL(true, code == acc1.GetCode());
+  BOOST_CHECK_EQUAL(true, code2 == acc2.GetCode());
+}
+
 BOOST_AUTO_TEST_CASE(testBalance) {
   INIT_STDOUT_LOGGER();
   LOG_MARKER();
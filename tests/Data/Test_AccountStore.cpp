@@ -17,6 +17,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 #define BOOST_TEST_MODULE accountstoretest
 #define BOOST_TEST_DYN_LINK
@@ -26,6 +27,7 @@
 #include "libData/AccountData/Account.h"
 #include "libData/AccountData/AccountStore.h"
 #include "libData/AccountData/Address.h"
+#include "libMessage/Messenger.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/Logger.h"
 
@@ -366,4 +368,204 @@ BOOST_AUTO_TEST_CASE(increaseNonce) {
   BOOST_CHECK_MESSAGE(root1 != root2, "IncreaseNonce didn't change root!");
 }
 
+BOOST_AUTO_TEST_CASE(dryRunLeavesStatesUntouched) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  PairOfKey sender = Schnorr::GetInstance().GenKeyPair();
+  Address senderAddr = Account::GetAddressFromPublicKey(sender.second);
+  PubKey receiverPubKey = Schnorr::GetInstance().GenKeyPair().second;
+  Address receiverAddr = Account::GetAddressFromPublicKey(receiverPubKey);
+
+  AccountStore::GetInstance().AddAccount(senderAddr, {1000000, 0});
+  AccountStore::GetInstance().UpdateStateTrieAll();
+  auto root1 = AccountStore::GetInstance().GetStateRootHash();
+
+  Transaction tx(DataConversion::Pack(CHAIN_ID, 1), 1, receiverAddr, sender,
+                 100, 1, NORMAL_TRAN_GAS);
+  TransactionReceipt receipt;
+  BOOST_CHECK_MESSAGE(
+      AccountStore::GetInstance().UpdateAccountsDryRun(1, 1, false, tx,
+                                                       receipt),
+      "UpdateAccountsDryRun failed for a valid transfer!");
+  BOOST_CHECK_MESSAGE(receipt.GetCumGas() == NORMAL_TRAN_GAS,
+                      "UpdateAccountsDryRun reported wrong gas used!");
+
+  AccountStore::GetInstance().UpdateStateTrieAll();
+  BOOST_CHECK_MESSAGE(
+      AccountStore::GetInstance().GetBalance(senderAddr) == 1000000,
+      "UpdateAccountsDryRun changed the sender balance!");
+  BOOST_CHECK_MESSAGE(!AccountStore::GetInstance().IsAccountExist(receiverAddr),
+                      "UpdateAccountsDryRun created the receiver account!");
+  BOOST_CHECK_MESSAGE(AccountStore::GetInstance().GetStateRootHash() == root1,
+                      "UpdateAccountsDryRun changed the state root!");
+}
+
+BOOST_AUTO_TEST_CASE(deltaIndependentOfInsertionOrder) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  std::vector<Address> addresses;
+  for (unsigned int i = 0; i < 50; i++) {
+    addresses.emplace_back(Account::GetAddressFromPublicKey(
+        Schnorr::GetInstance().GenKeyPair().second));
+  }
+
+  AccountStoreTemp forward(AccountStore::GetInstance());
+  for (unsigned int i = 0; i < addresses.size(); i++) {
+    forward.AddAccount(addresses[i], {i + 1, i});
+  }
+  AccountStoreTemp backward(AccountStore::GetInstance());
+  for (unsigned int i = addresses.size(); i-- > 0;) {
+    backward.AddAccount(addresses[i], {i + 1, i});
+  }
+
+  bytes forwardDelta, backwardDelta;
+  BOOST_CHECK_MESSAGE(
+      Messenger::SetAccountStoreDelta(forwardDelta, 0, forward,
+                                      AccountStore::GetInstance()),
+      "SetAccountStoreDelta failed!");
+  BOOST_CHECK_MESSAGE(
+      Messenger::SetAccountStoreDelta(backwardDelta, 0, backward,
+                                      AccountStore::GetInstance()),
+      "SetAccountStoreDelta failed!");
+  BOOST_CHECK_MESSAGE(forwardDelta == backwardDelta,
+                      "State delta depends on account insertion order!");
+}
+
+BOOST_AUTO_TEST_CASE(compactDeltaRoundTrip) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  using boost::multiprecision::uint128_t;
+
+  AccountStore::GetInstance().Init();
+
+  // Half the accounts exist already, the delta creates the rest
+  const uint128_t large = uint128_t(1) << 100;
+  std::vector<Address> addresses;
+  for (unsigned int i = 0; i < 40; i++) {
+    addresses.emplace_back(Address::random());
+    if (i < 20) {
+      AccountStore::GetInstance().AddAccount(addresses.back(), {large, i});
+    }
+  }
+  AccountStore::GetInstance().UpdateStateTrieAll();
+
+  // Balances go up and down, by small amounts and by more than 64 bits
+  std::vector<Account> expected;
+  AccountStoreTemp changed(AccountStore::GetInstance());
+  for (unsigned int i = 0; i < addresses.size(); i++) {
+    uint128_t balance = i * 1000;
+    if (i < 20) {
+      switch (i % 4) {
+        case 0:
+          balance = large + 1000 + i;
+          break;
+        case 1:
+          balance = large - 7 * i;
+          break;
+        case 2:
+          balance = i;
+          break;
+        default:
+          balance = large * 2;
+      }
+    }
+    expected.emplace_back(balance, (i < 20 ? i : 0) + i % 3);
+    changed.AddAccount(addresses[i], expected.back());
+  }
+
+  bytes compact, legacy;
+  BOOST_REQUIRE(Messenger::SetAccountStoreDelta(
+      compact, 0, changed, AccountStore::GetInstance(), 1));
+  BOOST_REQUIRE(Messenger::SetAccountStoreDelta(
+      legacy, 0, changed, AccountStore::GetInstance(), 0));
+  BOOST_CHECK_LT(compact.size(), legacy.size());
+
+  std::unordered_map<Address, boost::multiprecision::int256_t> compactMap,
+      legacyMap;
+  BOOST_CHECK(Messenger::StateDeltaToAddressMap(compact, 0, compactMap));
+  BOOST_CHECK(Messenger::StateDeltaToAddressMap(legacy, 0, legacyMap));
+  BOOST_CHECK(compactMap == legacyMap);
+  BOOST_CHECK_EQUAL(compactMap.size(), addresses.size());
+
+  for (const bytes& delta : {compact, legacy}) {
+    AccountStoreTemp applied(AccountStore::GetInstance());
+    BOOST_REQUIRE(Messenger::GetAccountStoreDelta(delta, 0, applied));
+    for (unsigned int i = 0; i < addresses.size(); i++) {
+      const Account* account = applied.GetAccount(addresses[i]);
+      BOOST_REQUIRE(account != nullptr);
+      BOOST_CHECK_EQUAL(account->GetBalance(), expected[i].GetBalance());
+      BOOST_CHECK_EQUAL(account->GetNonce(), expected[i].GetNonce());
+    }
+  }
+
+  // A delta cut short must be rejected
+  compact.pop_back();
+  AccountStoreTemp applied(AccountStore::GetInstance());
+  BOOST_CHECK(!Messenger::GetAccountStoreDelta(compact, 0, applied));
+
+  // An empty delta stays empty, its hash stands for no change
+  AccountStoreTemp unchanged(AccountStore::GetInstance());
+  bytes empty;
+  BOOST_CHECK(Messenger::SetAccountStoreDelta(
+      empty, 0, unchanged, AccountStore::GetInstance(), 1));
+  BOOST_CHECK(empty.empty());
+}
+
+/// Delta of an epoch of plain transfers: each sender pays an amount and gas
+/// to a receiver, half the receivers are new accounts
+BOOST_AUTO_TEST_CASE(typicalEpochDeltaSize) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  using boost::multiprecision::uint128_t;
+
+  const unsigned int numTransfers = 1000;
+  const uint128_t initialBalance = uint128_t(1000000) * 1000000000000;
+  const uint128_t amount = uint128_t(25) * 1000000000000;
+  const uint128_t gasFee = uint128_t(1) * 1000000000;
+
+  AccountStore::GetInstance().Init();
+
+  std::vector<Address> senders, receivers;
+  for (unsigned int i = 0; i < numTransfers; i++) {
+    senders.emplace_back(Address::random());
+    receivers.emplace_back(Address::random());
+    AccountStore::GetInstance().AddAccount(senders.back(),
+                                           {initialBalance, i});
+    if (i % 2 == 0) {
+      AccountStore::GetInstance().AddAccount(receivers.back(),
+                                             {initialBalance, 0});
+    }
+  }
+  AccountStore::GetInstance().UpdateStateTrieAll();
+
+  AccountStoreTemp epoch(AccountStore::GetInstance());
+  for (unsigned int i = 0; i < numTransfers; i++) {
+    epoch.AddAccount(senders[i],
+                     {initialBalance - amount - gasFee, uint64_t(i + 1)});
+    epoch.AddAccount(receivers[i],
+                     {(i % 2 == 0 ? initialBalance : 0) + amount, 0});
+  }
+
+  bytes compact, legacy;
+  BOOST_REQUIRE(Messenger::SetAccountStoreDelta(
+      compact, 0, epoch, AccountStore::GetInstance(), 1));
+  BOOST_REQUIRE(Messenger::SetAccountStoreDelta(
+      legacy, 0, epoch, AccountStore::GetInstance(), 0));
+
+  LOG_GENERAL(INFO, "State delta for " << numTransfers << " transfers: legacy "
+                                       << legacy.size() << " bytes, compact "
+                                       << compact.size() << " bytes ("
+                                       << 100 * compact.size() / legacy.size()
+                                       << "%)");
+  BOOST_CHECK_LT(compact.size(), legacy.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -65,4 +65,25 @@ BOOST_AUTO_TEST_CASE(commitAndRollback) {
                       "is probably obsolete.");
 }
 
+BOOST_AUTO_TEST_CASE(logBloom) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  Address contract1, contract2;
+  contract1[0] = 1;
+  contract2[0] = 2;
+
+  LogBloom bloom;
+  BOOST_CHECK_MESSAGE(!LogEntry::BloomMayContain(bloom, contract1, ""),
+                      "Empty bloom should not match any contract.");
+
+  LogEntry::AddToBloom(bloom, contract1, "Transfer");
+  BOOST_CHECK_MESSAGE(LogEntry::BloomMayContain(bloom, contract1, "Transfer"),
+                      "Bloom should match the added event.");
+  BOOST_CHECK_MESSAGE(LogEntry::BloomMayContain(bloom, contract1, ""),
+                      "Bloom should match the contract of the added event.");
+  BOOST_CHECK_MESSAGE(!LogEntry::BloomMayContain(bloom, contract2, ""),
+                      "Bloom should not match an unrelated contract.");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
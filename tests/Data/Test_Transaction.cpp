@@ -196,4 +196,39 @@ BOOST_AUTO_TEST_CASE(testOperators) {
   BOOST_CHECK_MESSAGE(tx1 < tx3, "Less-than operator failed");
 }
 
+BOOST_AUTO_TEST_CASE(testCachedSenderAddr) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  PairOfKey sender = TestUtils::GenerateRandomKeyPair();
+  const Address fromAddr = Account::GetAddressFromPublicKey(sender.second);
+  Transaction tx1(DataConversion::Pack(CHAIN_ID, 1), 5, Address(), sender, 10,
+                  PRECISION_MIN_VALUE, 1);
+  BOOST_CHECK_EQUAL(tx1.GetSenderAddr(), fromAddr);
+  for (unsigned int numShards = 1; numShards < 10; numShards++) {
+    BOOST_CHECK_EQUAL(tx1.GetShardIndex(numShards),
+                      Transaction::GetShardIndex(fromAddr, numShards));
+  }
+
+  // Every way of getting a transaction carries the address along
+  bytes serialized;
+  BOOST_REQUIRE(tx1.Serialize(serialized, 0));
+  Transaction tx2(serialized, 0);
+  BOOST_CHECK_EQUAL(tx2.GetSenderAddr(), fromAddr);
+
+  Transaction tx3(tx2);
+  BOOST_CHECK_EQUAL(tx3.GetSenderAddr(), fromAddr);
+
+  Transaction tx4;
+  BOOST_CHECK_EQUAL(tx4.GetSenderAddr(), Address());
+  tx4 = tx1;
+  BOOST_CHECK_EQUAL(tx4.GetSenderAddr(), fromAddr);
+
+  Transaction tx5(tx1.GetTranID(), tx1.GetCoreInfo(), tx1.GetSignature());
+  BOOST_CHECK_EQUAL(tx5.GetSenderAddr(), fromAddr);
+
+  Transaction tx6(TxnHash(), TransactionCoreInfo(), tx1.GetSignature());
+  BOOST_CHECK_EQUAL(tx6.GetSenderAddr(), Address());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -16,10 +16,14 @@
  */
 
 #include <array>
+#include <chrono>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "libCrypto/Schnorr.h"
 #include "libData/AccountData/Account.h"
+#include "libData/AccountData/AccountStoreBase.h"
 #include "libData/AccountData/Address.h"
 #include "libData/AccountData/Transaction.h"
 #include "libUtils/Logger.h"
@@ -224,4 +228,129 @@ BOOST_AUTO_TEST_CASE(GenTxn1000) {
                 << " ms");
 }
 
+/// The sender lookups microblock composition makes per transaction: the
+/// nonce check and pending-nonce map in ProcessTransactionWhenShardLeader,
+/// the shard check and UpdateAccounts in the validator. Computing the address
+/// from the public key each time, as before, against the cached address.
+BOOST_AUTO_TEST_CASE(SenderAddrInComposition) {
+  INIT_STDOUT_LOGGER();
+  const unsigned int n = 10000;
+  const unsigned int numSenders = 100;
+  const unsigned int numShards = 5;
+
+  vector<PairOfKey> senders;
+  for (unsigned int i = 0; i < numSenders; i++) {
+    senders.emplace_back(Schnorr::GetInstance().GenKeyPair());
+  }
+  vector<Transaction> txns;
+  for (unsigned int i = 0; i < n; i++) {
+    txns.emplace_back(DataConversion::Pack(CHAIN_ID, 1), i / numSenders,
+                      Address(), senders[i % numSenders], 1,
+                      PRECISION_MIN_VALUE, 1);
+  }
+
+  auto compose = [&](auto senderAddr) {
+    unordered_map<Address, map<uint64_t, unsigned int>> addrNonceTxnMap;
+    unsigned int inShard = 0;
+    for (unsigned int i = 0; i < txns.size(); i++) {
+      const Transaction& t = txns[i];
+      addrNonceTxnMap[senderAddr(t)].emplace(t.GetNonce(), i);
+      if (Transaction::GetShardIndex(senderAddr(t), numShards) == 0) {
+        inShard++;
+      }
+      BOOST_CHECK(senderAddr(t) != Address());
+    }
+    BOOST_CHECK_EQUAL(addrNonceTxnMap.size(), numSenders);
+    return inShard;
+  };
+
+  auto t_start = chrono::steady_clock::now();
+  const unsigned int recomputed = compose([](const Transaction& t) {
+    return Account::GetAddressFromPublicKey(t.GetSenderPubKey());
+  });
+  const double recomputedMs = chrono::duration<double, milli>(
+                                  chrono::steady_clock::now() - t_start)
+                                  .count();
+
+  t_start = chrono::steady_clock::now();
+  const unsigned int cached = compose(
+      [](const Transaction& t) -> const Address& { return t.GetSenderAddr(); });
+  const double cachedMs = chrono::duration<double, milli>(
+                              chrono::steady_clock::now() - t_start)
+                              .count();
+
+  BOOST_CHECK_EQUAL(recomputed, cached);
+  LOG_GENERAL(INFO, n << " txns: sender recomputed " << recomputedMs
+                      << " ms, cached " << cachedMs << " ms");
+}
+
+/// AccountStoreBase with the transfer path exposed, over either container
+template <class MAP>
+class TransferStore : public AccountStoreBase<MAP> {
+ public:
+  using AccountStoreBase<MAP>::UpdateAccounts;
+};
+
+/// Applies a microblock worth of transfers and returns the elapsed ms
+template <class MAP>
+double ApplyTransfers(const vector<Transaction>& txns,
+                      const vector<Address>& senders) {
+  TransferStore<MAP> store;
+  store.Init();
+  for (const auto& sender : senders) {
+    store.AddAccount(sender, {uint128_t(1) << 100, 0});
+  }
+
+  const auto t_start = chrono::steady_clock::now();
+  for (const auto& txn : txns) {
+    TransactionReceipt receipt;
+    BOOST_CHECK(store.UpdateAccounts(txn, receipt));
+  }
+  const double ms = chrono::duration<double, milli>(
+                        chrono::steady_clock::now() - t_start)
+                        .count();
+
+  BOOST_CHECK_EQUAL(store.GetNumOfAccounts(), senders.size() + txns.size());
+  return ms;
+}
+
+/// The container AccountStoreTemp used before (std::map) against the one it
+/// uses now, on 10k transfers to fresh recipients from 1000 senders
+BOOST_AUTO_TEST_CASE(AccountStoreTempContainer) {
+  INIT_STDOUT_LOGGER();
+  const unsigned int n = 10000;
+  const unsigned int numSenders = 1000;
+
+  vector<PairOfKey> keys;
+  vector<Address> senders;
+  for (unsigned int i = 0; i < numSenders; i++) {
+    keys.emplace_back(Schnorr::GetInstance().GenKeyPair());
+    senders.emplace_back(Account::GetAddressFromPublicKey(keys.back().second));
+  }
+
+  // Unsigned: UpdateAccounts does not check signatures
+  vector<Transaction> txns;
+  for (unsigned int i = 0; i < n; i++) {
+    Address toAddr;
+    for (unsigned int j = 0; j < 4; j++) {
+      toAddr.asArray().at(j) = static_cast<unsigned char>(i >> (8 * j));
+    }
+    toAddr.asArray().at(ACC_ADDR_SIZE - 1) = 0xFF;
+    txns.emplace_back(
+        TxnHash(),
+        TransactionCoreInfo(DataConversion::Pack(CHAIN_ID, 1),
+                            i / numSenders + 1, toAddr,
+                            keys[i % numSenders].second, 1,
+                            PRECISION_MIN_VALUE, NORMAL_TRAN_GAS, {}, {}),
+        Signature());
+  }
+
+  const double mapMs = ApplyTransfers<map<Address, Account>>(txns, senders);
+  const double hashMapMs =
+      ApplyTransfers<unordered_map<Address, Account>>(txns, senders);
+
+  LOG_GENERAL(INFO, n << " transfers: std::map " << mapMs
+                      << " ms, std::unordered_map " << hashMapMs << " ms");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
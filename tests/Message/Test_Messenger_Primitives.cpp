@@ -245,6 +245,64 @@ BOOST_AUTO_TEST_CASE(test_SetAndGetFallbackBlock) {
   BOOST_CHECK(fallbackBlock == fallbackBlockDeserialized);
 }
 
+BOOST_AUTO_TEST_CASE(test_GetNodeFinalBlockHeader) {
+  bytes dst;
+  unsigned int offset = 3;
+
+  vector<MicroBlockInfo> mbInfos;
+  for (unsigned int i = 0, count = TestUtils::Dist1to99(); i < count; i++) {
+    mbInfos.emplace_back(MicroBlockInfo{BlockHash(), TxnHash(), i});
+  }
+  TxBlock txBlock(TestUtils::GenerateRandomTxBlockHeader(), mbInfos,
+                  TestUtils::GenerateRandomCoSignatures());
+  bytes stateDelta(TestUtils::DistUint16(), 0xAB);
+
+  BOOST_CHECK(Messenger::SetNodeFinalBlock(dst, offset, 7, 9, txBlock,
+                                           stateDelta));
+
+  uint64_t dsBlockNumber = 0;
+  uint32_t consensusID = 0;
+  TxBlock headerOnly;
+  BOOST_CHECK(Messenger::GetNodeFinalBlockHeader(dst, offset, dsBlockNumber,
+                                                 consensusID, headerOnly));
+  BOOST_CHECK_EQUAL(dsBlockNumber, 7);
+  BOOST_CHECK_EQUAL(consensusID, 9);
+  BOOST_CHECK(headerOnly.GetHeader() == txBlock.GetHeader());
+  BOOST_CHECK(headerOnly.GetBlockHash() == txBlock.GetBlockHash());
+  BOOST_CHECK(headerOnly.GetCS2() == txBlock.GetCS2());
+  BOOST_CHECK(headerOnly.GetB2() == txBlock.GetB2());
+  BOOST_CHECK(headerOnly.GetMicroBlockInfos().empty());
+
+  // A message cut short must not pass
+  dst.resize(dst.size() - 1);
+  BOOST_CHECK(!Messenger::GetNodeFinalBlockHeader(dst, offset, dsBlockNumber,
+                                                  consensusID, headerOnly));
+}
+
+BOOST_AUTO_TEST_CASE(test_GetNodeVCDSBlocksMessageHeader) {
+  bytes dst;
+  unsigned int offset = 3;
+
+  DSBlock dsBlock(TestUtils::GenerateRandomDSBlockHeader(),
+                  TestUtils::GenerateRandomCoSignatures());
+
+  BOOST_CHECK(Messenger::SetNodeVCDSBlocksMessage(
+      dst, offset, 5, dsBlock, {}, TestUtils::GenerateDequeueOfShard(3)));
+
+  uint32_t shardId = 0;
+  DSBlock headerOnly;
+  BOOST_CHECK(Messenger::GetNodeVCDSBlocksMessageHeader(dst, offset, shardId,
+                                                        headerOnly));
+  BOOST_CHECK_EQUAL(shardId, 5);
+  BOOST_CHECK(headerOnly == dsBlock);
+  BOOST_CHECK(headerOnly.GetBlockHash() == dsBlock.GetBlockHash());
+  BOOST_CHECK(headerOnly.GetCS2() == dsBlock.GetCS2());
+
+  dst.resize(dst.size() - 1);
+  BOOST_CHECK(!Messenger::GetNodeVCDSBlocksMessageHeader(dst, offset, shardId,
+                                                         headerOnly));
+}
+
 BOOST_AUTO_TEST_CASE(test_CopyWithSizeCheck) {
   bytes arr;
   dev::h256 result;
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "libMessage/Messenger.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/DataConversion.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE messenger_throughput
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+static const unsigned int ITERATIONS = 20;
+static const unsigned int NUM_TXNS = 1000;
+static const unsigned int NUM_BLOCKS = 50;
+static const unsigned int NUM_MICROBLOCKS = 20;
+static const unsigned int NUM_MB_INFOS = 100;
+static const unsigned int STATE_DELTA_SIZE = 256 * 1024;
+
+static vector<Transaction> g_txns;
+static vector<TransactionWithReceipt> g_txnsWithReceipt;
+static vector<MicroBlock> g_microBlocks;
+static vector<TxBlock> g_txBlocks;
+static vector<DSBlock> g_dsBlocks;
+static PairOfKey g_lookupKey;
+
+static MicroBlock RandomMicroBlock() {
+  MicroBlockHeader header = TestUtils::GenerateRandomMicroBlockHeader();
+  vector<TxnHash> tranHashes(header.GetNumTxs());
+  return MicroBlock(header, tranHashes,
+                    TestUtils::GenerateRandomCoSignatures());
+}
+
+static TxBlock RandomTxBlock() {
+  vector<MicroBlockInfo> mbInfos;
+  for (unsigned int i = 0; i < NUM_MB_INFOS; i++) {
+    mbInfos.emplace_back(MicroBlockInfo{BlockHash(), TxnHash(), i});
+  }
+  return TxBlock(TestUtils::GenerateRandomTxBlockHeader(), mbInfos,
+                 TestUtils::GenerateRandomCoSignatures());
+}
+
+/// Encodes and decodes a message ITERATIONS times each and logs the rates
+static void Benchmark(const string& name, function<bool(bytes&)> encode,
+                      function<bool(const bytes&)> decode) {
+  bytes message;
+  BOOST_REQUIRE_MESSAGE(encode(message), name << " encoding failed");
+
+  auto start = chrono::steady_clock::now();
+  for (unsigned int i = 0; i < ITERATIONS; i++) {
+    bytes dst;
+    encode(dst);
+  }
+  const double encodeSeconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  start = chrono::steady_clock::now();
+  for (unsigned int i = 0; i < ITERATIONS; i++) {
+    BOOST_CHECK_MESSAGE(decode(message), name << " decoding failed");
+  }
+  const double decodeSeconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  const double megabytes = ITERATIONS * message.size() / (1024.0 * 1024.0);
+  LOG_GENERAL(INFO, name << " (" << message.size() << " bytes) encode "
+                         << ITERATIONS / encodeSeconds << " msg/s "
+                         << megabytes / encodeSeconds << " MB/s, decode "
+                         << ITERATIONS / decodeSeconds << " msg/s "
+                         << megabytes / decodeSeconds << " MB/s");
+}
+
+BOOST_AUTO_TEST_SUITE(messenger_throughput)
+
+BOOST_AUTO_TEST_CASE(init) {
+  INIT_STDOUT_LOGGER();
+  TestUtils::Initialize();
+
+  g_lookupKey = TestUtils::GenerateRandomKeyPair();
+  const PairOfKey sender = TestUtils::GenerateRandomKeyPair();
+  for (unsigned int i = 0; i < NUM_TXNS; i++) {
+    g_txns.emplace_back(DataConversion::Pack(CHAIN_ID, 1), i, Address(),
+                        sender, i, 1, 1);
+    g_txnsWithReceipt.emplace_back(g_txns.back(), TransactionReceipt());
+  }
+  for (unsigned int i = 0; i < NUM_MICROBLOCKS; i++) {
+    g_microBlocks.emplace_back(RandomMicroBlock());
+  }
+  for (unsigned int i = 0; i < NUM_BLOCKS; i++) {
+    g_txBlocks.emplace_back(RandomTxBlock());
+    g_dsBlocks.emplace_back(TestUtils::GenerateRandomDSBlockHeader(),
+                            TestUtils::GenerateRandomCoSignatures());
+  }
+}
+
+/// The message types that carry the most data
+BOOST_AUTO_TEST_CASE(test_encode_decode_throughput) {
+  INIT_STDOUT_LOGGER();
+
+  const bytes stateDelta(STATE_DELTA_SIZE, 0xAB);
+  Benchmark(
+      "NodeFinalBlock",
+      [&](bytes& dst) {
+        return Messenger::SetNodeFinalBlock(dst, 0, 1, 1, g_txBlocks.front(),
+                                            stateDelta);
+      },
+      [](const bytes& src) {
+        uint64_t dsBlockNumber;
+        uint32_t consensusID;
+        TxBlock txBlock;
+        bytes delta;
+        return Messenger::GetNodeFinalBlock(src, 0, dsBlockNumber, consensusID,
+                                            txBlock, delta);
+      });
+
+  // What a node decodes before deciding whether the block is worth the rest
+  Benchmark(
+      "NodeFinalBlock header",
+      [&](bytes& dst) {
+        return Messenger::SetNodeFinalBlock(dst, 0, 1, 1, g_txBlocks.front(),
+                                            stateDelta);
+      },
+      [](const bytes& src) {
+        uint64_t dsBlockNumber;
+        uint32_t consensusID;
+        TxBlock txBlock;
+        return Messenger::GetNodeFinalBlockHeader(src, 0, dsBlockNumber,
+                                                  consensusID, txBlock);
+      });
+
+  const vector<bytes> stateDeltas(NUM_MICROBLOCKS,
+                                  bytes(STATE_DELTA_SIZE / 16, 0xCD));
+  Benchmark(
+      "DSMicroBlockSubmission",
+      [&](bytes& dst) {
+        return Messenger::SetDSMicroBlockSubmission(dst, 0, 0, 1,
+                                                    g_microBlocks, stateDeltas);
+      },
+      [](const bytes& src) {
+        unsigned char type;
+        uint64_t epochNumber;
+        vector<MicroBlock> microBlocks;
+        vector<bytes> deltas;
+        return Messenger::GetDSMicroBlockSubmission(src, 0, type, epochNumber,
+                                                    microBlocks, deltas);
+      });
+
+  Benchmark(
+      "NodeForwardTxnBlock",
+      [](bytes& dst) {
+        return Messenger::SetNodeForwardTxnBlock(dst, 0, 1, 1, 0, g_lookupKey,
+                                                 g_txns, {});
+      },
+      [](const bytes& src) {
+        uint64_t epochNumber, dsBlockNum;
+        uint32_t shardId;
+        PubKey lookupPubKey;
+        vector<Transaction> txns;
+        return Messenger::GetNodeForwardTxnBlock(src, 0, epochNumber,
+                                                 dsBlockNum, shardId,
+                                                 lookupPubKey, txns);
+      });
+
+  Benchmark(
+      "TransactionArray",
+      [](bytes& dst) { return Messenger::SetTransactionArray(dst, 0, g_txns); },
+      [](const bytes& src) {
+        vector<Transaction> txns;
+        return Messenger::GetTransactionArray(src, 0, txns);
+      });
+
+  Benchmark(
+      "LookupSetTxnsFromLookup",
+      [](bytes& dst) {
+        return Messenger::SetLookupSetTxnsFromLookup(dst, 0, g_lookupKey,
+                                                     g_txnsWithReceipt);
+      },
+      [](const bytes& src) {
+        PubKey lookupPubKey;
+        vector<TransactionWithReceipt> txns;
+        return Messenger::GetLookupSetTxnsFromLookup(src, 0, lookupPubKey,
+                                                     txns);
+      });
+
+  Benchmark(
+      "NodeMBnForwardTransaction",
+      [](bytes& dst) {
+        return Messenger::SetNodeMBnForwardTransaction(
+            dst, 0, g_microBlocks.front(), g_txnsWithReceipt);
+      },
+      [](const bytes& src) {
+        MBnForwardedTxnEntry entry;
+        return Messenger::GetNodeMBnForwardTransaction(src, 0, entry);
+      });
+
+  Benchmark(
+      "LookupSetMicroBlockFromLookup",
+      [](bytes& dst) {
+        return Messenger::SetLookupSetMicroBlockFromLookup(
+            dst, 0, g_lookupKey, g_microBlocks);
+      },
+      [](const bytes& src) {
+        PubKey lookupPubKey;
+        vector<MicroBlock> mbs;
+        return Messenger::GetLookupSetMicroBlockFromLookup(src, 0,
+                                                           lookupPubKey, mbs);
+      });
+
+  Benchmark(
+      "LookupSetTxBlockFromSeed",
+      [](bytes& dst) {
+        return Messenger::SetLookupSetTxBlockFromSeed(
+            dst, 0, 1, NUM_BLOCKS, g_lookupKey, g_txBlocks);
+      },
+      [](const bytes& src) {
+        uint64_t low, high;
+        PubKey lookupPubKey;
+        vector<TxBlock> txBlocks;
+        return Messenger::GetLookupSetTxBlockFromSeed(src, 0, low, high,
+                                                      lookupPubKey, txBlocks);
+      });
+
+  Benchmark(
+      "LookupSetDSBlockFromSeed",
+      [](bytes& dst) {
+        return Messenger::SetLookupSetDSBlockFromSeed(
+            dst, 0, 1, NUM_BLOCKS, g_lookupKey, g_dsBlocks);
+      },
+      [](const bytes& src) {
+        uint64_t low, high;
+        PubKey lookupPubKey;
+        vector<DSBlock> dsBlocks;
+        return Messenger::GetLookupSetDSBlockFromSeed(src, 0, low, high,
+                                                      lookupPubKey, dsBlocks);
+      });
+
+  const DequeOfShard shards = TestUtils::GenerateDequeueOfShard(20);
+  Benchmark(
+      "LookupSetShardsFromSeed",
+      [&](bytes& dst) {
+        return Messenger::SetLookupSetShardsFromSeed(dst, 0, g_lookupKey,
+                                                     shards);
+      },
+      [](const bytes& src) {
+        PubKey lookupPubKey;
+        DequeOfShard decoded;
+        return Messenger::GetLookupSetShardsFromSeed(src, 0, lookupPubKey,
+                                                     decoded);
+      });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include "libNetwork/BroadcastDedupSet.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE broadcastdedupset
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+using Digest = array<unsigned char, BroadcastDedupSet::DIGEST_SIZE>;
+
+static Digest MakeDigest(uint64_t seed) {
+  // Spread the seed over the leading bytes, which select the bucket
+  Digest digest{};
+  uint64_t mixed = seed * 0x9E3779B97F4A7C15ULL;
+  memcpy(digest.data(), &mixed, sizeof(mixed));
+  memcpy(digest.data() + sizeof(mixed), &seed, sizeof(seed));
+  return digest;
+}
+
+BOOST_AUTO_TEST_SUITE(broadcastdedupset)
+
+BOOST_AUTO_TEST_CASE(test_insert_and_contains) {
+  INIT_STDOUT_LOGGER();
+
+  BroadcastDedupSet dedup(1024, chrono::seconds(600), chrono::seconds(60));
+  const auto now = BroadcastDedupSet::Clock::now();
+
+  for (uint64_t i = 0; i < 500; i++) {
+    BOOST_CHECK(dedup.Insert(MakeDigest(i).data(), now));
+  }
+  for (uint64_t i = 0; i < 500; i++) {
+    BOOST_CHECK(dedup.Contains(MakeDigest(i).data(), now));
+    BOOST_CHECK_MESSAGE(!dedup.Insert(MakeDigest(i).data(), now),
+                        "Duplicate digest should be rejected");
+  }
+  BOOST_CHECK(!dedup.Contains(MakeDigest(1000).data(), now));
+}
+
+BOOST_AUTO_TEST_CASE(test_expiry) {
+  INIT_STDOUT_LOGGER();
+
+  BroadcastDedupSet dedup(1024, chrono::seconds(600), chrono::seconds(60));
+  const auto now = BroadcastDedupSet::Clock::now();
+  const Digest digest = MakeDigest(42);
+
+  BOOST_CHECK(dedup.Insert(digest.data(), now));
+  BOOST_CHECK(dedup.Contains(digest.data(), now + chrono::seconds(500)));
+  BOOST_CHECK(!dedup.Contains(digest.data(), now + chrono::seconds(700)));
+  BOOST_CHECK(dedup.Insert(digest.data(), now + chrono::seconds(700)));
+}
+
+BOOST_AUTO_TEST_CASE(test_bounded_memory) {
+  INIT_STDOUT_LOGGER();
+
+  // Overfilling evicts the oldest entries instead of growing
+  BroadcastDedupSet dedup(1024, chrono::seconds(600), chrono::seconds(60));
+  const auto now = BroadcastDedupSet::Clock::now();
+
+  for (uint64_t i = 0; i < 100000; i++) {
+    dedup.Insert(MakeDigest(i).data(), now);
+  }
+  BOOST_CHECK_GT(dedup.GetEvictions(), 0);
+
+  unsigned int recent = 0;
+  for (uint64_t i = 100000 - 256; i < 100000; i++) {
+    recent += dedup.Contains(MakeDigest(i).data(), now) ? 1 : 0;
+  }
+  LOG_GENERAL(INFO, "Recent entries kept: " << recent << "/256");
+  BOOST_CHECK_GT(recent, 200);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <random>
+
+#include "libNetwork/ChunkedTransfer.h"
+#include "libNetwork/P2PComm.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE chunkedtransfer
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+// Chunking is off by default, the tests pass their own sizes
+static const uint32_t THRESHOLD = 8 * 1024 * 1024;
+static const uint32_t CHUNK_SIZE = 1024 * 1024;
+
+static MessageFrame MakeLargeFrame(unsigned char seed) {
+  auto frame = make_shared<bytes>(THRESHOLD + CHUNK_SIZE / 2);
+  for (size_t i = 0; i < frame->size(); i++) {
+    frame->at(i) = static_cast<unsigned char>(i * 31 + seed);
+  }
+  return frame;
+}
+
+static bool AddChunk(const MessageFrame& chunk, const Peer& from,
+                     bytes& frame) {
+  BOOST_REQUIRE_EQUAL(chunk->at(1), START_BYTE_CHUNK);
+  return ChunkedTransfer::GetInstance().AddChunk(
+      chunk->data() + HDR_LEN, chunk->size() - HDR_LEN, from, frame);
+}
+
+BOOST_AUTO_TEST_SUITE(chunkedtransfer)
+
+BOOST_AUTO_TEST_CASE(test_small_frame_not_split) {
+  INIT_STDOUT_LOGGER();
+
+  auto frame = make_shared<const bytes>(1024, 0x11);
+  const auto chunks = ChunkedTransfer::Split(frame, THRESHOLD, CHUNK_SIZE);
+  BOOST_REQUIRE_EQUAL(chunks.size(), 1);
+  BOOST_CHECK(chunks.front() == frame);
+}
+
+BOOST_AUTO_TEST_CASE(test_disabled_by_zero_threshold) {
+  INIT_STDOUT_LOGGER();
+
+  const MessageFrame frame = MakeLargeFrame(3);
+  const auto chunks = ChunkedTransfer::Split(frame, 0, CHUNK_SIZE);
+  BOOST_REQUIRE_EQUAL(chunks.size(), 1);
+  BOOST_CHECK(chunks.front() == frame);
+}
+
+BOOST_AUTO_TEST_CASE(test_out_of_order_reassembly) {
+  INIT_STDOUT_LOGGER();
+
+  const MessageFrame frame = MakeLargeFrame(1);
+  auto chunks = ChunkedTransfer::Split(frame, THRESHOLD, CHUNK_SIZE);
+  BOOST_REQUIRE_EQUAL(chunks.size(), THRESHOLD / CHUNK_SIZE + 1);
+
+  mt19937 rng(7);
+  shuffle(chunks.begin(), chunks.end(), rng);
+
+  const Peer from(0x0100007F, 30303);
+  bytes result;
+  for (size_t i = 0; i + 1 < chunks.size(); i++) {
+    BOOST_CHECK(!AddChunk(chunks[i], from, result));
+  }
+
+  // A chunk resent after a reconnect is ignored
+  BOOST_CHECK(!AddChunk(chunks.front(), from, result));
+
+  BOOST_CHECK(AddChunk(chunks.back(), from, result));
+  BOOST_CHECK(result == *frame);
+
+  // Late duplicates of a completed transfer do not start a new one
+  result.clear();
+  BOOST_CHECK(!AddChunk(chunks.front(), from, result));
+  BOOST_CHECK(result.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_corrupt_chunk_rejected) {
+  INIT_STDOUT_LOGGER();
+
+  const MessageFrame frame = MakeLargeFrame(2);
+  const auto chunks = ChunkedTransfer::Split(frame, THRESHOLD, CHUNK_SIZE);
+  const Peer from(0x0100007F, 30304);
+
+  auto corrupt = make_shared<bytes>(*chunks.front());
+  corrupt->back() ^= 0xFF;
+
+  bytes result;
+  BOOST_CHECK(!AddChunk(corrupt, from, result));
+  for (size_t i = 1; i < chunks.size(); i++) {
+    BOOST_CHECK(!AddChunk(chunks[i], from, result));
+  }
+
+  // The transfer only completes once the intact chunk arrives
+  BOOST_CHECK(AddChunk(chunks.front(), from, result));
+  BOOST_CHECK(result == *frame);
+}
+
+BOOST_AUTO_TEST_CASE(test_pending_transfers_limited_per_peer) {
+  INIT_STDOUT_LOGGER();
+
+  const Peer attacker(0x0200007F, 30305);
+  const Peer honest(0x0300007F, 30306);
+
+  const MessageFrame frame = MakeLargeFrame(4);
+  const auto chunks = ChunkedTransfer::Split(frame, THRESHOLD, CHUNK_SIZE);
+
+  bytes result;
+  BOOST_CHECK(!AddChunk(chunks.front(), honest, result));
+
+  // Many transfers started by one peer only evict that peer's own
+  for (unsigned char seed = 10; seed < 20; seed++) {
+    const auto other = ChunkedTransfer::Split(MakeLargeFrame(seed), THRESHOLD,
+                                              CHUNK_SIZE);
+    BOOST_CHECK(!AddChunk(other.front(), attacker, result));
+  }
+
+  for (size_t i = 1; i + 1 < chunks.size(); i++) {
+    BOOST_CHECK(!AddChunk(chunks[i], honest, result));
+  }
+  BOOST_CHECK(AddChunk(chunks.back(), honest, result));
+  BOOST_CHECK(result == *frame);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
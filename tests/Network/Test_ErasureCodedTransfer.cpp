@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <random>
+
+#include "libNetwork/ErasureCodedTransfer.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE erasurecodedtransfer
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+static bytes MakeMessage(size_t size, unsigned char seed) {
+  bytes message(size);
+  for (size_t i = 0; i < message.size(); i++) {
+    message[i] = static_cast<unsigned char>(i * 7 + seed);
+  }
+  return message;
+}
+
+BOOST_AUTO_TEST_SUITE(erasurecodedtransfer)
+
+BOOST_AUTO_TEST_CASE(test_two_thirds_rebuild) {
+  INIT_STDOUT_LOGGER();
+
+  const bytes message = MakeMessage(100000, 1);
+  vector<bytes> chunks;
+  BOOST_REQUIRE(ErasureCodedTransfer::Encode(message, 30, chunks));
+  BOOST_REQUIRE_EQUAL(chunks.size(), 30);
+
+  mt19937 rng(5);
+  shuffle(chunks.begin(), chunks.end(), rng);
+
+  const Peer from(0x0100007F, 30303);
+  ErasureCodedTransfer& transfer = ErasureCodedTransfer::GetInstance();
+  bytes result;
+  bool relay = false;
+  for (unsigned int i = 0; i < 19; i++) {
+    BOOST_CHECK(!transfer.AddChunk(chunks[i].data(), chunks[i].size(), from,
+                                   relay, result));
+    BOOST_CHECK(relay);
+  }
+
+  // A second copy of a chunk is neither counted nor forwarded again
+  BOOST_CHECK(!transfer.AddChunk(chunks[0].data(), chunks[0].size(), from,
+                                 relay, result));
+  BOOST_CHECK(!relay);
+
+  // Forwarded copies are not forwarded again
+  bytes forwarded = chunks[19];
+  forwarded[ErasureCodedTransfer::RELAY_FLAG_OFFSET] = 0;
+  BOOST_CHECK(transfer.AddChunk(forwarded.data(), forwarded.size(), from,
+                                relay, result));
+  BOOST_CHECK(!relay);
+  BOOST_CHECK(result == message);
+
+  // Late chunks of a completed message are ignored
+  result.clear();
+  BOOST_CHECK(!transfer.AddChunk(chunks[25].data(), chunks[25].size(), from,
+                                 relay, result));
+  BOOST_CHECK(result.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_corrupt_chunk_rejected) {
+  INIT_STDOUT_LOGGER();
+
+  const bytes message = MakeMessage(5000, 2);
+  vector<bytes> chunks;
+  BOOST_REQUIRE(ErasureCodedTransfer::Encode(message, 6, chunks));
+  BOOST_REQUIRE_EQUAL(chunks.size(), 6);
+
+  chunks[1].back() ^= 0xFF;
+
+  const Peer from(0x0100007F, 30304);
+  bytes result;
+  bool relay = false;
+  for (unsigned int i = 0; i < 3; i++) {
+    BOOST_CHECK(!ErasureCodedTransfer::GetInstance().AddChunk(
+        chunks[i].data(), chunks[i].size(), from, relay, result));
+  }
+  BOOST_CHECK(!ErasureCodedTransfer::GetInstance().AddChunk(
+      chunks[3].data(), chunks[3].size(), from, relay, result));
+  BOOST_CHECK(result.empty());
+
+  // The corrupt chunk was never kept, so the next intact one completes it
+  BOOST_CHECK(ErasureCodedTransfer::GetInstance().AddChunk(
+      chunks[4].data(), chunks[4].size(), from, relay, result));
+  BOOST_CHECK(result == message);
+}
+
+BOOST_AUTO_TEST_CASE(test_forged_parameters_rejected) {
+  INIT_STDOUT_LOGGER();
+
+  const bytes message = MakeMessage(5000, 3);
+  vector<bytes> chunks;
+  BOOST_REQUIRE(ErasureCodedTransfer::Encode(message, 6, chunks));
+
+  const Peer from(0x0100007F, 30305);
+  ErasureCodedTransfer& transfer = ErasureCodedTransfer::GetInstance();
+  bytes result;
+  bool relay = false;
+
+  // A first chunk claiming other parameters under the honest root must not
+  // fix them for the transfer
+  bytes forged = chunks[0];
+  forged[ErasureCodedTransfer::DIGEST_LEN + 2]++;
+  BOOST_CHECK(
+      !transfer.AddChunk(forged.data(), forged.size(), from, relay, result));
+  BOOST_CHECK(!relay);
+
+  for (unsigned int i = 0; i < 3; i++) {
+    BOOST_CHECK(!transfer.AddChunk(chunks[i].data(), chunks[i].size(), from,
+                                   relay, result));
+  }
+  BOOST_CHECK(transfer.AddChunk(chunks[3].data(), chunks[3].size(), from,
+                                relay, result));
+  BOOST_CHECK(result == message);
+}
+
+BOOST_AUTO_TEST_CASE(test_pending_transfers_limited_per_peer) {
+  INIT_STDOUT_LOGGER();
+
+  const bytes message = MakeMessage(5000, 4);
+  vector<bytes> chunks;
+  BOOST_REQUIRE(ErasureCodedTransfer::Encode(message, 6, chunks));
+
+  const Peer honest(0x0200007F, 30306);
+  const Peer attacker(0x0300007F, 30307);
+  ErasureCodedTransfer& transfer = ErasureCodedTransfer::GetInstance();
+  bytes result;
+  bool relay = false;
+
+  BOOST_CHECK(!transfer.AddChunk(chunks[0].data(), chunks[0].size(), honest,
+                                 relay, result));
+
+  // Self-consistent chunks of many other messages only evict the
+  // attacker's own transfers
+  for (unsigned char seed = 10; seed < 30; seed++) {
+    vector<bytes> other;
+    BOOST_REQUIRE(ErasureCodedTransfer::Encode(MakeMessage(5000, seed), 6,
+                                               other));
+    BOOST_CHECK(!transfer.AddChunk(other[0].data(), other[0].size(),
+                                   attacker, relay, result));
+  }
+
+  for (unsigned int i = 1; i < 3; i++) {
+    BOOST_CHECK(!transfer.AddChunk(chunks[i].data(), chunks[i].size(),
+                                   honest, relay, result));
+  }
+  BOOST_CHECK(transfer.AddChunk(chunks[3].data(), chunks[3].size(), honest,
+                                relay, result));
+  BOOST_CHECK(result == message);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "libNetwork/Blacklist.h"
+#include "libNetwork/IPTable.h"
+#include "libNetwork/ReputationManager.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE iptable
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using boost::multiprecision::uint128_t;
+
+static const unsigned int NUM_KNOWN_IPS = 1000;
+static const unsigned int NUM_READER_THREADS = 4;
+static const unsigned int CHECKS_PER_THREAD = 500000;
+
+/// IPv4 addresses as P2PComm stores them, plus a few with the high word set
+static uint128_t TestIP(unsigned int i) {
+  uint128_t ip = 0x0A000000 + i * 7919;
+  if (i % 10 == 0) {
+    ip |= uint128_t(i) << 64;
+  }
+  return ip;
+}
+
+/// The tables this replaced: decimal string hash behind a mutex
+struct StringHashedTable {
+  struct Hash {
+    size_t operator()(const uint128_t& ip) const {
+      return hash<string>()(ip.convert_to<string>());
+    }
+  };
+
+  mutex m_mutex;
+  unordered_map<uint128_t, int32_t, Hash> m_table;
+
+  bool Find(const uint128_t& ip, int32_t& value) {
+    lock_guard<mutex> g(m_mutex);
+    auto it = m_table.find(ip);
+    if (it == m_table.end()) {
+      return false;
+    }
+    value = it->second;
+    return true;
+  }
+};
+
+/// Runs check on NUM_READER_THREADS threads and returns checks per second
+template <class Check>
+static double ChecksPerSecond(Check check) {
+  atomic<unsigned int> hits{0};
+  const auto start = chrono::steady_clock::now();
+
+  vector<thread> readers;
+  for (unsigned int t = 0; t < NUM_READER_THREADS; t++) {
+    readers.emplace_back([&, t] {
+      unsigned int h = 0;
+      for (unsigned int i = 0; i < CHECKS_PER_THREAD; i++) {
+        h += check(TestIP((i + t) % (2 * NUM_KNOWN_IPS)));
+      }
+      hits += h;
+    });
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  const double seconds = chrono::duration_cast<chrono::duration<double>>(
+                             chrono::steady_clock::now() - start)
+                             .count();
+  BOOST_CHECK_GT(hits.load(), 0);
+  return NUM_READER_THREADS * CHECKS_PER_THREAD / max(seconds, 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE(iptable)
+
+BOOST_AUTO_TEST_CASE(test_insert_find_erase) {
+  INIT_STDOUT_LOGGER();
+
+  IPTable<int32_t> table;
+  int32_t value = 0;
+  BOOST_CHECK(!table.Find(0, value));
+
+  // Enough to grow the table several times
+  for (unsigned int i = 0; i < NUM_KNOWN_IPS; i++) {
+    BOOST_CHECK(table.Insert(TestIP(i), i));
+  }
+  BOOST_CHECK(!table.Insert(TestIP(5), -1));
+  BOOST_CHECK_EQUAL(table.Size(), NUM_KNOWN_IPS);
+
+  for (unsigned int i = 0; i < 2 * NUM_KNOWN_IPS; i++) {
+    const bool found = table.Find(TestIP(i), value);
+    BOOST_CHECK_EQUAL(found, i < NUM_KNOWN_IPS);
+    if (found) {
+      BOOST_CHECK_EQUAL(value, i);
+    }
+  }
+
+  table.Set(TestIP(5), -50);
+  BOOST_CHECK(table.Find(TestIP(5), value));
+  BOOST_CHECK_EQUAL(value, -50);
+
+  // Erasing must not hide anything further along a probe run
+  for (unsigned int i = 0; i < NUM_KNOWN_IPS; i += 2) {
+    BOOST_CHECK(table.Erase(TestIP(i)));
+  }
+  BOOST_CHECK(!table.Erase(TestIP(0)));
+  for (unsigned int i = 0; i < NUM_KNOWN_IPS; i++) {
+    BOOST_CHECK_EQUAL(table.Contains(TestIP(i)), i % 2 == 1);
+  }
+
+  vector<uint128_t> keys = table.Keys();
+  BOOST_CHECK_EQUAL(keys.size(), NUM_KNOWN_IPS / 2);
+  for (const auto& ip : keys) {
+    BOOST_CHECK(table.Contains(ip));
+  }
+
+  table.Clear();
+  BOOST_CHECK_EQUAL(table.Size(), 0);
+  BOOST_CHECK(!table.Contains(TestIP(1)));
+}
+
+BOOST_AUTO_TEST_CASE(test_read_during_writes) {
+  INIT_STDOUT_LOGGER();
+
+  // Odd addresses stay put while even ones come and go and the table grows
+  IPTable<int32_t> table;
+  for (unsigned int i = 1; i < NUM_KNOWN_IPS; i += 2) {
+    table.Insert(TestIP(i), i);
+  }
+
+  atomic<bool> done{false};
+  thread writer([&] {
+    for (unsigned int round = 0; !done; round++) {
+      for (unsigned int i = 0; i < 4 * NUM_KNOWN_IPS; i += 2) {
+        table.Set(TestIP(i), round);
+      }
+      for (unsigned int i = 0; i < 4 * NUM_KNOWN_IPS; i += 2) {
+        table.Erase(TestIP(i));
+      }
+    }
+  });
+
+  for (unsigned int pass = 0; pass < 200; pass++) {
+    for (unsigned int i = 1; i < NUM_KNOWN_IPS; i += 2) {
+      int32_t value = 0;
+      BOOST_REQUIRE(table.Find(TestIP(i), value));
+      BOOST_REQUIRE_EQUAL(value, i);
+    }
+  }
+  done = true;
+  writer.join();
+}
+
+/// What P2PComm and the reputation check do per incoming connection, on the
+/// flat tables and on the string-hashed tables they replaced
+BOOST_AUTO_TEST_CASE(test_accept_path_checks_per_second) {
+  INIT_STDOUT_LOGGER();
+
+  Blacklist& bl = Blacklist::GetInstance();
+  ReputationManager& rm = ReputationManager::GetInstance();
+  bl.Clear();
+  rm.Clear();
+
+  StringHashedTable blacklist, reputations;
+  for (unsigned int i = 0; i < NUM_KNOWN_IPS; i++) {
+    rm.AddNodeIfNotKnown(TestIP(i));
+    reputations.m_table.emplace(TestIP(i), ReputationManager::GOOD);
+    if (i % 4 == 0) {
+      bl.Add(TestIP(i));
+      blacklist.m_table.emplace(TestIP(i), 1);
+    }
+  }
+
+  const double flat = ChecksPerSecond([&](const uint128_t& ip) {
+    return bl.Exist(ip) || rm.IsNodeBanned(ip);
+  });
+
+  const double stringHashed = ChecksPerSecond([&](const uint128_t& ip) {
+    int32_t value;
+    if (blacklist.Find(ip, value)) {
+      return true;
+    }
+    return reputations.Find(ip, value) &&
+           value <= ReputationManager::REPTHRESHOLD;
+  });
+
+  LOG_GENERAL(INFO, "Accept-path checks/s on " << NUM_READER_THREADS
+                                               << " threads: flat " << flat
+                                               << " string-hashed "
+                                               << stringHashed);
+
+  bl.Clear();
+  rm.Clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "libCrypto/Sha2.h"
+#include "libNetwork/P2PComm.h"
+#include "libTestUtils/NetworkSimulator.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE networksimulator
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+const NetworkSimulator::LinkConfig WAN_LINK = {50000, 12500000, 0.0};
+
+enum EpochMessage : unsigned char {
+  MICROBLOCK,
+  ANNOUNCE,
+  COMMIT,
+  CHALLENGE,
+  RESPONSE,
+  FINALBLOCK
+};
+
+/// Message flow of one epoch: every shard leader submits a microblock to the
+/// DS committee, the DS leader runs announce / commit / challenge / response
+/// on the final block once it has them all, and the final block is then sent
+/// to every shard node. Nodes spend a fixed time processing each message.
+class EpochModel {
+  static const uint64_t PROCESSING_TIME_IN_MICROSECONDS = 1000;
+  static const size_t MICROBLOCK_SIZE = 64 * 1024;
+  static const size_t CONSENSUS_MSG_SIZE = 256;
+
+  NetworkSimulator& m_network;
+  vector<Peer> m_ds;
+  vector<vector<Peer>> m_shards;
+  unsigned int m_microblocks = 0;
+  unsigned int m_commits = 0;
+  unsigned int m_responses = 0;
+  unsigned int m_finalBlocks = 0;
+  uint64_t m_doneTime = 0;
+
+  bytes MakeMessage(EpochMessage type, size_t size) {
+    bytes message(size, 0);
+    message[0] = type;
+    return message;
+  }
+
+  size_t FinalBlockSize() const { return 1024 + m_shards.size() * 128; }
+
+  unsigned int Quorum() const { return m_ds.size() * 2 / 3 + 1; }
+
+  void OnDsMessage(const Peer& self, const pair<bytes, Peer>& message) {
+    const Peer& leader = m_ds.front();
+    switch (message.first.at(0)) {
+      case MICROBLOCK:
+        if (++m_microblocks == m_shards.size()) {
+          m_network.SendMessage(leader, m_ds,
+                                MakeMessage(ANNOUNCE, FinalBlockSize()));
+        }
+        break;
+      case ANNOUNCE:
+        m_network.SendMessage(self, leader,
+                              MakeMessage(COMMIT, CONSENSUS_MSG_SIZE));
+        break;
+      case COMMIT:
+        if (++m_commits == Quorum()) {
+          m_network.SendMessage(leader, m_ds,
+                                MakeMessage(CHALLENGE, CONSENSUS_MSG_SIZE));
+        }
+        break;
+      case CHALLENGE:
+        m_network.SendMessage(self, leader,
+                              MakeMessage(RESPONSE, CONSENSUS_MSG_SIZE));
+        break;
+      case RESPONSE:
+        if (++m_responses == Quorum()) {
+          for (const auto& shard : m_shards) {
+            m_network.SendMessage(leader, shard,
+                                  MakeMessage(FINALBLOCK, FinalBlockSize()));
+          }
+        }
+        break;
+    }
+  }
+
+  void OnShardMessage(const pair<bytes, Peer>& message) {
+    if (message.first.at(0) == FINALBLOCK) {
+      m_finalBlocks++;
+      m_doneTime = m_network.Now();
+    }
+  }
+
+  NetworkSimulator::Dispatcher MakeDispatcher(const Peer& self, bool ds) {
+    return [this, self, ds](pair<bytes, Peer>* message) {
+      shared_ptr<pair<bytes, Peer>> owned(message);
+      m_network.Schedule(PROCESSING_TIME_IN_MICROSECONDS, [=]() {
+        if (ds) {
+          OnDsMessage(self, *owned);
+        } else {
+          OnShardMessage(*owned);
+        }
+      });
+    };
+  }
+
+ public:
+  EpochModel(NetworkSimulator& network, unsigned int dsSize,
+             unsigned int numShards, unsigned int shardSize)
+      : m_network(network) {
+    uint32_t port = 1;
+    for (unsigned int i = 0; i < dsSize; i++) {
+      m_ds.emplace_back(0x0100007F, port++);
+      m_network.AddNode(m_ds.back(), MakeDispatcher(m_ds.back(), true));
+    }
+    m_shards.resize(numShards);
+    for (auto& shard : m_shards) {
+      for (unsigned int i = 0; i < shardSize; i++) {
+        shard.emplace_back(0x0100007F, port++);
+        m_network.AddNode(shard.back(), MakeDispatcher(shard.back(), false));
+      }
+    }
+  }
+
+  /// Returns the virtual time until every shard node has the final block,
+  /// or zero if the epoch did not complete
+  uint64_t Run() {
+    for (const auto& shard : m_shards) {
+      m_network.SendMessage(shard.front(), m_ds,
+                            MakeMessage(MICROBLOCK, MICROBLOCK_SIZE));
+    }
+    m_network.Run();
+
+    unsigned int shardNodes = 0;
+    for (const auto& shard : m_shards) {
+      shardNodes += shard.size();
+    }
+    return m_finalBlocks == shardNodes ? m_doneTime : 0;
+  }
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(networksimulator)
+
+BOOST_AUTO_TEST_CASE(test_link_timing) {
+  INIT_STDOUT_LOGGER();
+
+  // 1 ms latency, 1 MB/s
+  NetworkSimulator network({1000, 1000000, 0.0}, 1);
+  const Peer a(0x0100007F, 1), b(0x0100007F, 2);
+
+  vector<uint64_t> arrivals;
+  network.AddNode(b, [&](pair<bytes, Peer>* message) {
+    BOOST_CHECK(message->second == a);
+    arrivals.push_back(network.Now());
+    delete message;
+  });
+
+  // The second message waits for the first to leave the link
+  network.SendMessage(a, b, bytes(1000, 0x01));
+  network.SendMessage(a, b, bytes(1000, 0x02));
+  BOOST_CHECK_EQUAL(network.Run(), 2);
+
+  BOOST_REQUIRE_EQUAL(arrivals.size(), 2);
+  BOOST_CHECK_EQUAL(arrivals[0], 2000);
+  BOOST_CHECK_EQUAL(arrivals[1], 3000);
+
+  // Other links are independent
+  network.SetLink(b, a, {10, 0, 0.0});
+  network.AddNode(a, [&](pair<bytes, Peer>* message) {
+    arrivals.push_back(network.Now());
+    delete message;
+  });
+  network.SendMessage(b, a, bytes(1000, 0x03));
+  network.Run();
+  BOOST_REQUIRE_EQUAL(arrivals.size(), 3);
+  BOOST_CHECK_EQUAL(arrivals[2], 3010);
+}
+
+BOOST_AUTO_TEST_CASE(test_loss_is_deterministic) {
+  INIT_STDOUT_LOGGER();
+
+  auto simulate = [](uint64_t seed) {
+    NetworkSimulator network({100, 0, 0.3}, seed);
+    const Peer a(0x0100007F, 1), b(0x0100007F, 2);
+    unsigned int received = 0;
+    network.AddNode(b, [&received](pair<bytes, Peer>* message) {
+      received++;
+      delete message;
+    });
+    for (unsigned int i = 0; i < 1000; i++) {
+      network.SendMessage(a, b, bytes(10, 0x00));
+    }
+    network.Run();
+    return received;
+  };
+
+  const unsigned int received = simulate(42);
+  BOOST_CHECK_EQUAL(received, simulate(42));
+  BOOST_CHECK_GT(received, 600);
+  BOOST_CHECK_LT(received, 800);
+}
+
+/// This process's P2PComm runs over the simulator: its sends arrive as wire
+/// frames, and the frames it receives go through broadcast deduplication and
+/// rebroadcast before reaching its dispatcher
+BOOST_AUTO_TEST_CASE(test_p2pcomm_over_simulator) {
+  INIT_STDOUT_LOGGER();
+
+  NetworkSimulator network({100, 0, 0.0}, 1);
+  const Peer self(0x0100007F, 1), a(0x0100007F, 2), b(0x0100007F, 3);
+
+  vector<pair<bytes, Peer>> dispatched;
+  network.AttachP2PComm(
+      self,
+      [&dispatched](pair<bytes, Peer>* message) {
+        dispatched.emplace_back(*message);
+        delete message;
+      },
+      [&b](unsigned char, unsigned char, const Peer&) {
+        return vector<Peer>{b};
+      });
+
+  vector<bytes> framesAtA, framesAtB;
+  network.AddNode(a, [&framesAtA](pair<bytes, Peer>* frame) {
+    framesAtA.emplace_back(frame->first);
+    delete frame;
+  });
+  network.AddNode(b, [&framesAtB](pair<bytes, Peer>* frame) {
+    framesAtB.emplace_back(frame->first);
+    delete frame;
+  });
+
+  const bytes message = {0x01, 0x02, 0x03};
+  P2PComm::GetInstance().SendMessage(a, message);
+  network.Run();
+
+  BOOST_REQUIRE_EQUAL(framesAtA.size(), 1);
+  BOOST_CHECK_EQUAL(framesAtA[0].at(1), START_BYTE_NORMAL);
+  BOOST_CHECK(bytes(framesAtA[0].begin() + HDR_LEN, framesAtA[0].end()) ==
+              message);
+
+  // A broadcast from a is dispatched once and passed on to b
+  SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+  sha256.Update(message);
+  const MessageFrame broadcast =
+      SendJob::MakeFrame(message, START_BYTE_BROADCAST, sha256.Finalize());
+  network.SendMessage(a, self, *broadcast);
+  network.SendMessage(a, self, *broadcast);
+  network.Run();
+
+  BOOST_REQUIRE_EQUAL(dispatched.size(), 1);
+  BOOST_CHECK(dispatched[0].first == message);
+  BOOST_CHECK(dispatched[0].second == a);
+  BOOST_REQUIRE_EQUAL(framesAtB.size(), 1);
+  BOOST_CHECK(framesAtB[0] == *broadcast);
+}
+
+BOOST_AUTO_TEST_CASE(test_epoch_latency_benchmark) {
+  INIT_STDOUT_LOGGER();
+
+  uint64_t previous = 0;
+  for (unsigned int dsSize : {10, 50, 200}) {
+    NetworkSimulator network(WAN_LINK, 1);
+    const uint64_t latency = EpochModel(network, dsSize, 3, 20).Run();
+    LOG_GENERAL(INFO, "DS " << dsSize << " shards 3x20 epoch latency(us) "
+                            << latency << " "
+                            << network.GetAndResetStats());
+    BOOST_CHECK_GT(latency, previous);
+    previous = latency;
+  }
+
+  previous = 0;
+  for (unsigned int numShards : {1, 5, 20}) {
+    NetworkSimulator network(WAN_LINK, 1);
+    const uint64_t latency = EpochModel(network, 50, numShards, 20).Run();
+    LOG_GENERAL(INFO, "DS 50 shards " << numShards << "x20 epoch latency(us) "
+                                      << latency << " "
+                                      << network.GetAndResetStats());
+    BOOST_CHECK_GT(latency, previous);
+    previous = latency;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
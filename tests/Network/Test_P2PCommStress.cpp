@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "common/Constants.h"
+#include "libNetwork/P2PComm.h"
+#include "libUtils/DetachedFunction.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE p2pcommstress
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+static const uint32_t LISTEN_PORT = 30404;
+static const unsigned int NUM_SENDERS = 5000;
+static const unsigned int NUM_SENDER_THREADS = 50;
+
+static atomic<unsigned int> received{0};
+
+static void CountMessage(pair<bytes, Peer>* message) {
+  received++;
+  delete message;
+}
+
+static bytes MakeFrame(unsigned int senderIndex) {
+  bytes payload(64, 0);
+  payload[0] = 0xFF;  // no handler, only counted
+  payload[2] = (senderIndex >> 8) & 0xFF;
+  payload[3] = senderIndex & 0xFF;
+
+  const uint32_t length = payload.size();
+  bytes frame = {(unsigned char)(MSG_VERSION & 0xFF),
+                 START_BYTE_NORMAL,
+                 (unsigned char)((length >> 24) & 0xFF),
+                 (unsigned char)((length >> 16) & 0xFF),
+                 (unsigned char)((length >> 8) & 0xFF),
+                 (unsigned char)(length & 0xFF)};
+  frame.insert(frame.end(), payload.begin(), payload.end());
+  return frame;
+}
+
+/// Opens all of this thread's connections first so that every sender is
+/// connected at the same time, then writes one frame on each
+static void RunSenders(unsigned int first, unsigned int count,
+                       atomic<unsigned int>& failures) {
+  struct sockaddr_in serv_addr;
+  memset(&serv_addr, 0, sizeof(serv_addr));
+  serv_addr.sin_family = AF_INET;
+  serv_addr.sin_port = htons(LISTEN_PORT);
+  inet_pton(AF_INET, "127.0.0.1", &serv_addr.sin_addr);
+
+  vector<int> socks;
+  for (unsigned int i = 0; i < count; i++) {
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0 ||
+        connect(sock, (struct sockaddr*)&serv_addr, sizeof(serv_addr)) < 0) {
+      failures++;
+      if (sock >= 0) {
+        close(sock);
+      }
+      continue;
+    }
+    socks.emplace_back(sock);
+  }
+
+  for (unsigned int i = 0; i < socks.size(); i++) {
+    const bytes frame = MakeFrame(first + i);
+    if (write(socks[i], frame.data(), frame.size()) !=
+        static_cast<ssize_t>(frame.size())) {
+      failures++;
+    }
+  }
+
+  for (const auto& sock : socks) {
+    close(sock);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(p2pcommstress)
+
+BOOST_AUTO_TEST_CASE(test_concurrent_senders) {
+  INIT_STDOUT_LOGGER();
+
+  // Both ends of every connection live in this process
+  struct rlimit limit;
+  getrlimit(RLIMIT_NOFILE, &limit);
+  limit.rlim_cur = limit.rlim_max;
+  setrlimit(RLIMIT_NOFILE, &limit);
+  if (limit.rlim_cur < 2 * NUM_SENDERS + 100) {
+    LOG_GENERAL(WARNING, "Open file limit " << limit.rlim_cur
+                                            << " too low, skipping test");
+    return;
+  }
+
+  DetachedFunction(1, []() mutable -> void {
+    P2PComm::GetInstance().StartMessagePump(LISTEN_PORT, CountMessage,
+                                            nullptr);
+  });
+  this_thread::sleep_for(chrono::seconds(1));
+
+  atomic<unsigned int> failures{0};
+  const auto start = chrono::steady_clock::now();
+
+  vector<thread> senders;
+  const unsigned int perThread = NUM_SENDERS / NUM_SENDER_THREADS;
+  for (unsigned int t = 0; t < NUM_SENDER_THREADS; t++) {
+    senders.emplace_back(RunSenders, t * perThread, perThread,
+                         std::ref(failures));
+  }
+  for (auto& sender : senders) {
+    sender.join();
+  }
+
+  while (received + failures < NUM_SENDERS &&
+         chrono::steady_clock::now() - start < chrono::seconds(60)) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+
+  const auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+                           chrono::steady_clock::now() - start)
+                           .count();
+  LOG_GENERAL(INFO, "Received " << received << " of " << NUM_SENDERS
+                                << " messages in " << elapsed << " ms with "
+                                << P2P_REACTOR_COUNT << " reactors");
+
+  BOOST_CHECK_EQUAL(failures.load(), 0);
+  BOOST_CHECK_EQUAL(received.load(), NUM_SENDERS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common/Constants.h"
+#include "common/Messages.h"
+#include "libNetwork/P2PCompression.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE p2pcompression
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(p2pcompression)
+
+BOOST_AUTO_TEST_CASE(test_round_trip) {
+  INIT_STDOUT_LOGGER();
+
+  P2PCompression& compression = P2PCompression::GetInstance();
+  BOOST_CHECK(
+      compression.SetCompressedKinds("NODE.FINALBLOCK, DS.POWSUBMISSION"));
+
+  bytes message(COMPRESSION_MIN_SIZE_IN_BYTES * 4, 0x5A);
+  message[MessageOffset::TYPE] = MessageType::NODE;
+  message[MessageOffset::INST] = NodeInstructionType::FINALBLOCK;
+
+  bytes compressed;
+  BOOST_CHECK(compression.Compress(message, compressed));
+  BOOST_CHECK_LT(compressed.size(), message.size());
+
+  bytes decompressed;
+  BOOST_CHECK(compression.Decompress(compressed.data(), compressed.size(),
+                                     decompressed));
+  BOOST_CHECK(decompressed == message);
+
+  LOG_GENERAL(INFO, compression.GetAndResetStats());
+}
+
+BOOST_AUTO_TEST_CASE(test_skipped_messages) {
+  INIT_STDOUT_LOGGER();
+
+  P2PCompression& compression = P2PCompression::GetInstance();
+  BOOST_CHECK(!compression.SetCompressedKinds("NODE.FINALBLOCK,NODE.NOSUCH"));
+
+  bytes compressed;
+
+  // Below the size threshold
+  bytes small(COMPRESSION_MIN_SIZE_IN_BYTES - 1, 0x5A);
+  small[MessageOffset::TYPE] = MessageType::NODE;
+  small[MessageOffset::INST] = NodeInstructionType::FINALBLOCK;
+  BOOST_CHECK(!compression.Compress(small, compressed));
+
+  // Message type not enabled
+  bytes other(COMPRESSION_MIN_SIZE_IN_BYTES * 4, 0x5A);
+  other[MessageOffset::TYPE] = MessageType::NODE;
+  other[MessageOffset::INST] = NodeInstructionType::SUBMITTRANSACTION;
+  BOOST_CHECK(!compression.Compress(other, compressed));
+
+  // Corrupt input
+  bytes garbage(64, 0xFF);
+  bytes decompressed;
+  BOOST_CHECK(!compression.Decompress(garbage.data(), garbage.size(),
+                                      decompressed));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
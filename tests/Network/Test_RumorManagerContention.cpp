@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "common/Constants.h"
+#include "libCrypto/Schnorr.h"
+#include "libNetwork/P2PComm.h"
+#include "libNetwork/RumorManager.h"
+#include "libUtils/BlockingQueue.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE rumormanagercontention
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+static const unsigned int NUM_PEERS = 32;
+static const unsigned int NUM_RUMORS = 200;
+static const unsigned int NUM_RECEIVER_THREADS = 8;
+static const unsigned int MESSAGES_PER_THREAD = 250;
+
+/// Gossip body as RumorReceived gets it: sender key, signature, payload
+static bytes SignedBody(const PairOfKey& key, const bytes& payload) {
+  bytes body;
+  key.second.Serialize(body, 0);
+  Signature sig;
+  Schnorr::GetInstance().Sign(payload, key.first, key.second, sig);
+  sig.Serialize(body, PUB_KEY_SIZE);
+  body.insert(body.end(), payload.begin(), payload.end());
+  return body;
+}
+
+BOOST_AUTO_TEST_SUITE(rumormanagercontention)
+
+/// Receiving threads keep handing gossip to the manager while its round
+/// thread signs and sends for a few hundred live rumors. Every message must
+/// reach RumorHolder through the inbox, and the round thread must drain it
+/// without waiting for the next round. Prints the receive throughput and
+/// latency, which should not depend on how busy the rounds are.
+BOOST_AUTO_TEST_CASE(test_receive_during_rounds) {
+  INIT_STDOUT_LOGGER();
+
+  vector<PairOfKey> keys;
+  vector<pair<PubKey, Peer>> peers;
+  vector<PubKey> networkKeys;
+  for (unsigned int i = 0; i < NUM_PEERS; i++) {
+    keys.emplace_back(Schnorr::GetInstance().GenKeyPair());
+    peers.emplace_back(keys.back().second, Peer(0x0100007F, 40000 + i));
+    networkKeys.emplace_back(keys.back().second);
+  }
+
+  const PairOfKey selfKey = Schnorr::GetInstance().GenKeyPair();
+  const Peer self(0x0100007F, 39999);
+  P2PComm::GetInstance().SetSelfKey(selfKey);
+  P2PComm::GetInstance().SetSelfPeer(self);
+
+  // Never freed, the detached round thread may still be finishing a round
+  RumorManager* manager = new RumorManager();
+  BOOST_REQUIRE(manager->Initialize(peers, self, selfKey, networkKeys));
+  manager->StartRounds();
+
+  for (unsigned int i = 0; i < NUM_RUMORS; i++) {
+    bytes rumor(1024, 0);
+    rumor[0] = i >> 8;
+    rumor[1] = i & 0xFF;
+    BOOST_CHECK(manager->AddRumor(rumor));
+  }
+
+  const bytes dummy = {'D', 'U', 'M', 'M', 'Y'};
+  vector<bytes> emptyPushes;
+  for (const auto& key : keys) {
+    emptyPushes.emplace_back(SignedBody(key, dummy));
+  }
+
+  vector<Log2Histogram> latencies(NUM_RECEIVER_THREADS);
+  const auto start = chrono::steady_clock::now();
+
+  vector<thread> receivers;
+  for (unsigned int t = 0; t < NUM_RECEIVER_THREADS; t++) {
+    receivers.emplace_back([&, t] {
+      for (unsigned int i = 0; i < MESSAGES_PER_THREAD; i++) {
+        const unsigned int p = (t * MESSAGES_PER_THREAD + i) % NUM_PEERS;
+        const auto begin = chrono::steady_clock::now();
+        manager->RumorReceived((uint8_t)RRS::Message::Type::EMPTY_PUSH, 1,
+                               emptyPushes[p], peers[p].second);
+        latencies[t].Add(chrono::duration_cast<chrono::microseconds>(
+                             chrono::steady_clock::now() - begin)
+                             .count());
+      }
+    });
+  }
+  for (auto& receiver : receivers) {
+    receiver.join();
+  }
+
+  const auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+                           chrono::steady_clock::now() - start)
+                           .count();
+
+  // The inbox wakes the round thread, so draining it must not take a full
+  // round time even while rounds are busy
+  const uint64_t expected = NUM_RECEIVER_THREADS * MESSAGES_PER_THREAD;
+  const auto deadline =
+      chrono::steady_clock::now() + chrono::milliseconds(ROUND_TIME_IN_MS);
+  while (manager->GetInboxProcessedCount() < expected &&
+         chrono::steady_clock::now() < deadline) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  const uint64_t processed = manager->GetInboxProcessedCount();
+  manager->StopRounds();
+
+  BOOST_CHECK_EQUAL(processed, expected);
+
+  LOG_GENERAL(INFO, "Received " << expected << " messages on "
+                                << NUM_RECEIVER_THREADS << " threads in "
+                                << elapsed << " ms with " << NUM_RUMORS
+                                << " rumors spreading");
+  for (unsigned int t = 0; t < NUM_RECEIVER_THREADS; t++) {
+    LOG_GENERAL(INFO,
+                "Thread " << t << " latency(us): " << latencies[t].ToString());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
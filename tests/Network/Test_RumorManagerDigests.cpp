@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "common/Constants.h"
+#include "libCrypto/Schnorr.h"
+#include "libNetwork/P2PComm.h"
+#include "libNetwork/RumorManager.h"
+#include "libUtils/HashUtils.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE rumormanagerdigests
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+static bytes Hash(unsigned int i) {
+  return HashUtils::BytesToHash({(unsigned char)(i >> 8),
+                                 (unsigned char)(i & 0xFF)});
+}
+
+static bytes DigestBatch(unsigned int count) {
+  bytes body;
+  for (unsigned int i = 0; i < count; i++) {
+    RumorManager::AppendDigest(
+        body, RumorManager::Digest{RRS::Message::Type::LAZY_PUSH, i, Hash(i)});
+  }
+  return body;
+}
+
+static bytes WantBatch(unsigned int first, unsigned int count) {
+  bytes body;
+  for (unsigned int i = first; i < first + count; i++) {
+    const bytes hash = Hash(i);
+    body.insert(body.end(), hash.begin(), hash.end());
+  }
+  return body;
+}
+
+/// Gossip body as RumorReceived gets it: sender key, signature, payload
+static bytes SignedBody(const PairOfKey& key, const bytes& payload) {
+  bytes body;
+  key.second.Serialize(body, 0);
+  Signature sig;
+  Schnorr::GetInstance().Sign(payload, key.first, key.second, sig);
+  sig.Serialize(body, PUB_KEY_SIZE);
+  body.insert(body.end(), payload.begin(), payload.end());
+  return body;
+}
+
+BOOST_AUTO_TEST_SUITE(rumormanagerdigests)
+
+BOOST_AUTO_TEST_CASE(test_digest_round_trip) {
+  INIT_STDOUT_LOGGER();
+
+  bytes body;
+  RumorManager::AppendDigest(
+      body, RumorManager::Digest{RRS::Message::Type::LAZY_PUSH, 3, Hash(1)});
+  RumorManager::AppendDigest(body, RumorManager::Digest{
+                                       RRS::Message::Type::LAZY_PULL,
+                                       0xFFFFFFFF, Hash(2)});
+
+  vector<RumorManager::Digest> digests;
+  BOOST_REQUIRE(RumorManager::ParseDigests(body, digests));
+  BOOST_REQUIRE_EQUAL(digests.size(), 2);
+  BOOST_CHECK(digests[0].type == RRS::Message::Type::LAZY_PUSH);
+  BOOST_CHECK_EQUAL(digests[0].rounds, 3);
+  BOOST_CHECK(digests[0].hash == Hash(1));
+  BOOST_CHECK(digests[1].type == RRS::Message::Type::LAZY_PULL);
+  BOOST_CHECK_EQUAL(digests[1].rounds, 0xFFFFFFFF);
+  BOOST_CHECK(digests[1].hash == Hash(2));
+
+  vector<bytes> hashes;
+  BOOST_REQUIRE(RumorManager::ParseWants(WantBatch(0, 3), hashes));
+  BOOST_REQUIRE_EQUAL(hashes.size(), 3);
+  for (unsigned int i = 0; i < hashes.size(); i++) {
+    BOOST_CHECK(hashes[i] == Hash(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_empty_batch_rejected) {
+  INIT_STDOUT_LOGGER();
+
+  vector<RumorManager::Digest> digests;
+  BOOST_CHECK(!RumorManager::ParseDigests({}, digests));
+
+  vector<bytes> hashes;
+  BOOST_CHECK(!RumorManager::ParseWants({}, hashes));
+}
+
+BOOST_AUTO_TEST_CASE(test_truncated_batch_rejected) {
+  INIT_STDOUT_LOGGER();
+
+  vector<RumorManager::Digest> digests;
+  bytes body = DigestBatch(2);
+  body.pop_back();
+  BOOST_CHECK(!RumorManager::ParseDigests(body, digests));
+
+  // Type and rounds without the hash
+  body = DigestBatch(1);
+  body.resize(1 + sizeof(uint32_t));
+  BOOST_CHECK(!RumorManager::ParseDigests(body, digests));
+
+  vector<bytes> hashes;
+  body = WantBatch(0, 2);
+  body.pop_back();
+  BOOST_CHECK(!RumorManager::ParseWants(body, hashes));
+}
+
+BOOST_AUTO_TEST_CASE(test_oversized_batch_rejected) {
+  INIT_STDOUT_LOGGER();
+
+  vector<RumorManager::Digest> digests;
+  BOOST_CHECK(RumorManager::ParseDigests(
+      DigestBatch(RumorManager::MAX_BATCH_ENTRIES), digests));
+  BOOST_CHECK(!RumorManager::ParseDigests(
+      DigestBatch(RumorManager::MAX_BATCH_ENTRIES + 1), digests));
+
+  vector<bytes> hashes;
+  BOOST_CHECK(RumorManager::ParseWants(
+      WantBatch(0, RumorManager::MAX_BATCH_ENTRIES), hashes));
+  BOOST_CHECK(!RumorManager::ParseWants(
+      WantBatch(0, RumorManager::MAX_BATCH_ENTRIES + 1), hashes));
+}
+
+/// IWANTs for hashes that never arrive must not let one peer grow the
+/// subscriber map without bound, nor crowd out other peers
+BOOST_AUTO_TEST_CASE(test_wants_limited_per_peer) {
+  INIT_STDOUT_LOGGER();
+
+  vector<PairOfKey> keys;
+  vector<pair<PubKey, Peer>> peers;
+  vector<PubKey> networkKeys;
+  for (unsigned int i = 0; i < 2; i++) {
+    keys.emplace_back(Schnorr::GetInstance().GenKeyPair());
+    peers.emplace_back(keys.back().second, Peer(0x0100007F, 41000 + i));
+    networkKeys.emplace_back(keys.back().second);
+  }
+
+  const PairOfKey selfKey = Schnorr::GetInstance().GenKeyPair();
+  const Peer self(0x0100007F, 40999);
+  P2PComm::GetInstance().SetSelfKey(selfKey);
+  P2PComm::GetInstance().SetSelfPeer(self);
+
+  // Never freed, the detached round thread may still be finishing a round
+  RumorManager* manager = new RumorManager();
+  BOOST_REQUIRE(manager->Initialize(peers, self, selfKey, networkKeys));
+  manager->StartRounds();
+
+  const Peer& flooder = peers[0].second;
+  const Peer& other = peers[1].second;
+  const unsigned int batch = RumorManager::MAX_BATCH_ENTRIES;
+  for (unsigned int first = 0;
+       first < 2 * RumorManager::MAX_SUBSCRIPTIONS_PER_PEER; first += batch) {
+    manager->RumorReceived((uint8_t)RRS::Message::Type::IWANT, 0,
+                           SignedBody(keys[0], WantBatch(first, batch)),
+                           flooder);
+  }
+  BOOST_CHECK_EQUAL(manager->GetSubscriptionCount(flooder),
+                    RumorManager::MAX_SUBSCRIPTIONS_PER_PEER);
+
+  // A hash arriving releases the subscriptions waiting on it
+  const bytes payload = {'R', 'U', 'M', 'O', 'R'};
+  const bytes hash = HashUtils::BytesToHash(payload);
+  manager->RumorReceived((uint8_t)RRS::Message::Type::IWANT, 0,
+                         SignedBody(keys[1], hash), other);
+  BOOST_CHECK_EQUAL(manager->GetSubscriptionCount(other), 1);
+
+  manager->RumorReceived((uint8_t)RRS::Message::Type::LAZY_PUSH, 1,
+                         SignedBody(keys[0], hash), flooder);
+  manager->RumorReceived((uint8_t)RRS::Message::Type::PUSH, 1,
+                         SignedBody(keys[0], payload), flooder);
+  BOOST_CHECK_EQUAL(manager->GetSubscriptionCount(other), 0);
+
+  manager->StopRounds();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
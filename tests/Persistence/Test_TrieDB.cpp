@@ -124,4 +124,40 @@ BOOST_AUTO_TEST_CASE(retrieveDataStoredInTheTwoTrie) {
                       "ERROR: Trie4 cannot get the element in Trie2");
 }
 
+/// Writes to a trie on a forked overlay must not reach the base overlay
+BOOST_AUTO_TEST_CASE(forkedOverlayKeepsBaseUntouched) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  dev::OverlayDB base("trieDBFork");
+  base.ResetDB();
+
+  SecureTrieDB<bytesConstRef, dev::OverlayDB> baseTrie(&base);
+  baseTrie.init();
+  baseTrie.insert(string("TestA"), string("AAA"));
+  baseTrie.insert(string("TestB"), string("BBB"));
+  const h256 baseRoot = baseTrie.root();
+  const h256Hash baseKeys = base.keys();
+
+  dev::OverlayDB fork(&base);
+  SecureTrieDB<bytesConstRef, dev::OverlayDB> forkTrie(&fork);
+  forkTrie.init();
+  forkTrie.setRoot(baseRoot);
+  BOOST_CHECK_EQUAL(forkTrie.at(string("TestA")), "AAA");
+
+  forkTrie.insert(string("TestA"), string("aaa"));
+  forkTrie.insert(string("TestC"), string("CCC"));
+  forkTrie.remove(string("TestB"));
+  BOOST_CHECK(forkTrie.root() != baseRoot);
+  fork.commit();
+
+  // The base still holds exactly its own nodes, all of them alive
+  BOOST_CHECK(base.keys() == baseKeys);
+  baseTrie.setRoot(baseRoot);
+  BOOST_CHECK_EQUAL(baseTrie.at(string("TestA")), "AAA");
+  BOOST_CHECK_EQUAL(baseTrie.at(string("TestB")), "BBB");
+  BOOST_CHECK_EQUAL(baseTrie.at(string("TestC")), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "common/Constants.h"
+#include "libRumorSpreading/GossipTuner.h"
+#include "libRumorSpreading/RumorHolder.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE AdaptiveGossip
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+static const int NUM_RUMORS = 40;
+static const int64_t RUMOR_INTERVAL_IN_MS = 2000;
+static const int64_t DRAIN_TIME_IN_MS = 30000;
+
+// Measured over the second half of the rumors, once adaptive mode had time to
+// settle
+struct SimResult {
+  double convergenceInMs = 0;
+  double coverage = 0;  // share of (rumor, node) pairs informed
+  double messagesPerRumor = 0;
+};
+
+/// Runs 'n' holders against each other on a virtual clock. Every holder
+/// advances its own rounds at its own interval, messages are delivered
+/// instantly. One rumor starts every RUMOR_INTERVAL_IN_MS at a different node.
+static SimResult Simulate(unsigned int n, bool adaptive) {
+  unordered_set<int> ids;
+  for (unsigned int i = 0; i < n; i++) {
+    ids.insert(i);
+  }
+
+  vector<unique_ptr<RRS::RumorHolder>> holders;
+  for (unsigned int i = 0; i < n; i++) {
+    holders.emplace_back(new RRS::RumorHolder(
+        ids, MAX_ROUNDS_IN_BSTATE, MAX_ROUNDS_IN_CSTATE, MAX_TOTAL_ROUNDS,
+        MAX_NEIGHBORS_PER_ROUND, i));
+    if (adaptive) {
+      holders.back()->enableAdaptiveMode(
+          GOSSIP_TARGET_CONVERGENCE_IN_MS, GOSSIP_MIN_ROUND_TIME_IN_MS,
+          ROUND_TIME_IN_MS, GOSSIP_ADAPTIVE_MAX_NEIGHBORS);
+    }
+  }
+
+  vector<vector<bool>> informed(NUM_RUMORS, vector<bool>(n, false));
+  vector<unsigned int> informedCount(NUM_RUMORS, 0);
+  vector<int64_t> convergence(NUM_RUMORS, -1);
+  uint64_t messages = 0;
+  int64_t now = 0;
+
+  auto inform = [&](int rumorId, unsigned int node) {
+    if (rumorId < 0 || informed[rumorId][node]) {
+      return;
+    }
+    informed[rumorId][node] = true;
+    if (++informedCount[rumorId] == n) {
+      convergence[rumorId] = now - rumorId * RUMOR_INTERVAL_IN_MS;
+    }
+  };
+
+  typedef pair<int64_t, unsigned int> Event;
+  priority_queue<Event, vector<Event>, greater<Event>> rounds;
+  mt19937 rng(n);
+  for (unsigned int i = 0; i < n; i++) {
+    rounds.emplace(rng() % ROUND_TIME_IN_MS, i);
+  }
+
+  int nextRumor = 0;
+  const int64_t end = NUM_RUMORS * RUMOR_INTERVAL_IN_MS + DRAIN_TIME_IN_MS;
+  while (!rounds.empty() && rounds.top().first < end) {
+    const unsigned int node = rounds.top().second;
+    now = rounds.top().first;
+    rounds.pop();
+
+    while (nextRumor < NUM_RUMORS &&
+           nextRumor * RUMOR_INTERVAL_IN_MS <= now) {
+      const unsigned int origin = (nextRumor * 7) % n;
+      holders[origin]->addRumor(nextRumor);
+      inform(nextRumor, origin);
+      nextRumor++;
+    }
+
+    RRS::RumorHolder& holder = *holders[node];
+    const auto push = holder.advanceRound();
+    for (const int to : push.first) {
+      if (to < 0) {
+        continue;
+      }
+      for (const auto& message : push.second) {
+        messages++;
+        inform(message.rumorId(), to);
+        const auto pull = holders[to]->receivedMessage(message, node);
+        for (const auto& response : pull.second) {
+          messages++;
+          inform(response.rumorId(), node);
+          holder.receivedMessage(response, to);
+        }
+      }
+    }
+    rounds.emplace(now + holder.roundTimeInMs(), node);
+  }
+
+  SimResult result;
+  unsigned int total = 0;
+  int converged = 0;
+  for (int r = NUM_RUMORS / 2; r < NUM_RUMORS; r++) {
+    total += informedCount[r];
+    if (convergence[r] >= 0) {
+      result.convergenceInMs += convergence[r];
+      converged++;
+    }
+  }
+  result.convergenceInMs /= max(converged, 1);
+  result.coverage = static_cast<double>(total) / (NUM_RUMORS / 2 * n);
+  result.messagesPerRumor = static_cast<double>(messages) / NUM_RUMORS;
+  return result;
+}
+
+BOOST_AUTO_TEST_SUITE(AdaptiveGossip)
+
+BOOST_AUTO_TEST_CASE(test_model_rounds) {
+  INIT_STDOUT_LOGGER();
+
+  BOOST_CHECK_EQUAL(RRS::GossipTuner::modelRounds(1, 1), 1);
+  BOOST_CHECK_EQUAL(RRS::GossipTuner::modelRounds(16, 1), 4);
+  BOOST_CHECK_EQUAL(RRS::GossipTuner::modelRounds(16, 3), 2);
+  BOOST_CHECK_EQUAL(RRS::GossipTuner::modelRounds(1000, 9), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_initial_plan) {
+  INIT_STDOUT_LOGGER();
+
+  const RRS::NetworkConfig limits(0, 2, 3, 6);
+
+  // Small network: one peer per round is enough at the longest interval
+  RRS::GossipTuner small(8, limits, 10, 3000, 100, 1000);
+  BOOST_CHECK_EQUAL(small.fanout(), 1);
+  BOOST_CHECK_EQUAL(small.roundTimeInMs(), 1000);
+  BOOST_CHECK_LE(small.networkConfig().maxRoundsTotal(), 6);
+
+  // Large network with a tight target: more peers and shorter rounds
+  RRS::GossipTuner large(1000, limits, 10, 1000, 100, 1000);
+  BOOST_CHECK_GT(large.fanout(), 1);
+  BOOST_CHECK_LT(large.roundTimeInMs(), 1000);
+  BOOST_CHECK_LE(RRS::GossipTuner::modelRounds(1000, large.fanout()) *
+                     large.roundTimeInMs(),
+                 1000);
+}
+
+/// Convergence time against network size, fixed settings vs adaptive
+BOOST_AUTO_TEST_CASE(test_convergence_vs_network_size) {
+  INIT_STDOUT_LOGGER();
+
+  for (const unsigned int n : {8, 32, 128, 512}) {
+    const SimResult fixed = Simulate(n, false);
+    const SimResult adaptive = Simulate(n, true);
+
+    LOG_GENERAL(INFO, "Nodes: " << n << " Fixed: " << fixed.convergenceInMs
+                                << " ms, coverage " << fixed.coverage << ", "
+                                << fixed.messagesPerRumor
+                                << " msgs/rumor Adaptive: "
+                                << adaptive.convergenceInMs << " ms, coverage "
+                                << adaptive.coverage << ", "
+                                << adaptive.messagesPerRumor << " msgs/rumor");
+
+    BOOST_CHECK_EQUAL(adaptive.coverage, 1.0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
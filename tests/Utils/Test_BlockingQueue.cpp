@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <thread>
+#include <vector>
+#include "libUtils/BlockingQueue.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE blockingqueue
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(blockingqueue)
+
+BOOST_AUTO_TEST_CASE(test_capacity_and_order) {
+  INIT_STDOUT_LOGGER();
+
+  BlockingQueue<int> queue(3);
+  BOOST_CHECK(queue.Push(1));
+  BOOST_CHECK(queue.Push(2));
+  BOOST_CHECK(queue.Push(3));
+  BOOST_CHECK_MESSAGE(!queue.Push(4), "Push should fail on a full queue");
+
+  vector<int> items;
+  BOOST_CHECK_EQUAL(queue.PopBatch(items, 2, chrono::milliseconds(0)), 2);
+  BOOST_CHECK_EQUAL(items[0], 1);
+  BOOST_CHECK_EQUAL(items[1], 2);
+
+  int item = 0;
+  BOOST_CHECK(queue.TryPop(item));
+  BOOST_CHECK_EQUAL(item, 3);
+  BOOST_CHECK(!queue.TryPop(item));
+  BOOST_CHECK_EQUAL(queue.PopBatch(items, 2, chrono::milliseconds(10)), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_blocking_consumer) {
+  INIT_STDOUT_LOGGER();
+
+  BlockingQueue<int> queue(16);
+  vector<int> items;
+
+  thread consumer([&queue, &items]() {
+    while (items.size() < 10) {
+      queue.PopBatch(items, 4, chrono::milliseconds(5000));
+    }
+  });
+
+  for (int i = 0; i < 10; i++) {
+    BOOST_CHECK(queue.Push(i));
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  consumer.join();
+
+  for (int i = 0; i < 10; i++) {
+    BOOST_CHECK_EQUAL(items[i], i);
+  }
+
+  LOG_GENERAL(INFO, queue.GetAndResetStats());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
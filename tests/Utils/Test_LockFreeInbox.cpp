@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "libUtils/LockFreeInbox.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE lockfreeinbox
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+static const unsigned int NUM_PRODUCERS = 8;
+static const unsigned int ITEMS_PER_PRODUCER = 20000;
+
+BOOST_AUTO_TEST_SUITE(lockfreeinbox)
+
+BOOST_AUTO_TEST_CASE(test_order) {
+  INIT_STDOUT_LOGGER();
+
+  LockFreeInbox<int> inbox;
+  BOOST_CHECK(inbox.empty());
+  BOOST_CHECK(inbox.Push(1));
+  BOOST_CHECK_MESSAGE(!inbox.Push(2), "Only the first push should wake");
+  BOOST_CHECK(!inbox.Push(3));
+
+  vector<int> items;
+  BOOST_CHECK_EQUAL(inbox.TakeAll(items), 3);
+  BOOST_CHECK(inbox.empty());
+  BOOST_CHECK(items == vector<int>({1, 2, 3}));
+
+  BOOST_CHECK(inbox.Push(4));
+  BOOST_CHECK_EQUAL(inbox.TakeAll(items), 1);
+  BOOST_CHECK_EQUAL(items.back(), 4);
+  BOOST_CHECK_EQUAL(inbox.TakeAll(items), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_producers) {
+  INIT_STDOUT_LOGGER();
+
+  LockFreeInbox<unsigned int> inbox;
+  atomic<bool> done{false};
+  vector<unsigned int> items;
+
+  thread consumer([&] {
+    while (!done) {
+      inbox.TakeAll(items);
+    }
+    inbox.TakeAll(items);
+  });
+
+  vector<thread> producers;
+  for (unsigned int p = 0; p < NUM_PRODUCERS; p++) {
+    producers.emplace_back([&inbox, p] {
+      for (unsigned int i = 0; i < ITEMS_PER_PRODUCER; i++) {
+        inbox.Push(p * ITEMS_PER_PRODUCER + i);
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  done = true;
+  consumer.join();
+
+  BOOST_REQUIRE_EQUAL(items.size(), NUM_PRODUCERS * ITEMS_PER_PRODUCER);
+
+  // Every item exactly once, and each producer's items in push order
+  vector<unsigned int> next(NUM_PRODUCERS, 0);
+  for (const auto& item : items) {
+    const unsigned int p = item / ITEMS_PER_PRODUCER;
+    BOOST_REQUIRE_EQUAL(item % ITEMS_PER_PRODUCER, next[p]);
+    next[p]++;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "libUtils/Logger.h"
+#include "libUtils/ReedSolomon.h"
+
+#define BOOST_TEST_MODULE reedsolomon
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+static bytes RandomBytes(size_t size, mt19937& rng) {
+  bytes data(size);
+  for (auto& b : data) {
+    b = rng() & 0xFF;
+  }
+  return data;
+}
+
+BOOST_AUTO_TEST_SUITE(reedsolomon)
+
+BOOST_AUTO_TEST_CASE(test_any_data_shards_rebuild) {
+  INIT_STDOUT_LOGGER();
+
+  mt19937 rng(1);
+  const ReedSolomon codec(10, 5);
+  const bytes data = RandomBytes(12345, rng);
+
+  vector<bytes> shards;
+  BOOST_REQUIRE(codec.Encode(data, shards));
+  BOOST_REQUIRE_EQUAL(shards.size(), 15);
+
+  // Systematic: the data shards are the data itself
+  BOOST_CHECK(equal(shards[0].begin(), shards[0].end(), data.begin()));
+
+  for (unsigned int trial = 0; trial < 50; trial++) {
+    vector<unsigned int> indexes(shards.size());
+    iota(indexes.begin(), indexes.end(), 0);
+    shuffle(indexes.begin(), indexes.end(), rng);
+
+    map<unsigned int, bytes> received;
+    for (unsigned int i = 0; i < codec.GetDataShards(); i++) {
+      received[indexes[i]] = shards[indexes[i]];
+    }
+
+    bytes decoded;
+    BOOST_REQUIRE(codec.Decode(received, data.size(), decoded));
+    BOOST_CHECK(decoded == data);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_parity_only) {
+  INIT_STDOUT_LOGGER();
+
+  mt19937 rng(2);
+  const ReedSolomon codec(100, 155);
+  const bytes data = RandomBytes(100000, rng);
+
+  vector<bytes> shards;
+  BOOST_REQUIRE(codec.Encode(data, shards));
+
+  map<unsigned int, bytes> received;
+  for (unsigned int i = 155; i < 255; i++) {
+    received[i] = shards[i];
+  }
+
+  bytes decoded;
+  BOOST_REQUIRE(codec.Decode(received, data.size(), decoded));
+  BOOST_CHECK(decoded == data);
+}
+
+BOOST_AUTO_TEST_CASE(test_too_few_shards) {
+  INIT_STDOUT_LOGGER();
+
+  mt19937 rng(3);
+  const ReedSolomon codec(4, 2);
+  const bytes data = RandomBytes(100, rng);
+
+  vector<bytes> shards;
+  BOOST_REQUIRE(codec.Encode(data, shards));
+
+  map<unsigned int, bytes> received;
+  for (unsigned int i = 0; i < 3; i++) {
+    received[i + 2] = shards[i + 2];
+  }
+
+  bytes decoded;
+  BOOST_CHECK(!codec.Decode(received, data.size(), decoded));
+  BOOST_CHECK(!ReedSolomon(200, 57).Encode(data, shards));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "libUtils/Logger.h"
+#include "libUtils/WeightedFairScheduler.h"
+
+#define BOOST_TEST_MODULE weightedfairscheduler
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+enum : unsigned int { CONSENSUS = 0, TXN = 1 };
+
+BOOST_AUTO_TEST_SUITE(weightedfairscheduler)
+
+BOOST_AUTO_TEST_CASE(test_max_concurrent) {
+  INIT_STDOUT_LOGGER();
+
+  atomic<unsigned int> running{0}, maxRunning{0}, done{0};
+  const unsigned int NUM_JOBS = 20;
+  {
+    WeightedFairScheduler pool(4, "TestPool",
+                               {{"Consensus", 16, 4}, {"Txn", 1, 1}});
+    for (unsigned int i = 0; i < NUM_JOBS; i++) {
+      pool.AddJob(TXN, [&running, &maxRunning, &done]() {
+        unsigned int now = ++running;
+        unsigned int prev = maxRunning.load();
+        while (now > prev && !maxRunning.compare_exchange_weak(prev, now)) {
+        }
+        this_thread::sleep_for(chrono::milliseconds(2));
+        --running;
+        ++done;
+      });
+    }
+    while (done < NUM_JOBS) {
+      this_thread::sleep_for(chrono::milliseconds(1));
+    }
+  }
+  BOOST_CHECK_EQUAL(maxRunning.load(), 1);
+}
+
+/// Floods the txn class and checks that a consensus job is still picked up
+/// well before the flood drains
+BOOST_AUTO_TEST_CASE(test_consensus_under_txn_flood) {
+  INIT_STDOUT_LOGGER();
+
+  const unsigned int FLOOD_SIZE = 500;
+  const auto JOB_TIME = chrono::milliseconds(2);
+  atomic<bool> consensusDone{false};
+  chrono::steady_clock::time_point consensusQueued, consensusStarted;
+
+  WeightedFairScheduler pool(4, "TestPool",
+                             {{"Consensus", 16, 4}, {"Txn", 2, 1}});
+  for (unsigned int i = 0; i < FLOOD_SIZE; i++) {
+    pool.AddJob(TXN, [JOB_TIME]() { this_thread::sleep_for(JOB_TIME); });
+  }
+
+  consensusQueued = chrono::steady_clock::now();
+  pool.AddJob(CONSENSUS, [&consensusStarted, &consensusDone]() {
+    consensusStarted = chrono::steady_clock::now();
+    consensusDone = true;
+  });
+
+  while (!consensusDone) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+
+  const auto delay = chrono::duration_cast<chrono::milliseconds>(
+                         consensusStarted - consensusQueued)
+                         .count();
+  LOG_GENERAL(INFO, "Consensus delay under flood: " << delay << " ms");
+  LOG_GENERAL(INFO, pool.GetAndResetStats());
+
+  // Draining the flood on a single txn slot takes FLOOD_SIZE * JOB_TIME
+  BOOST_CHECK_LT(delay, (FLOOD_SIZE * JOB_TIME.count()) / 10);
+}
+
+/// Jobs still queued when the pool is destroyed must release what they hold
+BOOST_AUTO_TEST_CASE(test_queued_jobs_released_on_shutdown) {
+  INIT_STDOUT_LOGGER();
+
+  const auto held = make_shared<int>(0);
+  atomic<bool> started{false}, release{false};
+  thread releaser;
+  {
+    WeightedFairScheduler pool(1, "TestPool", {{"Txn", 1, 1}});
+    pool.AddJob(TXN, [&started, &release]() {
+      started = true;
+      while (!release) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+      }
+    });
+    for (unsigned int i = 0; i < 10; i++) {
+      pool.AddJob(TXN, [held]() { ++*held; });
+    }
+    while (!started) {
+      this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    BOOST_CHECK_EQUAL(held.use_count(), 11);
+
+    // Let the running job finish only once the destructor has begun
+    releaser = thread([&release]() {
+      this_thread::sleep_for(chrono::milliseconds(50));
+      release = true;
+    });
+  }
+  releaser.join();
+  BOOST_CHECK_EQUAL(*held, 0);
+  BOOST_CHECK_EQUAL(held.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+
+#include "NetworkSimulator.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+NetworkSimulator::NetworkSimulator(const LinkConfig& defaultLink,
+                                   uint64_t seed)
+    : m_defaultLink(defaultLink), m_rng(seed) {}
+
+void NetworkSimulator::AddNode(const Peer& peer, const Dispatcher& dispatcher) {
+  lock_guard<mutex> g(m_mutex);
+  m_nodes[peer] = dispatcher;
+}
+
+void NetworkSimulator::AttachP2PComm(
+    const Peer& self, const P2PComm::Dispatcher& dispatcher,
+    const P2PComm::BroadcastListFunc& broadcastListRetriever) {
+  AddNode(self, [](pair<bytes, Peer>* frame) {
+    P2PComm::ReceiveFrame(frame->first, frame->second);
+    delete frame;
+  });
+
+  P2PComm& p2p = P2PComm::GetInstance();
+  p2p.SetSelfPeer(self);
+  p2p.SetTransport(
+      [this, self](const Peer& peer, const MessageFrame& frame) {
+        SendMessage(self, peer, *frame);
+      },
+      dispatcher, broadcastListRetriever);
+}
+
+void NetworkSimulator::SetLink(const Peer& from, const Peer& to,
+                               const LinkConfig& link) {
+  lock_guard<mutex> g(m_mutex);
+  m_links[{from, to}] = link;
+}
+
+const NetworkSimulator::LinkConfig& NetworkSimulator::GetLink(
+    const Peer& from, const Peer& to) const {
+  auto it = m_links.find({from, to});
+  return it == m_links.end() ? m_defaultLink : it->second;
+}
+
+void NetworkSimulator::SendMessage(const Peer& from, const Peer& peer,
+                                   const bytes& message) {
+  lock_guard<mutex> g(m_mutex);
+  m_sent++;
+  m_bytes += message.size();
+
+  auto node = m_nodes.find(peer);
+  if (node == m_nodes.end()) {
+    LOG_GENERAL(WARNING, "No simulated node at " << peer);
+    m_dropped++;
+    return;
+  }
+
+  // A sender writes one message at a time, at the bandwidth of the link it
+  // goes out on, so a multicast or a large message delays the ones queued
+  // behind it
+  const LinkConfig& link = GetLink(from, peer);
+  uint64_t& busyUntil = m_uplinkBusyUntil[from];
+  uint64_t departure = max(m_now, busyUntil);
+  if (link.bandwidthInBytesPerSecond > 0) {
+    departure += message.size() * 1000000 / link.bandwidthInBytesPerSecond;
+  }
+  busyUntil = departure;
+
+  if (link.lossRate > 0 && m_lossDistribution(m_rng) < link.lossRate) {
+    m_dropped++;
+    return;
+  }
+
+  auto payload = make_shared<const bytes>(message);
+  const Dispatcher dispatcher = node->second;
+  ScheduleAt(departure + link.latencyInMicroseconds,
+             [this, payload, from, dispatcher]() {
+               {
+                 lock_guard<mutex> g(m_mutex);
+                 m_delivered++;
+               }
+               dispatcher(new pair<bytes, Peer>(*payload, from));
+             });
+}
+
+void NetworkSimulator::SendMessage(const Peer& from, const vector<Peer>& peers,
+                                   const bytes& message) {
+  for (const auto& peer : peers) {
+    SendMessage(from, peer, message);
+  }
+}
+
+void NetworkSimulator::SendMessage(const Peer& from, const deque<Peer>& peers,
+                                   const bytes& message) {
+  for (const auto& peer : peers) {
+    SendMessage(from, peer, message);
+  }
+}
+
+void NetworkSimulator::Schedule(uint64_t delayInMicroseconds,
+                                const Task& task) {
+  lock_guard<mutex> g(m_mutex);
+  ScheduleAt(m_now + delayInMicroseconds, task);
+}
+
+void NetworkSimulator::ScheduleAt(uint64_t time, Task task) {
+  m_events.push({time, m_sequence++, move(task)});
+}
+
+uint64_t NetworkSimulator::Run(uint64_t untilInMicroseconds) {
+  uint64_t count = 0;
+  while (true) {
+    Task task;
+    {
+      lock_guard<mutex> g(m_mutex);
+      if (m_events.empty() || m_events.top().time > untilInMicroseconds) {
+        break;
+      }
+      m_now = m_events.top().time;
+      task = m_events.top().task;
+      m_events.pop();
+    }
+    task();
+    count++;
+  }
+  return count;
+}
+
+uint64_t NetworkSimulator::Now() {
+  lock_guard<mutex> g(m_mutex);
+  return m_now;
+}
+
+string NetworkSimulator::GetAndResetStats() {
+  lock_guard<mutex> g(m_mutex);
+  ostringstream oss;
+  oss << "Sent: " << m_sent << " Delivered: " << m_delivered
+      << " Dropped: " << m_dropped << " Bytes: " << m_bytes
+      << " Time(us): " << m_now;
+  m_sent = 0;
+  m_delivered = 0;
+  m_dropped = 0;
+  m_bytes = 0;
+  return oss.str();
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __NETWORKSIMULATOR_H__
+#define __NETWORKSIMULATOR_H__
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/BaseType.h"
+#include "libNetwork/P2PComm.h"
+#include "libNetwork/Peer.h"
+
+/// In-process network for multi-node tests and benchmarks.
+///
+/// Nodes are identified by their Peer and receive what is sent to them
+/// through the same dispatcher signature as P2PComm. The node attached with
+/// AttachP2PComm is this process's P2PComm, which sends and receives wire
+/// frames, so its start bytes, broadcasts, gossip and chunking work as over
+/// sockets. The other nodes get those frames as they are and must send it
+/// whole frames (SendJob::MakeFrame). There is one P2PComm per process, so
+/// the rest of a committee is scripted by the test.
+///
+/// Nothing touches a socket: deliveries are events on a virtual clock. A
+/// sender puts its messages on the wire one at a time, each at the bandwidth
+/// of its link, and a message then arrives after the link's latency unless
+/// it is lost at the link's loss rate. Events run
+/// on the calling thread in time order (ties in the order they were
+/// scheduled), and loss is drawn from a seeded generator, so a run is
+/// deterministic as long as every send comes from an event. Sends from other
+/// threads, e.g. ones a node spawns, are accepted at any time.
+class NetworkSimulator {
+ public:
+  /// Same signature as P2PComm::Dispatcher, the receiver owns the message
+  using Dispatcher = std::function<void(std::pair<bytes, Peer>*)>;
+  using Task = std::function<void()>;
+
+  struct LinkConfig {
+    uint64_t latencyInMicroseconds;
+    uint64_t bandwidthInBytesPerSecond;  // zero for unlimited
+    double lossRate;
+  };
+
+  NetworkSimulator(const LinkConfig& defaultLink, uint64_t seed);
+
+  void AddNode(const Peer& peer, const Dispatcher& dispatcher);
+
+  /// Adds this process's P2PComm as the node at self. Its sends go out on
+  /// the simulated links and the frames it receives are dispatched as if
+  /// read from a socket.
+  void AttachP2PComm(const Peer& self, const P2PComm::Dispatcher& dispatcher,
+                     const P2PComm::BroadcastListFunc& broadcastListRetriever);
+
+  /// Overrides the default link for messages sent from one peer to another
+  void SetLink(const Peer& from, const Peer& to, const LinkConfig& link);
+
+  /// Sends normal message to specified peer.
+  void SendMessage(const Peer& from, const Peer& peer, const bytes& message);
+
+  /// Multicasts message to specified list of peers.
+  void SendMessage(const Peer& from, const std::vector<Peer>& peers,
+                   const bytes& message);
+
+  /// Multicasts message to specified list of peers.
+  void SendMessage(const Peer& from, const std::deque<Peer>& peers,
+                   const bytes& message);
+
+  /// Runs the task after the delay, e.g. to model processing time
+  void Schedule(uint64_t delayInMicroseconds, const Task& task);
+
+  /// Runs events until none are left or the next one is due after the given
+  /// time. Returns the number of events run. Sends from other threads may
+  /// add events after it returns.
+  uint64_t Run(uint64_t untilInMicroseconds = UINT64_MAX);
+
+  /// Current virtual time in microseconds
+  uint64_t Now();
+
+  /// Returns the message counters and resets them
+  std::string GetAndResetStats();
+
+ private:
+  struct Event {
+    uint64_t time;
+    uint64_t sequence;
+    Task task;
+
+    bool operator>(const Event& rhs) const {
+      return time != rhs.time ? time > rhs.time : sequence > rhs.sequence;
+    }
+  };
+
+  // Guards everything below, events run without it
+  std::mutex m_mutex;
+  const LinkConfig m_defaultLink;
+  std::mt19937_64 m_rng;
+  std::uniform_real_distribution<double> m_lossDistribution{0.0, 1.0};
+  std::map<Peer, Dispatcher> m_nodes;
+  std::map<std::pair<Peer, Peer>, LinkConfig> m_links;
+  std::map<Peer, uint64_t> m_uplinkBusyUntil;
+  std::priority_queue<Event, std::vector<Event>, std::greater<Event>> m_events;
+  uint64_t m_now = 0;
+  uint64_t m_sequence = 0;
+
+  uint64_t m_sent = 0;
+  uint64_t m_delivered = 0;
+  uint64_t m_dropped = 0;
+  uint64_t m_bytes = 0;
+
+  const LinkConfig& GetLink(const Peer& from, const Peer& to) const;
+  /// Caller holds m_mutex
+  void ScheduleAt(uint64_t time, Task task);
+};
+
+#endif  // __NETWORKSIMULATOR_H__